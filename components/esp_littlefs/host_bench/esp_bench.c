@@ -0,0 +1,523 @@
+/**
+ * @file esp_bench.c
+ * @brief Host-side littlefs benchmark on lfs_emubd with ESP flash and SD card geometries
+ *
+ * Runs a fixed set of workloads against an emulated block device and reports
+ * block device traffic, a simulated wall time derived from a per-operation
+ * latency model, and the erase wear distribution. Everything is seeded, so
+ * results are deterministic and can be compared against a baseline CSV.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lfs.h"
+#include "bd/lfs_emubd.h"
+
+#define BENCH_MAX_ROWS      64
+#define BENCH_FILE_SIZE     (256 * 1024)
+#define BENCH_CHUNK_SIZE    4096
+
+/**
+ * @brief Disk geometry plus a simple latency model.
+ *
+ * Each operation costs op_us plus byte_ns per byte transferred. The numbers
+ * are typical datasheet values for the parts found on ESP32 boards:
+ * 40MHz QIO NOR flash (page program ~0.7ms/256B, sector erase ~45ms) and
+ * SD cards over SPI at 20MHz (command overhead dominates small transfers).
+ */
+typedef struct {
+    const char *name;
+    lfs_size_t read_size;
+    lfs_size_t prog_size;
+    lfs_size_t block_size;
+    lfs_size_t block_count;
+    double read_op_us;
+    double read_byte_ns;
+    double prog_op_us;
+    double prog_byte_ns;
+    double erase_op_us;
+} bench_geometry_t;
+
+static const bench_geometry_t geometries[] = {
+    /* name              read  prog  block  count    read op/B      prog op/B      erase  */
+    {"esp-flash",         128,  256,  4096,   256,    5.0,   50.0,   10.0, 2750.0,  45000.0},
+    {"esp-flash-128",     128,  128,  4096,   256,    5.0,   50.0,   10.0, 2750.0,  45000.0},
+    {"sd-512",            512,  512,   512, 32768,  200.0,  400.0,  500.0,  400.0,   1000.0},
+    {"sd-16k",            512,  512, 16384,  1024,  200.0,  400.0,  500.0,  400.0,   1000.0},
+    {"sd-64k",            512,  512, 65536,   256,  200.0,  400.0,  500.0,  400.0,   1000.0},
+};
+#define GEOMETRY_COUNT (sizeof(geometries) / sizeof(geometries[0]))
+
+/**
+ * @brief Block device wrapper; emu must stay first, lfs_emubd_* cast cfg->context to it.
+ */
+typedef struct {
+    lfs_emubd_t emu;
+    const bench_geometry_t *geo;
+    uint64_t reads, progs, erases;
+    uint64_t read_bytes, prog_bytes, erase_bytes;
+    double sim_us;
+} bench_bd_t;
+
+typedef struct {
+    const char *geometry;
+    const char *workload;
+    uint32_t ops;
+    double sim_us;
+    uint64_t reads, progs, erases;
+    uint64_t read_bytes, prog_bytes, erase_bytes;
+} bench_result_t;
+
+typedef int (*bench_workload_fn)(lfs_t *lfs, uint32_t *ops);
+
+static struct {
+    lfs_size_t cache_size;
+    lfs_size_t lookahead_size;
+    int32_t block_cycles;
+    bool csv;
+    const char *geometry_filter;
+    const char *workload_filter;
+    const char *baseline;
+    double tolerance;
+} opts = {
+    .cache_size = 512,
+    .lookahead_size = 128,
+    .block_cycles = 512,
+    .tolerance = 5.0,
+};
+
+static bench_result_t results[BENCH_MAX_ROWS];
+static size_t results_count;
+static uint8_t chunk[BENCH_CHUNK_SIZE];
+static uint32_t prng_state;
+
+static uint32_t prng(void)
+{
+    /* xorshift32, fixed seed per run so results are reproducible */
+    uint32_t x = prng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return prng_state = x;
+}
+
+static int bench_bd_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    bench_bd_t *bd = c->context;
+    bd->reads++;
+    bd->read_bytes += size;
+    bd->sim_us += bd->geo->read_op_us + size * bd->geo->read_byte_ns / 1000.0;
+    return lfs_emubd_read(c, block, off, buffer, size);
+}
+
+static int bench_bd_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    bench_bd_t *bd = c->context;
+    bd->progs++;
+    bd->prog_bytes += size;
+    bd->sim_us += bd->geo->prog_op_us + size * bd->geo->prog_byte_ns / 1000.0;
+    return lfs_emubd_prog(c, block, off, buffer, size);
+}
+
+static int bench_bd_erase(const struct lfs_config *c, lfs_block_t block)
+{
+    bench_bd_t *bd = c->context;
+    bd->erases++;
+    bd->erase_bytes += c->block_size;
+    bd->sim_us += bd->geo->erase_op_us;
+    return lfs_emubd_erase(c, block);
+}
+
+static int bench_bd_sync(const struct lfs_config *c)
+{
+    return lfs_emubd_sync(c);
+}
+
+static bool name_selected(const char *filter, const char *name)
+{
+    if (!filter) {
+        return true;
+    }
+    size_t len = strlen(name);
+    for (const char *p = filter; (p = strstr(p, name)); p += len) {
+        if ((p == filter || p[-1] == ',') && (p[len] == '\0' || p[len] == ',')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------
+// Workloads. They run in order on the same filesystem, each one gets its own counters.
+
+static int wl_seq_write(lfs_t *lfs, uint32_t *ops)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "seq.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+    if (err) return err;
+    for (size_t i = 0; i < BENCH_FILE_SIZE; i += sizeof(chunk)) {
+        memset(chunk, (int)(i / sizeof(chunk)), sizeof(chunk));
+        if (lfs_file_write(lfs, &file, chunk, sizeof(chunk)) != (lfs_ssize_t)sizeof(chunk)) {
+            lfs_file_close(lfs, &file);
+            return LFS_ERR_IO;
+        }
+        (*ops)++;
+    }
+    return lfs_file_close(lfs, &file);
+}
+
+static int wl_seq_read(lfs_t *lfs, uint32_t *ops)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "seq.bin", LFS_O_RDONLY);
+    if (err) return err;
+    for (size_t i = 0; i < BENCH_FILE_SIZE; i += sizeof(chunk)) {
+        if (lfs_file_read(lfs, &file, chunk, sizeof(chunk)) != (lfs_ssize_t)sizeof(chunk)
+                || chunk[0] != (uint8_t)(i / sizeof(chunk))) {
+            lfs_file_close(lfs, &file);
+            return LFS_ERR_CORRUPT;
+        }
+        (*ops)++;
+    }
+    return lfs_file_close(lfs, &file);
+}
+
+static int wl_rand_read(lfs_t *lfs, uint32_t *ops)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "seq.bin", LFS_O_RDONLY);
+    if (err) return err;
+    for (int i = 0; i < 512; i++) {
+        lfs_soff_t pos = (prng() % (BENCH_FILE_SIZE / 256)) * 256;
+        if (lfs_file_seek(lfs, &file, pos, LFS_SEEK_SET) != pos
+                || lfs_file_read(lfs, &file, chunk, 256) != 256) {
+            lfs_file_close(lfs, &file);
+            return LFS_ERR_IO;
+        }
+        (*ops)++;
+    }
+    return lfs_file_close(lfs, &file);
+}
+
+static int wl_small_files(lfs_t *lfs, uint32_t *ops)
+{
+    char path[32];
+    int err = lfs_mkdir(lfs, "small");
+    if (err && err != LFS_ERR_EXIST) return err;
+
+    for (int i = 0; i < 64; i++) {
+        lfs_file_t file;
+        snprintf(path, sizeof(path), "small/%03d.cfg", i);
+        if ((err = lfs_file_open(lfs, &file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC))) return err;
+        memset(chunk, i, 200);
+        lfs_file_write(lfs, &file, chunk, 200);
+        if ((err = lfs_file_close(lfs, &file))) return err;
+        (*ops)++;
+    }
+
+    for (int i = 0; i < 64; i++) {
+        struct lfs_info info;
+        snprintf(path, sizeof(path), "small/%03d.cfg", i);
+        if ((err = lfs_stat(lfs, path, &info))) return err;
+        if ((err = lfs_remove(lfs, path))) return err;
+        (*ops)++;
+    }
+    return 0;
+}
+
+static int wl_append_sync(lfs_t *lfs, uint32_t *ops)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "log.txt", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
+    if (err) return err;
+    for (int i = 0; i < 256; i++) {
+        int len = snprintf((char *)chunk, 65, "%08d: the quick brown fox jumps over the lazy dog ....\n", i);
+        lfs_file_write(lfs, &file, chunk, len);
+        if ((err = lfs_file_sync(lfs, &file))) break;
+        (*ops)++;
+    }
+    lfs_file_close(lfs, &file);
+    return err;
+}
+
+static int wl_rewrite(lfs_t *lfs, uint32_t *ops)
+{
+    for (int i = 0; i < 64; i++) {
+        lfs_file_t file;
+        int err = lfs_file_open(lfs, &file, "settings.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+        if (err) return err;
+        memset(chunk, i, sizeof(chunk));
+        lfs_file_write(lfs, &file, chunk, sizeof(chunk));
+        lfs_file_write(lfs, &file, chunk, sizeof(chunk));
+        if ((err = lfs_file_close(lfs, &file))) return err;
+        (*ops)++;
+    }
+    return 0;
+}
+
+static const struct {
+    const char *name;
+    bench_workload_fn fn;
+} workloads[] = {
+    {"seq_write",   wl_seq_write},
+    {"seq_read",    wl_seq_read},
+    {"rand_read",   wl_rand_read},
+    {"small_files", wl_small_files},
+    {"append_sync", wl_append_sync},
+    {"rewrite",     wl_rewrite},
+};
+#define WORKLOAD_COUNT (sizeof(workloads) / sizeof(workloads[0]))
+
+//---------------
+
+static void record(const bench_geometry_t *geo, const char *workload, uint32_t ops, const bench_bd_t *before, const bench_bd_t *after)
+{
+    if (results_count >= BENCH_MAX_ROWS) {
+        return;
+    }
+    results[results_count++] = (bench_result_t){
+        .geometry = geo->name,
+        .workload = workload,
+        .ops = ops,
+        .sim_us = after->sim_us - before->sim_us,
+        .reads = after->reads - before->reads,
+        .progs = after->progs - before->progs,
+        .erases = after->erases - before->erases,
+        .read_bytes = after->read_bytes - before->read_bytes,
+        .prog_bytes = after->prog_bytes - before->prog_bytes,
+        .erase_bytes = after->erase_bytes - before->erase_bytes,
+    };
+}
+
+static void print_row(const bench_result_t *r)
+{
+    if (opts.csv) {
+        printf("%s,%s,%u,%.0f,%llu,%llu,%llu\n", r->geometry, r->workload, r->ops, r->sim_us,
+               (unsigned long long)r->read_bytes, (unsigned long long)r->prog_bytes, (unsigned long long)r->erase_bytes);
+        return;
+    }
+    printf("%-14s %-12s %6u %10.1f %9.1f %10llu %10llu %10llu %7llu %7llu %6llu\n",
+           r->geometry, r->workload, r->ops, r->sim_us / 1000.0,
+           r->sim_us > 0 ? r->ops / (r->sim_us / 1000000.0) : 0.0,
+           (unsigned long long)r->read_bytes, (unsigned long long)r->prog_bytes, (unsigned long long)r->erase_bytes,
+           (unsigned long long)r->reads, (unsigned long long)r->progs, (unsigned long long)r->erases);
+}
+
+static void print_wear(const struct lfs_config *cfg, const bench_geometry_t *geo)
+{
+    uint32_t min = UINT32_MAX, max = 0, touched = 0;
+    double sum = 0, sum_sq = 0;
+
+    for (lfs_block_t b = 0; b < cfg->block_count; b++) {
+        uint32_t wear = (uint32_t)lfs_emubd_wear(cfg, b);
+        if (wear) {
+            touched++;
+        }
+        min = wear < min ? wear : min;
+        max = wear > max ? wear : max;
+        sum += wear;
+        sum_sq += (double)wear * wear;
+    }
+
+    double avg = sum / cfg->block_count;
+    double stddev = sqrt(sum_sq / cfg->block_count - avg * avg);
+
+    if (opts.csv) {
+        return;
+    }
+    printf("%-14s wear: %u/%u blocks erased, min %u, avg %.2f, max %u, stddev %.2f\n",
+           geo->name, touched, (unsigned)cfg->block_count, min, avg, max, stddev);
+}
+
+static int run_geometry(const bench_geometry_t *geo)
+{
+    bench_bd_t bd = { .geo = geo };
+    bench_bd_t before;
+    lfs_t lfs;
+    uint32_t ops;
+    int err;
+
+    struct lfs_config cfg = {
+        .context = &bd,
+        .read = bench_bd_read,
+        .prog = bench_bd_prog,
+        .erase = bench_bd_erase,
+        .sync = bench_bd_sync,
+        .read_size = geo->read_size,
+        .prog_size = geo->prog_size,
+        .block_size = geo->block_size,
+        .block_count = geo->block_count,
+        .block_cycles = opts.block_cycles,
+        .cache_size = opts.cache_size < geo->prog_size ? geo->prog_size : opts.cache_size,
+        .lookahead_size = opts.lookahead_size,
+    };
+
+    struct lfs_emubd_config bdcfg = {
+        .read_size = geo->read_size,
+        .prog_size = geo->prog_size,
+        .erase_size = geo->block_size,
+        .erase_count = geo->block_count,
+        .erase_value = -1,
+        .erase_cycles = UINT32_MAX, // Never wears out, but lets lfs_emubd track wear
+    };
+
+    if ((err = lfs_emubd_create(&cfg, &bdcfg))) {
+        fprintf(stderr, "%s: could not create block device: %d\n", geo->name, err);
+        return err;
+    }
+
+    prng_state = 0x12345678;
+
+    before = bd;
+    if ((err = lfs_format(&lfs, &cfg)) || (err = lfs_mount(&lfs, &cfg))) {
+        fprintf(stderr, "%s: format/mount failed: %d\n", geo->name, err);
+        lfs_emubd_destroy(&cfg);
+        return err;
+    }
+    record(geo, "format_mount", 1, &before, &bd);
+    print_row(&results[results_count - 1]);
+
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+        if (!name_selected(opts.workload_filter, workloads[i].name)) {
+            continue;
+        }
+        ops = 0;
+        before = bd;
+        if ((err = workloads[i].fn(&lfs, &ops))) {
+            fprintf(stderr, "%s/%s: failed: %d\n", geo->name, workloads[i].name, err);
+            break;
+        }
+        record(geo, workloads[i].name, ops, &before, &bd);
+        print_row(&results[results_count - 1]);
+    }
+
+    lfs_unmount(&lfs);
+    print_wear(&cfg, geo);
+    lfs_emubd_destroy(&cfg);
+    return err;
+}
+
+static int compare_baseline(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256], geometry[32], workload[32];
+    unsigned ops;
+    double sim_us;
+    unsigned long long read_bytes, prog_bytes, erase_bytes;
+    int regressions = 0;
+
+    if (!f) {
+        fprintf(stderr, "cannot open baseline %s\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || sscanf(line, "%31[^,],%31[^,],%u,%lf,%llu,%llu,%llu", geometry, workload,
+                                     &ops, &sim_us, &read_bytes, &prog_bytes, &erase_bytes) != 7) {
+            continue;
+        }
+        for (size_t i = 0; i < results_count; i++) {
+            const bench_result_t *r = &results[i];
+            if (strcmp(r->geometry, geometry) || strcmp(r->workload, workload)) {
+                continue;
+            }
+            double limit = 1.0 + opts.tolerance / 100.0;
+            if (r->sim_us > sim_us * limit || r->prog_bytes > prog_bytes * limit || r->erase_bytes > erase_bytes * limit) {
+                fprintf(stderr, "REGRESSION %s/%s: time %.0f -> %.0f us, prog %llu -> %llu, erase %llu -> %llu\n",
+                        geometry, workload, sim_us, r->sim_us, prog_bytes, (unsigned long long)r->prog_bytes,
+                        erase_bytes, (unsigned long long)r->erase_bytes);
+                regressions++;
+            }
+        }
+    }
+
+    fclose(f);
+    if (!opts.csv) {
+        printf("Baseline %s: %d regression(s) above %.1f%%\n", path, regressions, opts.tolerance);
+    }
+    return regressions ? 1 : 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [options]\n\n"
+           "  -g, --geometry LIST     Comma-separated geometries to run (default: all)\n"
+           "  -w, --workload LIST     Comma-separated workloads to run (default: all)\n"
+           "  -c, --cache SIZE        littlefs cache_size (default %u)\n"
+           "  -l, --lookahead SIZE    littlefs lookahead_size (default %u)\n"
+           "  -C, --block-cycles N    littlefs block_cycles (default %d)\n"
+           "  -b, --baseline FILE     Fail if time/prog/erase exceed FILE by more than the tolerance\n"
+           "  -t, --tolerance PCT     Baseline tolerance in percent (default %.1f)\n"
+           "      --csv               Machine-readable output, same format as the baseline\n"
+           "      --list              List geometries and workloads\n",
+           prog, (unsigned)opts.cache_size, (unsigned)opts.lookahead_size, (int)opts.block_cycles, opts.tolerance);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        {"geometry",     required_argument, NULL, 'g'},
+        {"workload",     required_argument, NULL, 'w'},
+        {"cache",        required_argument, NULL, 'c'},
+        {"lookahead",    required_argument, NULL, 'l'},
+        {"block-cycles", required_argument, NULL, 'C'},
+        {"baseline",     required_argument, NULL, 'b'},
+        {"tolerance",    required_argument, NULL, 't'},
+        {"csv",          no_argument,       NULL, 'x'},
+        {"list",         no_argument,       NULL, 'L'},
+        {"help",         no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt, err = 0;
+
+    while ((opt = getopt_long(argc, argv, "g:w:c:l:C:b:t:h", long_opts, NULL)) != -1) {
+        switch (opt) {
+            case 'g': opts.geometry_filter = optarg; break;
+            case 'w': opts.workload_filter = optarg; break;
+            case 'c': opts.cache_size = strtoul(optarg, NULL, 0); break;
+            case 'l': opts.lookahead_size = strtoul(optarg, NULL, 0); break;
+            case 'C': opts.block_cycles = strtol(optarg, NULL, 0); break;
+            case 'b': opts.baseline = optarg; break;
+            case 't': opts.tolerance = strtod(optarg, NULL); break;
+            case 'x': opts.csv = true; break;
+            case 'L':
+                for (size_t i = 0; i < GEOMETRY_COUNT; i++)
+                    printf("geometry %-14s read %5u prog %5u block %6u count %6u\n", geometries[i].name,
+                           (unsigned)geometries[i].read_size, (unsigned)geometries[i].prog_size,
+                           (unsigned)geometries[i].block_size, (unsigned)geometries[i].block_count);
+                for (size_t i = 0; i < WORKLOAD_COUNT; i++)
+                    printf("workload %s\n", workloads[i].name);
+                return 0;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (opts.csv) {
+        printf("# geometry,workload,ops,sim_us,read_bytes,prog_bytes,erase_bytes\n");
+    } else {
+        printf("cache %u, lookahead %u, block_cycles %d\n\n", (unsigned)opts.cache_size,
+               (unsigned)opts.lookahead_size, (int)opts.block_cycles);
+        printf("%-14s %-12s %6s %10s %9s %10s %10s %10s %7s %7s %6s\n", "geometry", "workload", "ops",
+               "sim_ms", "ops/s", "read_B", "prog_B", "erase_B", "reads", "progs", "erases");
+    }
+
+    for (size_t i = 0; i < GEOMETRY_COUNT; i++) {
+        if (name_selected(opts.geometry_filter, geometries[i].name)) {
+            err |= run_geometry(&geometries[i]);
+        }
+    }
+
+    if (!err && opts.baseline) {
+        err = compare_baseline(opts.baseline);
+    }
+
+    return err ? 1 : 0;
+}
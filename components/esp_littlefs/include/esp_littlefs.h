@@ -204,6 +204,35 @@ esp_err_t esp_littlefs_partition_info(const esp_partition_t* partition, size_t *
 esp_err_t esp_littlefs_sdmmc_info(sdmmc_card_t *sdcard, size_t *total_bytes, size_t *used_bytes);
 #endif
 
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+/**
+ * Get a zero-copy pointer to file data in a memory-mapped partition.
+ *
+ * littlefs stores files as a CTZ skip-list, so data is only contiguous
+ * within one block. out_len reports how many bytes can be read from
+ * out_ptr; call again with offset + out_len to walk the rest of the file.
+ * Files that fit in a single block are returned in one piece.
+ *
+ * The pointer stays valid until the file is modified or the partition is
+ * unregistered. Unflushed writes from open descriptors are not visible.
+ *
+ * @param partition_label  Label of the partition the file is on.
+ * @param path             Path of the file relative to the filesystem root.
+ * @param offset           Offset into the file.
+ * @param[out] out_ptr     Pointer to the file data at offset.
+ * @param[out] out_len     Number of contiguous bytes available at out_ptr.
+ *
+ * @return
+ *          - ESP_OK                  if success
+ *          - ESP_ERR_INVALID_STATE   if not mounted or the partition could not be mapped
+ *          - ESP_ERR_NOT_FOUND       if the file does not exist
+ *          - ESP_ERR_NOT_SUPPORTED   if the file is inlined in its directory entry
+ *          - ESP_ERR_INVALID_ARG     if offset is past the end of the file
+ */
+esp_err_t esp_littlefs_get_file_ptr(const char* partition_label, const char* path, size_t offset,
+                                    const void** out_ptr, size_t* out_len);
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
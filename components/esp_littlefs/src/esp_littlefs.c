@@ -10,6 +10,7 @@
 
 #include "esp_littlefs.h"
 #include "littlefs/lfs.h"
+#include "littlefs/lfs_util.h"
 #include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_system.h"
@@ -183,6 +184,25 @@ static esp_littlefs_t * _efs[CONFIG_LITTLEFS_MAX_PARTITIONS] = { 0 };
 static const char * esp_littlefs_errno(enum lfs_error lfs_errno);
 #endif
 
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+/**
+ * @brief Mirror of lfs_ctz_index(): maps a file position to its CTZ block index
+ *        and (optionally) the offset of that position within the block.
+ */
+static lfs_off_t esp_littlefs_ctz_index(lfs_size_t block_size, lfs_off_t size, lfs_off_t *off) {
+    lfs_off_t b = block_size - 2*4;
+    lfs_off_t i = size / b;
+    if (i == 0) {
+        if (off) *off = size;
+        return 0;
+    }
+
+    i = (size - 4*(lfs_popc(i-1)+2)) / b;
+    if (off) *off = size - b*i - 4*lfs_popc(i);
+    return i;
+}
+#endif
+
 static inline void * esp_littlefs_calloc(size_t __nmemb, size_t __size) {
     /* Used internally by this wrapper only */
 #if defined(CONFIG_LITTLEFS_MALLOC_STRATEGY_INTERNAL)
@@ -253,6 +273,11 @@ esp_err_t format_from_efs(esp_littlefs_t *efs)
             ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to format SD card: 0x%x %s", ret, esp_err_to_name(ret));
             return ret;
         }
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+        /* The read-ahead window holds pre-format data */
+        efs->ra_sector = 0;
+        efs->ra_count = 0;
+#endif
 
         ESP_LOGI(ESP_LITTLEFS_TAG, "SD card formatted!");
     }
@@ -365,6 +390,66 @@ esp_err_t esp_littlefs_partition_info(const esp_partition_t* partition, size_t *
     return ESP_OK;
 }
 
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+esp_err_t esp_littlefs_get_file_ptr(const char* partition_label, const char* path, size_t offset,
+                                    const void** out_ptr, size_t* out_len)
+{
+    int index;
+    esp_err_t err;
+    lfs_file_t file;
+    struct lfs_file_config file_cfg = { 0 };
+
+    assert(path && out_ptr && out_len);
+
+    err = esp_littlefs_by_label(partition_label, &index);
+    if(err != ESP_OK) return err;
+
+    esp_littlefs_t *efs = _efs[index];
+    if(!efs->mmap_ptr) return ESP_ERR_INVALID_STATE;
+
+    file_cfg.buffer = esp_littlefs_calloc(1, efs->cfg.cache_size);
+    if(!file_cfg.buffer) return ESP_ERR_NO_MEM;
+
+    sem_take(efs);
+    int res = lfs_file_opencfg(efs->fs, &file, path, LFS_O_RDONLY, &file_cfg);
+    if(res < 0) {
+        sem_give(efs);
+        free(file_cfg.buffer);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if(file.flags & LFS_F_INLINE) {
+        err = ESP_ERR_NOT_SUPPORTED;
+    } else if(offset >= file.ctz.size) {
+        err = ESP_ERR_INVALID_ARG;
+    } else {
+        /* Same walk as lfs_ctz_find(), reading skip-list pointers straight from the mapping */
+        const lfs_size_t block_size = efs->cfg.block_size;
+        lfs_block_t head = file.ctz.head;
+        lfs_off_t current = esp_littlefs_ctz_index(block_size, file.ctz.size - 1, NULL);
+        lfs_off_t pos;
+        lfs_off_t target = esp_littlefs_ctz_index(block_size, offset, &pos);
+
+        while(current > target) {
+            lfs_size_t skip = lfs_min(lfs_npw2(current - target + 1) - 1, lfs_ctz(current));
+            uint32_t next;
+            memcpy(&next, efs->mmap_ptr + (size_t)head * block_size + 4 * skip, sizeof(next));
+            head = lfs_fromle32(next);
+            current -= 1 << skip;
+        }
+
+        *out_ptr = efs->mmap_ptr + (size_t)head * block_size + pos;
+        *out_len = MIN(block_size - pos, file.ctz.size - offset);
+        err = ESP_OK;
+    }
+
+    lfs_file_close(efs->fs, &file);
+    sem_give(efs);
+    free(file_cfg.buffer);
+    return err;
+}
+#endif
+
 #ifdef CONFIG_LITTLEFS_SDMMC_SUPPORT
 esp_err_t esp_littlefs_sdmmc_info(sdmmc_card_t *sdcard, size_t *total_bytes, size_t *used_bytes)
 {
@@ -737,6 +822,12 @@ static void esp_littlefs_free(esp_littlefs_t ** efs)
     }
     if(e->lock) vSemaphoreDelete(e->lock);
     esp_littlefs_free_fds(e);
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    if(e->ra_buffer) free(e->ra_buffer);
+#endif
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+    if(e->mmap_ptr) esp_partition_munmap(e->mmap_handle);
+#endif
     free(e);
 }
 
@@ -930,10 +1021,14 @@ static esp_err_t esp_littlefs_init_sdcard(esp_littlefs_t** efs, sdmmc_card_t* sd
         (*efs)->cfg.sync  = littlefs_sdmmc_sync;
 
         // block device configuration
+        if (CONFIG_LITTLEFS_SDMMC_BLOCK_SIZE % sdcard->csd.sector_size != 0) {
+            ESP_LOGE(ESP_LITTLEFS_TAG, "LITTLEFS_SDMMC_BLOCK_SIZE is not multiple of SD sector size (%d)", sdcard->csd.sector_size);
+            return ESP_ERR_INVALID_ARG;
+        }
         (*efs)->cfg.read_size = sdcard->csd.sector_size;
         (*efs)->cfg.prog_size = sdcard->csd.sector_size;
-        (*efs)->cfg.block_size = sdcard->csd.sector_size;
-        (*efs)->cfg.block_count = sdcard->csd.capacity;
+        (*efs)->cfg.block_size = CONFIG_LITTLEFS_SDMMC_BLOCK_SIZE;
+        (*efs)->cfg.block_count = sdcard->csd.capacity / (CONFIG_LITTLEFS_SDMMC_BLOCK_SIZE / sdcard->csd.sector_size);
         (*efs)->cfg.cache_size = MAX(CONFIG_LITTLEFS_CACHE_SIZE, sdcard->csd.sector_size); // Must not be smaller than SD sector size
         (*efs)->cfg.lookahead_size = CONFIG_LITTLEFS_LOOKAHEAD_SIZE;
         (*efs)->cfg.block_cycles = CONFIG_LITTLEFS_BLOCK_CYCLES;
@@ -962,6 +1057,14 @@ static esp_err_t esp_littlefs_init_sdcard(esp_littlefs_t** efs, sdmmc_card_t* sd
         return ESP_ERR_NO_MEM;
     }
 
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    (*efs)->ra_buffer = heap_caps_malloc(CONFIG_LITTLEFS_SDMMC_READ_AHEAD_SIZE, MALLOC_CAP_DMA);
+    if ((*efs)->ra_buffer == NULL) {
+        ESP_LOGE(ESP_LITTLEFS_TAG, "read-ahead buffer could not be malloced");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+
     return ESP_OK;
 }
 #endif // CONFIG_LITTLEFS_SDMMC_SUPPORT
@@ -1019,6 +1122,20 @@ static esp_err_t esp_littlefs_init_efs(esp_littlefs_t** efs, const esp_partition
         return ESP_ERR_NO_MEM;
     }
 
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+    {
+        const void *ptr = NULL;
+        esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                           &ptr, &(*efs)->mmap_handle);
+        if (err != ESP_OK) {
+            ESP_LOGW(ESP_LITTLEFS_TAG, "Could not mmap partition \"%s\" (%s), using esp_partition_read",
+                     partition->label, esp_err_to_name(err));
+        } else {
+            (*efs)->mmap_ptr = ptr;
+        }
+    }
+#endif
+
     return ESP_OK;
 }
 
@@ -1151,7 +1268,7 @@ static esp_err_t esp_littlefs_init(const esp_vfs_littlefs_conf_t* conf, int *ind
         if(conf->grow_on_mount){
 #ifdef CONFIG_LITTLEFS_SDMMC_SUPPORT
             if (efs->sdcard) {
-                res = lfs_fs_grow(efs->fs, efs->sdcard->csd.capacity);
+                res = lfs_fs_grow(efs->fs, efs->sdcard->csd.capacity / (efs->cfg.block_size / efs->sdcard->csd.sector_size));
             } else
 #endif
             {
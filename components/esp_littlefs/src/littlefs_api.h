@@ -68,9 +68,18 @@ typedef struct {
 
 #ifdef CONFIG_LITTLEFS_SDMMC_SUPPORT
     sdmmc_card_t *sdcard;                     /*!< The SD card driver handle on which littlefs is located */
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    uint8_t      *ra_buffer;                  /*!< Read-ahead window (DMA capable) */
+    size_t        ra_sector;                  /*!< First sector held in the read-ahead window */
+    size_t        ra_count;                   /*!< Number of valid sectors in the read-ahead window */
+#endif
 #endif
 
     const esp_partition_t* partition;         /*!< The partition on which littlefs is located */
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+    const uint8_t *mmap_ptr;                  /*!< Partition mapped into data space, NULL if not mapped */
+    esp_partition_mmap_handle_t mmap_handle;  /*!< Handle to release the mapping */
+#endif
     char base_path[ESP_VFS_PATH_MAX+1];       /*!< Mount point */
 
     struct lfs_config cfg;                    /*!< littlefs Mount configuration */
@@ -6,6 +6,7 @@
 
 //#define ESP_LOCAL_LOG_LEVEL ESP_LOG_INFO
 
+#include <string.h>
 #include "esp_log.h"
 #include "esp_partition.h"
 #include "esp_vfs.h"
@@ -18,6 +19,12 @@ int littlefs_esp_part_read(const struct lfs_config *c, lfs_block_t block,
                            lfs_off_t off, void *buffer, lfs_size_t size) {
     esp_littlefs_t * efs = c->context;
     size_t part_off = (block * c->block_size) + off;
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+    if (efs->mmap_ptr) {
+        memcpy(buffer, efs->mmap_ptr + part_off, size);
+        return 0;
+    }
+#endif
     esp_err_t err = esp_partition_read(efs->partition, part_off, buffer, size);
     if (err) {
         ESP_LOGE(ESP_LITTLEFS_TAG, "failed to read addr %08x, size %08x, err %d", (unsigned int) part_off, (unsigned int) size, err);
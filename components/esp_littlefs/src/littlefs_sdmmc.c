@@ -5,19 +5,63 @@
  */
 
 #include <sdmmc_cmd.h>
+#include <string.h>
 #include <sys/param.h>
 #include "littlefs_api.h"
 
 #if CONFIG_LITTLEFS_SDMMC_SUPPORT
 
+/**
+ * A littlefs block spans (block_size / sector_size) contiguous sectors.
+ * Computed without multiplying block by block_size so cards > 4GB don't overflow.
+ */
+static inline size_t littlefs_sdmmc_sector(const struct lfs_config *c, lfs_block_t block, lfs_off_t off)
+{
+    esp_littlefs_t * efs = c->context;
+    size_t sector_size = efs->sdcard->csd.sector_size;
+    return (size_t)block * (c->block_size / sector_size) + (off / sector_size);
+}
+
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+static inline void littlefs_sdmmc_ra_invalidate(esp_littlefs_t * efs, size_t sector, size_t count)
+{
+    if (sector < efs->ra_sector + efs->ra_count && efs->ra_sector < sector + count) {
+        efs->ra_count = 0;
+    }
+}
+#endif
+
 int littlefs_sdmmc_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
 {
     esp_littlefs_t * efs = c->context;
-    uint32_t part_off = (block * c->block_size) + off;
+    size_t sector_size = efs->sdcard->csd.sector_size;
+    size_t sector = littlefs_sdmmc_sector(c, block, off);
+    size_t count = size / sector_size;
+    esp_err_t ret;
+
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    const size_t ra_sectors = CONFIG_LITTLEFS_SDMMC_READ_AHEAD_SIZE / sector_size;
+
+    if (efs->ra_buffer && count < ra_sectors) {
+        if (sector < efs->ra_sector || sector + count > efs->ra_sector + efs->ra_count) {
+            size_t fill = MIN(ra_sectors, (size_t)efs->sdcard->csd.capacity - sector);
+            efs->ra_count = 0;
+            ret = sdmmc_read_sectors(efs->sdcard, efs->ra_buffer, sector, fill);
+            if (ret != ESP_OK) {
+                ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to read-ahead sector 0x%08x, count %u, err=0x%x", (unsigned int) sector, (unsigned int) fill, ret);
+                return LFS_ERR_IO;
+            }
+            efs->ra_sector = sector;
+            efs->ra_count = fill;
+        }
+        memcpy(buffer, efs->ra_buffer + (sector - efs->ra_sector) * sector_size, size);
+        return LFS_ERR_OK;
+    }
+#endif
 
-    esp_err_t ret = sdmmc_read_sectors(efs->sdcard, buffer, block, MIN(size / efs->cfg.read_size, 1));
+    ret = sdmmc_read_sectors(efs->sdcard, buffer, sector, count);
     if (ret != ESP_OK) {
-        ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to read addr 0x%08lx: off 0x%08lx, block 0x%08lx, size %lu, err=0x%x", part_off, off, block, size, ret);
+        ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to read sector 0x%08x: off 0x%08lx, block 0x%08lx, size %lu, err=0x%x", (unsigned int) sector, off, block, size, ret);
         return LFS_ERR_IO;
     }
 
@@ -27,11 +71,16 @@ int littlefs_sdmmc_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t
 int littlefs_sdmmc_write(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
 {
     esp_littlefs_t * efs = c->context;
-    uint32_t part_off = (block * c->block_size) + off;
+    size_t sector = littlefs_sdmmc_sector(c, block, off);
+    size_t count = size / efs->sdcard->csd.sector_size;
 
-    esp_err_t ret = sdmmc_write_sectors(efs->sdcard, buffer, block, MIN(size / efs->cfg.prog_size, 1));
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    littlefs_sdmmc_ra_invalidate(efs, sector, count);
+#endif
+
+    esp_err_t ret = sdmmc_write_sectors(efs->sdcard, buffer, sector, count);
     if (ret != ESP_OK) {
-        ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to write addr 0x%08lx: off 0x%08lx, block 0x%08lx, size %lu, err=0x%x", part_off, off, block, size, ret);
+        ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to write sector 0x%08x: off 0x%08lx, block 0x%08lx, size %lu, err=0x%x", (unsigned int) sector, off, block, size, ret);
         return LFS_ERR_IO;
     }
 
@@ -41,7 +90,14 @@ int littlefs_sdmmc_write(const struct lfs_config *c, lfs_block_t block, lfs_off_
 int littlefs_sdmmc_erase(const struct lfs_config *c, lfs_block_t block)
 {
     esp_littlefs_t * efs = c->context;
-    esp_err_t ret = sdmmc_erase_sectors(efs->sdcard, block, 1, SDMMC_ERASE_ARG);
+    size_t sector = littlefs_sdmmc_sector(c, block, 0);
+    size_t count = c->block_size / efs->sdcard->csd.sector_size;
+
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    littlefs_sdmmc_ra_invalidate(efs, sector, count);
+#endif
+
+    esp_err_t ret = sdmmc_erase_sectors(efs->sdcard, sector, count, SDMMC_ERASE_ARG);
     if (ret != ESP_OK) {
         ESP_LOGE(ESP_LITTLEFS_TAG, "Failed to erase block %lu: ret=0x%x %s", block, ret, esp_err_to_name(ret));
         return LFS_ERR_IO;
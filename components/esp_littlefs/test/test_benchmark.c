@@ -253,3 +253,164 @@ TEST_CASE("Write 5 files, read 5 files, then delete 5 files", TAG){
 
     test_benchmark_teardown();
 }
+
+#ifdef CONFIG_LITTLEFS_SDMMC_SUPPORT
+#include <inttypes.h>
+#include "driver/sdspi_host.h"
+#include "sdmmc_cmd.h"
+
+/* The SD cases overwrite the card: they only run with TEST_SD_SCRATCH_CARD defined by the test project,
+ * for a card dedicated to testing */
+#ifdef TEST_SD_SCRATCH_CARD
+#define SD_BENCH_REQUIRE_SCRATCH_CARD()
+#else
+#define SD_BENCH_REQUIRE_SCRATCH_CARD() TEST_IGNORE_MESSAGE("Define TEST_SD_SCRATCH_CARD to run on a dedicated test card")
+#endif
+
+/* Defaults match the ODROID-GO SD slot; override from the test project if needed */
+#ifndef TEST_SDSPI_HOST
+#define TEST_SDSPI_HOST    SPI2_HOST
+#define TEST_SDSPI_MISO    GPIO_NUM_19
+#define TEST_SDSPI_MOSI    GPIO_NUM_23
+#define TEST_SDSPI_CLK     GPIO_NUM_18
+#define TEST_SDSPI_CS      GPIO_NUM_22
+#endif
+
+#define SD_BENCH_SECTORS   128      /* 64KB per transfer, keep labels below in sync */
+#define SD_BENCH_PASSES    16       /* 1MB in total */
+
+static sdmmc_card_t *setup_sdcard(sdmmc_host_t *host)
+{
+    sdmmc_card_t *card = calloc(1, sizeof(sdmmc_card_t));
+    TEST_ASSERT_NOT_NULL(card);
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = TEST_SDSPI_MOSI,
+        .miso_io_num = TEST_SDSPI_MISO,
+        .sclk_io_num = TEST_SDSPI_CLK,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = SD_BENCH_SECTORS * 512,
+    };
+    TEST_ESP_OK(spi_bus_initialize(TEST_SDSPI_HOST, &bus_cfg, SPI_DMA_CH_AUTO));
+
+    sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
+    slot_config.gpio_cs = TEST_SDSPI_CS;
+    slot_config.host_id = TEST_SDSPI_HOST;
+
+    *host = (sdmmc_host_t)SDSPI_HOST_DEFAULT();
+    host->slot = TEST_SDSPI_HOST;
+    TEST_ESP_OK(sdspi_host_init());
+    TEST_ESP_OK(sdspi_host_init_device(&slot_config, &host->slot));
+    TEST_ESP_OK(sdmmc_card_init(host, card));
+    sdmmc_card_print_info(stdout, card);
+    return card;
+}
+
+static void teardown_sdcard(sdmmc_card_t *card)
+{
+    sdspi_host_deinit();
+    spi_bus_free(TEST_SDSPI_HOST);
+    free(card);
+}
+
+static void print_throughput(const char *label, size_t bytes, uint64_t us)
+{
+    printf("%-32s %7u bytes in %8" PRIu64 " us (%.1f KB/s)\n", label, (unsigned int) bytes, us,
+           us ? (bytes / 1024.0) / (us / 1000000.0) : 0.0);
+}
+
+TEST_CASE("SD card: single-sector vs multi-sector transfers", "[littlefs_benchmark][sdmmc][ignore]"){
+    SD_BENCH_REQUIRE_SCRATCH_CARD();
+    sdmmc_host_t host;
+    sdmmc_card_t *card = setup_sdcard(&host);
+    uint8_t *buf = heap_caps_malloc(SD_BENCH_SECTORS * card->csd.sector_size, MALLOC_CAP_DMA);
+    const size_t total = SD_BENCH_PASSES * SD_BENCH_SECTORS * card->csd.sector_size;
+    /* Scratch region at the end of the card, away from the partition table and filesystem metadata */
+    const size_t base = (size_t) card->csd.capacity - SD_BENCH_PASSES * SD_BENCH_SECTORS;
+    uint64_t t_start;
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0xA5, SD_BENCH_SECTORS * card->csd.sector_size);
+
+    /* This is what littlefs_sdmmc_{read,write} used to do: one sector per command */
+    t_start = esp_timer_get_time();
+    for (int p = 0; p < SD_BENCH_PASSES; p++)
+        for (int s = 0; s < SD_BENCH_SECTORS; s++)
+            TEST_ESP_OK(sdmmc_write_sectors(card, buf + s * card->csd.sector_size, base + p * SD_BENCH_SECTORS + s, 1));
+    print_throughput("Write, 1 sector/call:", total, esp_timer_get_time() - t_start);
+
+    t_start = esp_timer_get_time();
+    for (int p = 0; p < SD_BENCH_PASSES; p++)
+        TEST_ESP_OK(sdmmc_write_sectors(card, buf, base + p * SD_BENCH_SECTORS, SD_BENCH_SECTORS));
+    print_throughput("Write, 128 sectors/call:", total, esp_timer_get_time() - t_start);
+
+    t_start = esp_timer_get_time();
+    for (int p = 0; p < SD_BENCH_PASSES; p++)
+        for (int s = 0; s < SD_BENCH_SECTORS; s++)
+            TEST_ESP_OK(sdmmc_read_sectors(card, buf + s * card->csd.sector_size, base + p * SD_BENCH_SECTORS + s, 1));
+    print_throughput("Read, 1 sector/call:", total, esp_timer_get_time() - t_start);
+
+    t_start = esp_timer_get_time();
+    for (int p = 0; p < SD_BENCH_PASSES; p++)
+        TEST_ESP_OK(sdmmc_read_sectors(card, buf, base + p * SD_BENCH_SECTORS, SD_BENCH_SECTORS));
+    print_throughput("Read, 128 sectors/call:", total, esp_timer_get_time() - t_start);
+
+    free(buf);
+    teardown_sdcard(card);
+}
+
+TEST_CASE("SD card: littlefs sequential file throughput", "[littlefs_benchmark][sdmmc][ignore]"){
+    SD_BENCH_REQUIRE_SCRATCH_CARD();
+    sdmmc_host_t host;
+    sdmmc_card_t *card = setup_sdcard(&host);
+    const size_t chunk = 16 * 1024;
+    const size_t total = 1024 * 1024;
+    uint8_t *buf = malloc(chunk);
+    uint64_t t_start;
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0x5A, chunk);
+
+    esp_vfs_littlefs_conf_t conf = {
+        .base_path = "/sdlfs",
+        .sdcard = card,
+        .format_if_mount_failed = true
+    };
+    TEST_ESP_OK(esp_vfs_littlefs_register(&conf));
+#ifdef CONFIG_LITTLEFS_SDMMC_READ_AHEAD
+    printf("Block size %d, read-ahead %d\n", CONFIG_LITTLEFS_SDMMC_BLOCK_SIZE, CONFIG_LITTLEFS_SDMMC_READ_AHEAD_SIZE);
+#else
+    printf("Block size %d, read-ahead off\n", CONFIG_LITTLEFS_SDMMC_BLOCK_SIZE);
+#endif
+
+    t_start = esp_timer_get_time();
+    FILE *f = fopen("/sdlfs/bench.bin", "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    for (size_t i = 0; i < total; i += chunk)
+        TEST_ASSERT_EQUAL(chunk, fwrite(buf, 1, chunk, f));
+    fclose(f);
+    print_throughput("littlefs write:", total, esp_timer_get_time() - t_start);
+
+    t_start = esp_timer_get_time();
+    f = fopen("/sdlfs/bench.bin", "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    for (size_t i = 0; i < total; i += chunk)
+        TEST_ASSERT_EQUAL(chunk, fread(buf, 1, chunk, f));
+    fclose(f);
+    print_throughput("littlefs read:", total, esp_timer_get_time() - t_start);
+
+    /* Small reads are where read-ahead pays off */
+    t_start = esp_timer_get_time();
+    f = fopen("/sdlfs/bench.bin", "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    setvbuf(f, NULL, _IONBF, 0);
+    for (size_t i = 0; i < total; i += 256)
+        TEST_ASSERT_EQUAL(256, fread(buf, 1, 256, f));
+    fclose(f);
+    print_throughput("littlefs read, 256B/call:", total, esp_timer_get_time() - t_start);
+
+    unlink("/sdlfs/bench.bin");
+    TEST_ESP_OK(esp_vfs_littlefs_unregister_sdmmc(card));
+    free(buf);
+    teardown_sdcard(card);
+}
+#endif // CONFIG_LITTLEFS_SDMMC_SUPPORT
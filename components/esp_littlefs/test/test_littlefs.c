@@ -925,6 +925,41 @@ TEST_CASE("fcntl get flags", "[littlefs]")
     test_teardown();
 }
 
+#ifdef CONFIG_LITTLEFS_MMAP_PARTITION
+TEST_CASE("esp_littlefs_get_file_ptr walks file data without copying", "[littlefs]")
+{
+    const size_t size = 3 * 4096 + 123; // Spans several CTZ blocks
+    const char* filename = littlefs_base_path "/mmap.bin";
+    const void* ptr;
+    size_t len;
+
+    test_setup();
+
+    FILE* f = fopen(filename, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    for (size_t i = 0; i < size; i++) {
+        fputc((uint8_t)(i * 7 + i / 300), f);
+    }
+    fclose(f);
+
+    size_t offset = 0;
+    while (offset < size) {
+        TEST_ESP_OK(esp_littlefs_get_file_ptr(littlefs_test_partition_label, "/mmap.bin", offset, &ptr, &len));
+        TEST_ASSERT_GREATER_THAN(0, len);
+        for (size_t i = 0; i < len; i++) {
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)((offset + i) * 7 + (offset + i) / 300), ((const uint8_t*)ptr)[i]);
+        }
+        offset += len;
+    }
+    TEST_ASSERT_EQUAL(size, offset);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_littlefs_get_file_ptr(littlefs_test_partition_label, "/mmap.bin", size, &ptr, &len));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_littlefs_get_file_ptr(littlefs_test_partition_label, "/missing.bin", 0, &ptr, &len));
+
+    test_teardown();
+}
+#endif
+
 /**
  * Cannot use buitin `stat` since it depends on CONFIG_VFS_SUPPORT_DIR.
  */
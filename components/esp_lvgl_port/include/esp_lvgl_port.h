@@ -44,6 +44,15 @@ typedef struct {
     void *param;
 } lvgl_port_event_t;
 
+/**
+ * @brief LVGL Port task frame pacing
+ */
+typedef enum {
+    LVGL_PORT_TASK_PACING_NONE = 0, /*!< Run LVGL whenever it asks for it (default) */
+    LVGL_PORT_TASK_PACING_PERIOD,   /*!< Start the frames on a fixed period (frame_period_ms) */
+    LVGL_PORT_TASK_PACING_TE,       /*!< Start the frames on the rising edge of the panel TE (tearing effect) output (te_gpio_num) */
+} lvgl_port_task_pacing_t;
+
 /**
  * @brief Init configuration structure
  */
@@ -53,8 +62,26 @@ typedef struct {
     int task_affinity;      /*!< LVGL task pinned to core (-1 is no affinity) */
     int task_max_sleep_ms;  /*!< Maximum sleep in LVGL task */
     int timer_period_ms;    /*!< LVGL timer tick period in ms */
+    lvgl_port_task_pacing_t task_pacing;    /*!< LVGL task frame pacing (LVGL9 only) */
+    int frame_period_ms;    /*!< Frame period with LVGL_PORT_TASK_PACING_PERIOD, expected TE period with LVGL_PORT_TASK_PACING_TE (0 is unknown) */
+    int te_gpio_num;        /*!< GPIO connected to the panel TE output, used with LVGL_PORT_TASK_PACING_TE */
+    struct {
+        unsigned int flush_task: 1; /*!< Flush from a separate task, on the other core than the pinned LVGL task (LVGL9 only) */
+    } flags;
 } lvgl_port_cfg_t;
 
+/**
+ * @brief Frame statistics of all displays
+ */
+typedef struct {
+    uint32_t frames;                /*!< Rendered frames */
+    uint32_t dropped_frames;        /*!< Frame slots skipped while LVGL was still busy with the previous frame (paced task only) */
+    uint32_t render_time_us;        /*!< Render time of the last frame, waiting for the flushes excluded */
+    uint32_t render_time_max_us;    /*!< Longest render time */
+    uint32_t flush_time_us;         /*!< Flush time of the last frame, from each flush callback to its transfer done */
+    uint32_t flush_time_max_us;     /*!< Longest flush time */
+} lvgl_port_frame_stats_t;
+
 /**
  * @brief LVGL port configuration structure
  *
@@ -152,6 +179,24 @@ esp_err_t lvgl_port_resume(void);
  */
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param);
 
+/**
+ * @brief Get frame statistics
+ *
+ * @note Flush times are measured only when the flush is finished by the LVGL port callbacks or by lvgl_port_flush_ready()
+ *
+ * @param stats     frame statistics
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if it is not implemented
+ */
+esp_err_t lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *stats);
+
+/**
+ * @brief Reset frame statistics
+ */
+void lvgl_port_reset_frame_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,13 @@ extern "C" {
 #warning "esp_lvgl_port_lv_blend.h included, but CONFIG_LV_DRAW_SW_ASM_CUSTOM not set. Assembly rendering not used"
 #else
 
+#if CONFIG_LVGL_VERSION_MAJOR == 9 && CONFIG_LVGL_VERSION_MINOR >= 2
+/* LVGL 9.2 moved the blend descriptors to a private header and dropped their leading underscore */
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+typedef lv_draw_sw_blend_fill_dsc_t _lv_draw_sw_blend_fill_dsc_t;
+typedef lv_draw_sw_blend_image_dsc_t _lv_draw_sw_blend_image_dsc_t;
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -32,6 +39,21 @@ extern "C" {
     _lv_color_blend_to_rgb565_esp(dsc)
 #endif
 
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    _lv_color_blend_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    _lv_color_blend_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    _lv_color_blend_to_rgb565_mix_mask_opa_esp(dsc)
+#endif
+
 #ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888
 #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888(dsc, dest_px_size) \
     _lv_color_blend_to_rgb888_esp(dsc, dest_px_size)
@@ -42,6 +64,51 @@ extern "C" {
     _lv_rgb565_blend_normal_to_rgb565_esp(dsc)
 #endif
 
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565(dsc, src_px_size)  \
+    _lv_rgb888_blend_normal_to_rgb565_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc, src_px_size)  \
+    _lv_rgb888_blend_normal_to_rgb565_with_opa_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc, src_px_size)  \
+    _lv_rgb888_blend_normal_to_rgb565_with_mask_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc, src_px_size)  \
+    _lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    _lv_argb8888_blend_normal_to_rgb565_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    _lv_argb8888_blend_normal_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    _lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_SWAP
+#define LV_DRAW_SW_RGB565_SWAP(buf, buf_size_px)  \
+    lv_rgb565_swap_esp(buf, buf, buf_size_px)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -92,6 +159,60 @@ static inline lv_result_t _lv_color_blend_to_rgb565_esp(_lv_draw_sw_blend_fill_d
     return lv_color_blend_to_rgb565_esp(&asm_dsc);
 }
 
+extern int lv_color_blend_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_color_blend_to_rgb565_with_opa_esp(&asm_dsc);
+}
+
+extern int lv_color_blend_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_mask_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_color_blend_to_rgb565_with_mask_esp(&asm_dsc);
+}
+
+extern int lv_color_blend_to_rgb565_mix_mask_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_color_blend_to_rgb565_mix_mask_opa_esp(&asm_dsc);
+}
+
 extern int lv_color_blend_to_rgb888_esp(asm_dsc_t *asm_dsc);
 
 static inline lv_result_t _lv_color_blend_to_rgb888_esp(_lv_draw_sw_blend_fill_dsc_t *dsc, uint32_t dest_px_size)
@@ -126,6 +247,172 @@ static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_esp(_lv_draw_sw_blen
     return lv_rgb565_blend_normal_to_rgb565_esp(&asm_dsc);
 }
 
+extern int lv_rgb888_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (src_px_size != 3) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_esp(&asm_dsc);
+}
+
+extern int lv_rgb888_blend_normal_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (src_px_size != 3) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_with_opa_esp(&asm_dsc);
+}
+
+extern int lv_rgb888_blend_normal_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (src_px_size != 3) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_with_mask_esp(&asm_dsc);
+}
+
+extern int lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (src_px_size != 3) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_with_opa_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_with_mask_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_esp(&asm_dsc);
+}
+
+extern int lv_rgb565_swap_esp(const void *src_buf, void *dst_buf, uint32_t px_count);
+
 #endif // CONFIG_LV_DRAW_SW_ASM_CUSTOM
 
 #ifdef __cplusplus
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port OS abstraction for LVGL9
+ *
+ * Selected with CONFIG_LV_OS_CUSTOM=y and CONFIG_LV_OS_CUSTOM_INCLUDE="esp_lvgl_port_os.h".
+ * LVGL includes this file from lv_os.h, the functions are implemented by esp_lvgl_port.
+ *
+ * Differences from the LVGL FreeRTOS OSAL (LV_OS_FREERTOS):
+ *  - Draw unit threads are pinned round-robin to the cores, with the priority of the LVGL task
+ *  - Thread syncs are direct task notifications guarded by a spinlock of the sync, not one shared by all syncs
+ *  - Mutexes are created in lv_mutex_init(), lock and unlock don't check for lazy initialization
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief LVGL thread
+ */
+typedef struct {
+    void (*callback)(void *);           /*!< Thread function */
+    void *user_data;                    /*!< Argument of the thread function */
+    TaskHandle_t task;                  /*!< FreeRTOS task running the thread */
+} lv_thread_t;
+
+/**
+ * @brief LVGL mutex
+ */
+typedef struct {
+    SemaphoreHandle_t mutex;            /*!< FreeRTOS recursive mutex, NULL when not initialized */
+} lv_mutex_t;
+
+/**
+ * @brief LVGL thread sync, one waiting task
+ */
+typedef struct {
+    portMUX_TYPE lock;                  /*!< Spinlock of this sync */
+    TaskHandle_t waiting_task;          /*!< Task waiting for the signal, NULL if none */
+    bool signal;                        /*!< Signal sent while no task was waiting */
+} lv_thread_sync_t;
+
+#ifdef __cplusplus
+}
+#endif
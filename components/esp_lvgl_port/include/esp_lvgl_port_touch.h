@@ -17,6 +17,10 @@
 #if __has_include ("esp_lcd_touch.h")
 #include "esp_lcd_touch.h"
 #define ESP_LVGL_PORT_TOUCH_COMPONENT 1
+#if __has_include ("esp_lcd_touch_service.h")
+#include "esp_lcd_touch_service.h"
+#define ESP_LVGL_PORT_TOUCH_SERVICE 1
+#endif
 #endif
 
 #if LVGL_VERSION_MAJOR == 8
@@ -34,6 +38,9 @@ extern "C" {
 typedef struct {
     lv_display_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
     esp_lcd_touch_handle_t   handle;   /*!< LCD touch IO handle */
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    const esp_lcd_touch_service_config_t *service; /*!< Read the touch in a touch service task with this configuration (NULL: read in LVGL task) */
+#endif
 } lvgl_port_touch_cfg_t;
 
 /**
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port input event ring
+ *
+ * Lock-free single producer, single consumer ring of input events, one per input device instance.
+ * The producer is the iot_button / iot_knob callbacks of the instance, they all run in the esp_timer task.
+ * The consumer is the LVGL read callback, it drains the ring in buffered mode (continue_reading).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_INDEV_RING_LEN    16  /* Power of two, 8 presses and releases between two LVGL reads */
+
+/**
+ * @brief Input event
+ */
+typedef struct {
+    uint32_t key;               /*!< LV_KEY_* of a button, 0 for an encoder step */
+    int32_t enc_diff;           /*!< Encoder steps */
+    lv_indev_state_t state;     /*!< Button state */
+} lvgl_port_indev_event_t;
+
+/**
+ * @brief Input event ring
+ */
+typedef struct {
+    lvgl_port_indev_event_t events[LVGL_PORT_INDEV_RING_LEN];
+    atomic_uint head;           /*!< Next event written, only the producer changes it */
+    atomic_uint tail;           /*!< Next event read, only the consumer changes it */
+} lvgl_port_indev_ring_t;
+
+/**
+ * @brief Empty the ring, before the producer and the consumer start
+ */
+static inline void lvgl_port_indev_ring_init(lvgl_port_indev_ring_t *ring)
+{
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+}
+
+/**
+ * @brief Add an event, producer only
+ *
+ * @return false if the ring is full, the event is not added
+ */
+static inline bool lvgl_port_indev_ring_push(lvgl_port_indev_ring_t *ring, const lvgl_port_indev_event_t *event)
+{
+    const unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= LVGL_PORT_INDEV_RING_LEN) {
+        return false;
+    }
+    ring->events[head % LVGL_PORT_INDEV_RING_LEN] = *event;
+    /* The event is written before the consumer can see it */
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Read the oldest event without removing it, consumer only
+ *
+ * @return false if the ring is empty
+ */
+static inline bool lvgl_port_indev_ring_peek(lvgl_port_indev_ring_t *ring, lvgl_port_indev_event_t *event)
+{
+    const unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&ring->head, memory_order_acquire)) {
+        return false;
+    }
+    *event = ring->events[tail % LVGL_PORT_INDEV_RING_LEN];
+    return true;
+}
+
+/**
+ * @brief Remove the oldest event, after lvgl_port_indev_ring_peek(), consumer only
+ */
+static inline void lvgl_port_indev_ring_drop(lvgl_port_indev_ring_t *ring)
+{
+    /* The event is read before the producer can overwrite it */
+    atomic_fetch_add_explicit(&ring->tail, 1, memory_order_release);
+}
+
+/**
+ * @brief Check for events, consumer only
+ */
+static inline bool lvgl_port_indev_ring_empty(lvgl_port_indev_ring_t *ring)
+{
+    return atomic_load_explicit(&ring->tail, memory_order_relaxed) == atomic_load_explicit(&ring->head, memory_order_acquire);
+}
+
+#ifdef __cplusplus
+}
+#endif
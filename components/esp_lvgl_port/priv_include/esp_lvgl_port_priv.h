@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "lvgl.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,6 +44,52 @@ typedef struct {
  */
 bool lvgl_port_task_notify(uint32_t value);
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Flush request, from the LVGL flush callback to the flush task
+ */
+typedef struct {
+    lv_display_t *disp;     /*!< LVGL display, NULL stops the flush task */
+    lv_area_t area;         /*!< Flushed area, copied because LVGL passes a local variable */
+    uint8_t *color_map;     /*!< Rendered pixels */
+    bool last;              /*!< Last flush of the frame */
+} lvgl_port_flush_req_t;
+
+/**
+ * @brief Post a flush request to the flush task
+ *
+ * @return
+ *      - true, the flush task will do the flush
+ *      - false, there is no flush task, flush in the caller
+ */
+bool lvgl_port_flush_task_post(const lvgl_port_flush_req_t *req);
+
+/**
+ * @brief Flush an area to the display, from the flush task or from the LVGL flush callback
+ */
+void lvgl_port_disp_flush(lvgl_port_flush_req_t *req);
+
+/**
+ * @brief Ask for another read of the input device, it has more buffered events
+ *
+ * @note LVGL reads again while `data->continue_reading` is set, except for LV_INDEV_MODE_EVENT input devices,
+ *       the port reads those again itself. Called from the LVGL read callback.
+ */
+void lvgl_port_indev_continue_reading(lv_indev_data_t *data);
+
+/**
+ * @brief Add a rendered frame to the frame statistics
+ */
+void lvgl_port_frame_rendered(uint32_t render_time_us);
+
+/**
+ * @brief Add a flushed frame to the frame statistics
+ *
+ * @note It can be called from ISR
+ */
+void lvgl_port_frame_flushed(uint32_t flush_time_us);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
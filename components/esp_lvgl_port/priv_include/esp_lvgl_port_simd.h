@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port pixel kernels used in the flush path
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Swap bytes of RGB565 pixels
+ *
+ * @note Implemented in src/lvgl9/simd/lv_rgb565_swap_esp32(s3).S, compiled only when LVGL_PORT_SIMD_FLUSH is set
+ *
+ * @param src_buf   source pixels, 2-byte aligned
+ * @param dst_buf   destination pixels, 2-byte aligned, can be the same as src_buf
+ * @param px_count  number of pixels
+ * @return
+ *      - 1 (LV_RESULT_OK)
+ */
+int lv_rgb565_swap_esp(const void *src_buf, void *dst_buf, uint32_t px_count);
+
+/**
+ * @brief Rotate an RGB565 area by 90 degrees, with the same result as lv_draw_sw_rotate()
+ *
+ * @note Cache blocked in 16x16 pixel tiles, optionally swaps the bytes in the same pass
+ *
+ * @param src         source pixels
+ * @param dst         destination pixels, must not overlap src
+ * @param src_w       source width in pixels
+ * @param src_h       source height in pixels
+ * @param src_stride  source stride in bytes
+ * @param dst_stride  destination stride in bytes, the destination is src_h pixels wide
+ * @param swap_bytes  swap bytes of every pixel, like lv_rgb565_swap_esp()
+ */
+void lvgl_port_rotate90_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes);
+
+/**
+ * @brief Rotate an RGB565 area by 180 degrees, see lvgl_port_rotate90_rgb565()
+ */
+void lvgl_port_rotate180_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes);
+
+/**
+ * @brief Rotate an RGB565 area by 270 degrees, see lvgl_port_rotate90_rgb565()
+ */
+void lvgl_port_rotate270_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes);
+
+#ifdef __cplusplus
+}
+#endif
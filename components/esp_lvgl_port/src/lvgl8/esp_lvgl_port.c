@@ -56,6 +56,7 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     esp_err_t ret = ESP_OK;
     ESP_GOTO_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
     ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
+    ESP_RETURN_ON_FALSE(cfg->task_pacing == LVGL_PORT_TASK_PACING_NONE && !cfg->flags.flush_task, ESP_ERR_NOT_SUPPORTED, TAG, "Frame pacing and flush task are not supported, when used LVGL8!");
 
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 
@@ -162,6 +163,16 @@ esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
     return ESP_ERR_NOT_SUPPORTED;
 }
 
+esp_err_t lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *stats)
+{
+    ESP_LOGE(TAG, "Frame statistics are not supported, when used LVGL8!");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void lvgl_port_reset_frame_stats(void)
+{
+}
+
 IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
 {
     BaseType_t need_yield = pdFALSE;
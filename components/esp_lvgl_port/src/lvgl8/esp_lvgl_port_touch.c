@@ -19,6 +19,11 @@ static const char *TAG = "LVGL";
 typedef struct {
     esp_lcd_touch_handle_t   handle;     /* LCD touch IO handle */
     lv_indev_drv_t           indev_drv;  /* LVGL input device driver */
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    esp_lcd_touch_service_handle_t service; /* Touch service, NULL when read in LVGL task */
+    lv_point_t               point;      /* Last point read from the touch service */
+    lv_indev_state_t         state;      /* Last state read from the touch service */
+#endif
 } lvgl_port_touch_ctx_t;
 
 /*******************************************************************************
@@ -26,6 +31,9 @@ typedef struct {
 *******************************************************************************/
 
 static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+static void lvgl_port_touch_service_read(lvgl_port_touch_ctx_t *touch_ctx, lv_indev_data_t *data);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -38,13 +46,25 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     assert(touch_cfg->handle != NULL);
 
     /* Touch context */
-    lvgl_port_touch_ctx_t *touch_ctx = malloc(sizeof(lvgl_port_touch_ctx_t));
+    lvgl_port_touch_ctx_t *touch_ctx = calloc(1, sizeof(lvgl_port_touch_ctx_t));
     if (touch_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for touch context allocation!");
         return NULL;
     }
     touch_ctx->handle = touch_cfg->handle;
 
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_cfg->service != NULL) {
+        /* Touch service reads the touch, LVGL reads its frames on the indev timer */
+        touch_ctx->state = LV_INDEV_STATE_RELEASED;
+        if (esp_lcd_touch_service_create(touch_ctx->handle, touch_cfg->service, &touch_ctx->service) != ESP_OK) {
+            ESP_LOGE(TAG, "Error in create touch service.");
+            free(touch_ctx);
+            return NULL;
+        }
+    }
+#endif
+
     /* Register a touchpad input device */
     lv_indev_drv_init(&touch_ctx->indev_drv);
     touch_ctx->indev_drv.type = LV_INDEV_TYPE_POINTER;
@@ -64,6 +84,12 @@ esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
     /* Remove input device driver */
     lv_indev_delete(touch);
 
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_ctx && touch_ctx->service != NULL) {
+        esp_lcd_touch_service_del(touch_ctx->service);
+    }
+#endif
+
     if (touch_ctx) {
         free(touch_ctx);
     }
@@ -81,6 +107,13 @@ static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *
     lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)indev_drv->user_data;
     assert(touch_ctx->handle);
 
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_ctx->service != NULL) {
+        lvgl_port_touch_service_read(touch_ctx, data);
+        return;
+    }
+#endif
+
     uint16_t touchpad_x[1] = {0};
     uint16_t touchpad_y[1] = {0};
     uint8_t touchpad_cnt = 0;
@@ -99,3 +132,26 @@ static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *
         data->state = LV_INDEV_STATE_RELEASED;
     }
 }
+
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+static void lvgl_port_touch_service_read(lvgl_port_touch_ctx_t *touch_ctx, lv_indev_data_t *data)
+{
+    esp_lcd_touch_frame_t frame;
+
+    /* One frame per read, LVGL reads again while there are more. LVGL pointer uses the first point only. */
+    if (esp_lcd_touch_service_read_frame(touch_ctx->service, &frame)) {
+        if (frame.points > 0) {
+            touch_ctx->point.x = frame.coords[0].x;
+            touch_ctx->point.y = frame.coords[0].y;
+            touch_ctx->state = LV_INDEV_STATE_PRESSED;
+        } else {
+            touch_ctx->state = LV_INDEV_STATE_RELEASED;
+        }
+        data->continue_reading = esp_lcd_touch_service_has_frame(touch_ctx->service);
+    }
+
+    /* No new frame, the point stays */
+    data->point = touch_ctx->point;
+    data->state = touch_ctx->state;
+}
+#endif
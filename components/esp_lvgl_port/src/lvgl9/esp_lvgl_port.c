@@ -15,6 +15,8 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "driver/gpio.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
 #include "lvgl.h"
@@ -22,6 +24,10 @@
 static const char *TAG = "LVGL";
 
 #define ESP_LVGL_PORT_TASK_MUX_DELAY_MS    10000
+#define ESP_LVGL_PORT_FLUSH_TASK_STACK     4096
+#define ESP_LVGL_PORT_FLUSH_QUEUE_LEN      4    /* LVGL waits for one flush per display before the next one */
+/* Frame slots are counted in the last notification of the LVGL task, LVGL thread syncs use the first one with LV_USE_OS */
+#define ESP_LVGL_PORT_FRAME_NOTIFY_INDEX   (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
 
 /*******************************************************************************
 * Types definitions
@@ -37,18 +43,36 @@ typedef struct lvgl_port_ctx_s {
     bool                running;
     int                 task_max_sleep_ms;
     int                 timer_period_ms;
+    lvgl_port_task_pacing_t task_pacing;
+    int                 frame_period_ms;
+    int                 te_gpio_num;
+    esp_timer_handle_t  frame_timer;
+    bool                te_isr_added;
+    TaskHandle_t        flush_task;
+    QueueHandle_t       flush_queue;
+    SemaphoreHandle_t   flush_task_mux;
+    lvgl_port_frame_stats_t frame_stats;
+    bool                indev_continue;
 } lvgl_port_ctx_t;
 
 /*******************************************************************************
 * Local variables
 *******************************************************************************/
 static lvgl_port_ctx_t lvgl_port_ctx;
+static portMUX_TYPE lvgl_port_stats_lock = portMUX_INITIALIZER_UNLOCKED;
 
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
 static void lvgl_port_task(void *arg);
+static void lvgl_port_task_free_run(void);
+static void lvgl_port_task_paced(void);
+static void lvgl_port_read_indevs(void);
+static void lvgl_port_flush_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
+static esp_err_t lvgl_port_frame_init(void);
+static void lvgl_port_frame_deinit(void);
+static void lvgl_port_flush_task_stop(void);
 static void lvgl_port_task_deinit(void);
 
 /*******************************************************************************
@@ -60,6 +84,9 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     esp_err_t ret = ESP_OK;
     ESP_GOTO_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
     ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
+    ESP_RETURN_ON_FALSE(cfg->task_pacing != LVGL_PORT_TASK_PACING_PERIOD || cfg->frame_period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "Frame period pacing needs frame_period_ms!");
+    ESP_RETURN_ON_FALSE(cfg->task_pacing != LVGL_PORT_TASK_PACING_TE || GPIO_IS_VALID_GPIO(cfg->te_gpio_num), ESP_ERR_INVALID_ARG, TAG, "TE pacing needs a valid te_gpio_num!");
+    ESP_RETURN_ON_FALSE(cfg->task_pacing == LVGL_PORT_TASK_PACING_NONE || LV_USE_OS == LV_OS_NONE || configTASK_NOTIFICATION_ARRAY_ENTRIES > 1, ESP_ERR_NOT_SUPPORTED, TAG, "Frame pacing with LV_USE_OS needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > 1!");
 
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 
@@ -82,8 +109,27 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     /* Task queue */
     lvgl_port_ctx.lvgl_events = xEventGroupCreate();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_events, ESP_ERR_NO_MEM, err, TAG, "Create LVGL Event Group fail!");
+    /* Frame pacing */
+    lvgl_port_ctx.task_pacing = cfg->task_pacing;
+    lvgl_port_ctx.frame_period_ms = cfg->frame_period_ms;
+    lvgl_port_ctx.te_gpio_num = cfg->te_gpio_num;
 
     BaseType_t res;
+    /* Flush task, started first, so it is ready for the first frame */
+    if (cfg->flags.flush_task) {
+        lvgl_port_ctx.flush_task_mux = xSemaphoreCreateMutex();
+        ESP_GOTO_ON_FALSE(lvgl_port_ctx.flush_task_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL flush task sem fail!");
+        lvgl_port_ctx.flush_queue = xQueueCreate(ESP_LVGL_PORT_FLUSH_QUEUE_LEN, sizeof(lvgl_port_flush_req_t));
+        ESP_GOTO_ON_FALSE(lvgl_port_ctx.flush_queue, ESP_ERR_NO_MEM, err, TAG, "Create LVGL flush queue fail!");
+        /* Render and flush on separate cores, when the LVGL task is pinned and there are two */
+        if (cfg->task_affinity < 0 || configNUM_CORES < 2) {
+            res = xTaskCreate(lvgl_port_flush_task, "taskLVGLflush", ESP_LVGL_PORT_FLUSH_TASK_STACK, NULL, cfg->task_priority, &lvgl_port_ctx.flush_task);
+        } else {
+            res = xTaskCreatePinnedToCore(lvgl_port_flush_task, "taskLVGLflush", ESP_LVGL_PORT_FLUSH_TASK_STACK, NULL, cfg->task_priority, &lvgl_port_ctx.flush_task, (cfg->task_affinity + 1) % configNUM_CORES);
+        }
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create LVGL flush task fail!");
+    }
+
     if (cfg->task_affinity < 0) {
         res = xTaskCreate(lvgl_port_task, "taskLVGL", cfg->task_stack, xTaskGetCurrentTaskHandle(), cfg->task_priority, &lvgl_port_ctx.lvgl_task);
     } else {
@@ -113,6 +159,14 @@ esp_err_t lvgl_port_resume(void)
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
     }
 
+    /* Frame slots */
+    if (ret == ESP_OK && lvgl_port_ctx.frame_timer != NULL) {
+        ret = esp_timer_start_periodic(lvgl_port_ctx.frame_timer, lvgl_port_ctx.frame_period_ms * 1000);
+    }
+    if (ret == ESP_OK && lvgl_port_ctx.te_isr_added) {
+        ret = gpio_intr_enable(lvgl_port_ctx.te_gpio_num);
+    }
+
     return ret;
 }
 
@@ -125,6 +179,14 @@ esp_err_t lvgl_port_stop(void)
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
 
+    /* Frame slots, the paced LVGL task sleeps until the resume */
+    if (ret == ESP_OK && lvgl_port_ctx.frame_timer != NULL) {
+        ret = esp_timer_stop(lvgl_port_ctx.frame_timer);
+    }
+    if (ret == ESP_OK && lvgl_port_ctx.te_isr_added) {
+        ret = gpio_intr_disable(lvgl_port_ctx.te_gpio_num);
+    }
+
     return ret;
 }
 
@@ -137,9 +199,13 @@ esp_err_t lvgl_port_deinit(void)
         lvgl_port_ctx.tick_timer = NULL;
     }
 
+    lvgl_port_frame_deinit();
+
     /* Stop running task */
     if (lvgl_port_ctx.running) {
         lvgl_port_ctx.running = false;
+        /* Wake the paced task from waiting for a frame slot */
+        xTaskNotifyGiveIndexed(lvgl_port_ctx.lvgl_task, ESP_LVGL_PORT_FRAME_NOTIFY_INDEX);
     }
 
     /* Wait for stop task */
@@ -149,6 +215,7 @@ esp_err_t lvgl_port_deinit(void)
     }
     ESP_LOGI(TAG, "Stopped LVGL task");
 
+    lvgl_port_flush_task_stop();
     lvgl_port_task_deinit();
 
     return ESP_OK;
@@ -213,6 +280,60 @@ IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
     return (need_yield == pdTRUE);
 }
 
+esp_err_t lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL_SAFE(&lvgl_port_stats_lock);
+    *stats = lvgl_port_ctx.frame_stats;
+    portEXIT_CRITICAL_SAFE(&lvgl_port_stats_lock);
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_frame_stats(void)
+{
+    portENTER_CRITICAL_SAFE(&lvgl_port_stats_lock);
+    memset(&lvgl_port_ctx.frame_stats, 0, sizeof(lvgl_port_ctx.frame_stats));
+    portEXIT_CRITICAL_SAFE(&lvgl_port_stats_lock);
+}
+
+bool lvgl_port_flush_task_post(const lvgl_port_flush_req_t *req)
+{
+    if (lvgl_port_ctx.flush_queue == NULL) {
+        return false;
+    }
+
+    return (xQueueSend(lvgl_port_ctx.flush_queue, req, portMAX_DELAY) == pdTRUE);
+}
+
+void lvgl_port_indev_continue_reading(lv_indev_data_t *data)
+{
+    data->continue_reading = true;
+    lvgl_port_ctx.indev_continue = true;
+}
+
+void lvgl_port_frame_rendered(uint32_t render_time_us)
+{
+    portENTER_CRITICAL_SAFE(&lvgl_port_stats_lock);
+    lvgl_port_ctx.frame_stats.frames++;
+    lvgl_port_ctx.frame_stats.render_time_us = render_time_us;
+    if (render_time_us > lvgl_port_ctx.frame_stats.render_time_max_us) {
+        lvgl_port_ctx.frame_stats.render_time_max_us = render_time_us;
+    }
+    portEXIT_CRITICAL_SAFE(&lvgl_port_stats_lock);
+}
+
+void lvgl_port_frame_flushed(uint32_t flush_time_us)
+{
+    portENTER_CRITICAL_SAFE(&lvgl_port_stats_lock);
+    lvgl_port_ctx.frame_stats.flush_time_us = flush_time_us;
+    if (flush_time_us > lvgl_port_ctx.frame_stats.flush_time_max_us) {
+        lvgl_port_ctx.frame_stats.flush_time_max_us = flush_time_us;
+    }
+    portEXIT_CRITICAL_SAFE(&lvgl_port_stats_lock);
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -220,9 +341,6 @@ IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
 static void lvgl_port_task(void *arg)
 {
     TaskHandle_t task_to_notify = (TaskHandle_t)arg;
-    EventBits_t events = 0;
-    uint32_t task_delay_ms = 0;
-    lv_indev_t *indev = NULL;
 
     /* Take the task semaphore */
     if (xSemaphoreTake(lvgl_port_ctx.task_init_mux, 0) != pdTRUE) {
@@ -237,9 +355,33 @@ static void lvgl_port_task(void *arg)
     xTaskNotifyGive(task_to_notify);
     /* Tick init */
     lvgl_port_tick_init();
+    /* Frame slots init */
+    if (lvgl_port_frame_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Frame pacing init failed, LVGL task is not paced");
+        lvgl_port_frame_deinit();
+        lvgl_port_ctx.task_pacing = LVGL_PORT_TASK_PACING_NONE;
+    }
 
     ESP_LOGI(TAG, "Starting LVGL task");
     lvgl_port_ctx.running = true;
+    if (lvgl_port_ctx.task_pacing == LVGL_PORT_TASK_PACING_NONE) {
+        lvgl_port_task_free_run();
+    } else {
+        lvgl_port_task_paced();
+    }
+
+    /* Give semaphore back */
+    xSemaphoreGive(lvgl_port_ctx.task_init_mux);
+
+    /* Close task */
+    vTaskDelete( NULL );
+}
+
+static void lvgl_port_task_free_run(void)
+{
+    EventBits_t events = 0;
+    uint32_t task_delay_ms = 0;
+
     while (lvgl_port_ctx.running) {
         /* Wait for queue or timeout (sleep task) */
         TickType_t wait = (pdMS_TO_TICKS(task_delay_ms) >= 1 ? pdMS_TO_TICKS(task_delay_ms) : 1);
@@ -249,13 +391,7 @@ static void lvgl_port_task(void *arg)
 
             /* Call read input devices */
             if (events & LVGL_PORT_EVENT_TOUCH) {
-                xSemaphoreTake(lvgl_port_ctx.timer_mux, portMAX_DELAY);
-                indev = lv_indev_get_next(NULL);
-                while (indev != NULL) {
-                    lv_indev_read(indev);
-                    indev = lv_indev_get_next(indev);
-                }
-                xSemaphoreGive(lvgl_port_ctx.timer_mux);
+                lvgl_port_read_indevs();
             }
 
             /* Handle LVGL */
@@ -272,14 +408,99 @@ static void lvgl_port_task(void *arg)
         /* Minimal dealy for the task. When there is too much events, it takes time for other tasks and interrupts. */
         vTaskDelay(1);
     }
+}
+
+static void lvgl_port_task_paced(void)
+{
+    /* Without any frame slot for two periods (TE not connected, panel asleep), start the frame anyway */
+    const int slot_timeout_ms = (lvgl_port_ctx.frame_period_ms > 0 ? 2 * lvgl_port_ctx.frame_period_ms : lvgl_port_ctx.task_max_sleep_ms);
+    const TickType_t slot_timeout = (pdMS_TO_TICKS(slot_timeout_ms) >= 1 ? pdMS_TO_TICKS(slot_timeout_ms) : 1);
+
+    while (lvgl_port_ctx.running) {
+        /* Wait for the frame slot, the notification value counts the slots */
+        ulTaskNotifyTakeIndexed(ESP_LVGL_PORT_FRAME_NOTIFY_INDEX, pdTRUE, slot_timeout);
+        if (!lvgl_port_ctx.running) {
+            break;
+        }
+
+        /* Events since the last frame, invalidations are handled by the LVGL refresh timer anyway */
+        EventBits_t events = xEventGroupClearBits(lvgl_port_ctx.lvgl_events, 0xFF);
+
+        if (lv_display_get_default() && lvgl_port_lock(0)) {
+            /* Call read input devices */
+            if (events & LVGL_PORT_EVENT_TOUCH) {
+                lvgl_port_read_indevs();
+            }
+
+            /* Handle LVGL */
+            lv_timer_handler();
+            lvgl_port_unlock();
+        }
+
+        /* Slots which passed while LVGL was busy are skipped, the next frame starts on a slot edge */
+        const uint32_t missed = ulTaskNotifyTakeIndexed(ESP_LVGL_PORT_FRAME_NOTIFY_INDEX, pdTRUE, 0);
+        if (missed > 0) {
+            portENTER_CRITICAL_SAFE(&lvgl_port_stats_lock);
+            lvgl_port_ctx.frame_stats.dropped_frames += missed;
+            portEXIT_CRITICAL_SAFE(&lvgl_port_stats_lock);
+        }
+    }
+}
+
+static void lvgl_port_read_indevs(void)
+{
+    xSemaphoreTake(lvgl_port_ctx.timer_mux, portMAX_DELAY);
+    lv_indev_t *indev = lv_indev_get_next(NULL);
+    while (indev != NULL) {
+        /* Event mode input devices are read until they have nothing buffered */
+        do {
+            lvgl_port_ctx.indev_continue = false;
+            lv_indev_read(indev);
+        } while (lvgl_port_ctx.indev_continue);
+        indev = lv_indev_get_next(indev);
+    }
+    xSemaphoreGive(lvgl_port_ctx.timer_mux);
+}
+
+static void lvgl_port_flush_task(void *arg)
+{
+    lvgl_port_flush_req_t req;
+
+    /* Take the flush task semaphore */
+    if (xSemaphoreTake(lvgl_port_ctx.flush_task_mux, 0) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to take LVGL flush task sem");
+        vTaskDelete( NULL );
+    }
+
+    ESP_LOGI(TAG, "Starting LVGL flush task");
+    while (xQueueReceive(lvgl_port_ctx.flush_queue, &req, portMAX_DELAY) == pdTRUE && req.disp != NULL) {
+        lvgl_port_disp_flush(&req);
+    }
 
     /* Give semaphore back */
-    xSemaphoreGive(lvgl_port_ctx.task_init_mux);
+    xSemaphoreGive(lvgl_port_ctx.flush_task_mux);
 
     /* Close task */
     vTaskDelete( NULL );
 }
 
+static void lvgl_port_flush_task_stop(void)
+{
+    if (lvgl_port_ctx.flush_task == NULL) {
+        return;
+    }
+
+    /* The pending flushes are done first */
+    const lvgl_port_flush_req_t stop = { .disp = NULL };
+    xQueueSend(lvgl_port_ctx.flush_queue, &stop, portMAX_DELAY);
+    if (xSemaphoreTake(lvgl_port_ctx.flush_task_mux, pdMS_TO_TICKS(ESP_LVGL_PORT_TASK_MUX_DELAY_MS)) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to stop LVGL flush task");
+        return;
+    }
+    xSemaphoreGive(lvgl_port_ctx.flush_task_mux);
+    lvgl_port_ctx.flush_task = NULL;
+}
+
 static void lvgl_port_task_deinit(void)
 {
     if (lvgl_port_ctx.timer_mux) {
@@ -294,6 +515,15 @@ static void lvgl_port_task_deinit(void)
     if (lvgl_port_ctx.lvgl_events) {
         vEventGroupDelete(lvgl_port_ctx.lvgl_events);
     }
+    /* Not deleted, when the flush task did not stop */
+    if (lvgl_port_ctx.flush_task == NULL) {
+        if (lvgl_port_ctx.flush_queue) {
+            vQueueDelete(lvgl_port_ctx.flush_queue);
+        }
+        if (lvgl_port_ctx.flush_task_mux) {
+            vSemaphoreDelete(lvgl_port_ctx.flush_task_mux);
+        }
+    }
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 #if LV_ENABLE_GC || !LV_MEM_CUSTOM
     /* Deinitialize LVGL */
@@ -319,3 +549,60 @@ static esp_err_t lvgl_port_tick_init(void)
     ESP_RETURN_ON_ERROR(esp_timer_create(&lvgl_tick_timer_args, &lvgl_port_ctx.tick_timer), TAG, "Creating LVGL timer filed!");
     return esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
 }
+
+static void IRAM_ATTR lvgl_port_frame_slot(void *arg)
+{
+    /* Count the slot, also from the TE GPIO interrupt */
+    if (xPortInIsrContext() == pdTRUE) {
+        BaseType_t need_yield = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(lvgl_port_ctx.lvgl_task, ESP_LVGL_PORT_FRAME_NOTIFY_INDEX, &need_yield);
+        if (need_yield) {
+            portYIELD_FROM_ISR( );
+        }
+    } else {
+        xTaskNotifyGiveIndexed(lvgl_port_ctx.lvgl_task, ESP_LVGL_PORT_FRAME_NOTIFY_INDEX);
+    }
+}
+
+static esp_err_t lvgl_port_frame_init(void)
+{
+    switch (lvgl_port_ctx.task_pacing) {
+    case LVGL_PORT_TASK_PACING_PERIOD: {
+        const esp_timer_create_args_t frame_timer_args = {
+            .callback = &lvgl_port_frame_slot,
+            .name = "LVGL frame",
+        };
+        ESP_RETURN_ON_ERROR(esp_timer_create(&frame_timer_args, &lvgl_port_ctx.frame_timer), TAG, "Creating LVGL frame timer failed!");
+        return esp_timer_start_periodic(lvgl_port_ctx.frame_timer, lvgl_port_ctx.frame_period_ms * 1000);
+    }
+    case LVGL_PORT_TASK_PACING_TE: {
+        const gpio_config_t te_cfg = {
+            .pin_bit_mask = BIT64(lvgl_port_ctx.te_gpio_num),
+            .mode = GPIO_MODE_INPUT,
+            .intr_type = GPIO_INTR_POSEDGE,
+        };
+        ESP_RETURN_ON_ERROR(gpio_config(&te_cfg), TAG, "TE GPIO config failed!");
+        // The ISR service may already be installed by another driver
+        esp_err_t ret = gpio_install_isr_service(0);
+        ESP_RETURN_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, TAG, "GPIO ISR service install failed!");
+        ESP_RETURN_ON_ERROR(gpio_isr_handler_add(lvgl_port_ctx.te_gpio_num, lvgl_port_frame_slot, NULL), TAG, "TE GPIO ISR add failed!");
+        lvgl_port_ctx.te_isr_added = true;
+        return ESP_OK;
+    }
+    default:
+        return ESP_OK;
+    }
+}
+
+static void lvgl_port_frame_deinit(void)
+{
+    if (lvgl_port_ctx.frame_timer != NULL) {
+        esp_timer_stop(lvgl_port_ctx.frame_timer);
+        esp_timer_delete(lvgl_port_ctx.frame_timer);
+        lvgl_port_ctx.frame_timer = NULL;
+    }
+    if (lvgl_port_ctx.te_isr_added) {
+        gpio_isr_handler_remove(lvgl_port_ctx.te_gpio_num);
+        lvgl_port_ctx.te_isr_added = false;
+    }
+}
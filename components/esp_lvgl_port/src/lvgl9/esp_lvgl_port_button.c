@@ -8,6 +8,8 @@
 #include "esp_err.h"
 #include "esp_check.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_indev_ring.h"
 
 static const char *TAG = "LVGL";
 
@@ -25,11 +27,17 @@ typedef enum {
 typedef struct {
     button_handle_t btn[LVGL_PORT_NAV_BTN_CNT];     /* Button handlers */
     lv_indev_t      *indev;  /* LVGL input device driver */
-    bool btn_prev; /* Button prev state */
-    bool btn_next; /* Button next state */
-    bool btn_enter; /* Button enter state */
+    lvgl_port_indev_ring_t events; /* Presses and releases not read by LVGL yet */
+    uint32_t pressed_key; /* Key pressed for LVGL, 0 if none */
+    uint32_t last_key; /* Last key reported to LVGL */
 } lvgl_port_nav_btns_ctx_t;
 
+static const uint32_t lvgl_port_nav_btn_keys[LVGL_PORT_NAV_BTN_CNT] = {
+    [LVGL_PORT_NAV_BTN_PREV] = LV_KEY_LEFT,
+    [LVGL_PORT_NAV_BTN_NEXT] = LV_KEY_RIGHT,
+    [LVGL_PORT_NAV_BTN_ENTER] = LV_KEY_ENTER,
+};
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -37,6 +45,7 @@ typedef struct {
 static void lvgl_port_navigation_buttons_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
 static void lvgl_port_btn_down_handler(void *arg, void *arg2);
 static void lvgl_port_btn_up_handler(void *arg, void *arg2);
+static void lvgl_port_btn_event(lvgl_port_nav_btns_ctx_t *ctx, button_handle_t button, lv_indev_state_t state);
 
 /*******************************************************************************
 * Public API functions
@@ -50,11 +59,12 @@ lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *but
     assert(buttons_cfg->disp != NULL);
 
     /* Touch context */
-    lvgl_port_nav_btns_ctx_t *buttons_ctx = malloc(sizeof(lvgl_port_nav_btns_ctx_t));
+    lvgl_port_nav_btns_ctx_t *buttons_ctx = calloc(1, sizeof(lvgl_port_nav_btns_ctx_t));
     if (buttons_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for buttons context allocation!");
         return NULL;
     }
+    lvgl_port_indev_ring_init(&buttons_ctx->events);
 
 #if BUTTON_VER_MAJOR < 4
     /* Previous button */
@@ -93,10 +103,6 @@ lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *but
 #endif
     }
 
-    buttons_ctx->btn_prev = false;
-    buttons_ctx->btn_next = false;
-    buttons_ctx->btn_enter = false;
-
     lvgl_port_lock(0);
     /* Register a touchpad input device */
     indev = lv_indev_create();
@@ -151,47 +157,59 @@ esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons)
 
 static void lvgl_port_navigation_buttons_read(lv_indev_t *indev_drv, lv_indev_data_t *data)
 {
-    static uint32_t last_key = 0;
+    lvgl_port_indev_event_t event;
 
     assert(indev_drv);
     lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *)lv_indev_get_driver_data(indev_drv);
     assert(ctx);
 
-    /* Buttons */
-    if (ctx->btn_prev) {
-        data->key = LV_KEY_LEFT;
-        last_key = LV_KEY_LEFT;
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else if (ctx->btn_next) {
-        data->key = LV_KEY_RIGHT;
-        last_key = LV_KEY_RIGHT;
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else if (ctx->btn_enter) {
-        data->key = LV_KEY_ENTER;
-        last_key = LV_KEY_ENTER;
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        data->key = last_key;
-        data->state = LV_INDEV_STATE_RELEASED;
+    /* One press or release per read, LVGL reads again while there are more */
+    while (lvgl_port_indev_ring_peek(&ctx->events, &event)) {
+        if (event.state == LV_INDEV_STATE_PRESSED) {
+            if (ctx->pressed_key != 0 && ctx->pressed_key != event.key) {
+                /* Another key is still held: release it first, the press is read next time */
+                data->key = ctx->pressed_key;
+                data->state = LV_INDEV_STATE_RELEASED;
+                lvgl_port_indev_continue_reading(data);
+                ctx->last_key = ctx->pressed_key;
+                ctx->pressed_key = 0;
+                return;
+            }
+            ctx->pressed_key = event.key;
+        } else if (event.key == ctx->pressed_key) {
+            ctx->pressed_key = 0;
+        } else {
+            /* Already released for a later press */
+            lvgl_port_indev_ring_drop(&ctx->events);
+            continue;
+        }
+        lvgl_port_indev_ring_drop(&ctx->events);
+
+        data->key = event.key;
+        data->state = event.state;
+        if (!lvgl_port_indev_ring_empty(&ctx->events)) {
+            lvgl_port_indev_continue_reading(data);
+        }
+        ctx->last_key = event.key;
+        return;
     }
+
+    /* No new event, the held key stays pressed */
+    data->key = ctx->last_key;
+    data->state = (ctx->pressed_key != 0) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
 }
 
-static void lvgl_port_btn_down_handler(void *arg, void *arg2)
+static void lvgl_port_btn_event(lvgl_port_nav_btns_ctx_t *ctx, button_handle_t button, lv_indev_state_t state)
 {
-    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *) arg2;
-    button_handle_t button = (button_handle_t)arg;
-    if (ctx && button) {
-        /* PREV */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_PREV]) {
-            ctx->btn_prev = true;
-        }
-        /* NEXT */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_NEXT]) {
-            ctx->btn_next = true;
-        }
-        /* ENTER */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_ENTER]) {
-            ctx->btn_enter = true;
+    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+        if (button == ctx->btn[i]) {
+            const lvgl_port_indev_event_t event = {
+                .key = lvgl_port_nav_btn_keys[i],
+                .state = state,
+            };
+            if (!lvgl_port_indev_ring_push(&ctx->events, &event)) {
+                ESP_LOGW(TAG, "Button event lost, LVGL doesn't read the buttons");
+            }
         }
     }
 
@@ -199,25 +217,20 @@ static void lvgl_port_btn_down_handler(void *arg, void *arg2)
     lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
 }
 
-static void lvgl_port_btn_up_handler(void *arg, void *arg2)
+static void lvgl_port_btn_down_handler(void *arg, void *arg2)
 {
     lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *) arg2;
     button_handle_t button = (button_handle_t)arg;
     if (ctx && button) {
-        /* PREV */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_PREV]) {
-            ctx->btn_prev = false;
-        }
-        /* NEXT */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_NEXT]) {
-            ctx->btn_next = false;
-        }
-        /* ENTER */
-        if (button == ctx->btn[LVGL_PORT_NAV_BTN_ENTER]) {
-            ctx->btn_enter = false;
-        }
+        lvgl_port_btn_event(ctx, button, LV_INDEV_STATE_PRESSED);
     }
+}
 
-    /* Wake LVGL task, if needed */
-    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
+static void lvgl_port_btn_up_handler(void *arg, void *arg2)
+{
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *) arg2;
+    button_handle_t button = (button_handle_t)arg;
+    if (ctx && button) {
+        lvgl_port_btn_event(ctx, button, LV_INDEV_STATE_RELEASED);
+    }
 }
@@ -13,11 +13,13 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "esp_idf_version.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_simd.h"
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #include "esp_lcd_panel_rgb.h"
@@ -54,6 +56,14 @@ typedef struct {
     lv_display_t              *disp_drv;      /* LVGL display driver */
     lv_display_rotation_t     current_rotation;
     SemaphoreHandle_t         trans_sem;      /* Idle transfer mutex */
+    struct {
+        int64_t  refr_start_us;  /* Start of the refresh in progress */
+        int64_t  wait_start_us;  /* Start of the wait for a flush in progress */
+        uint32_t wait_us;        /* Time the refresh in progress waited for flushes */
+        int64_t  flush_start_us; /* Start of the flush in progress */
+        uint32_t flush_us;       /* Flushes of the frame in progress */
+        bool     flush_last;     /* The flush in progress is the last one of the frame */
+    } frame;                      /* Frame statistics */
     struct {
         unsigned int monochrome: 1;  /* True, if display is monochrome and using 1bit for 1px */
         unsigned int swap_bytes: 1;  /* Swap bytes in RGB656 (16-bit) before send to LCD driver */
@@ -78,6 +88,8 @@ static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t pane
 #endif
 #endif
 static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_disp_flush_done(lv_display_t *disp);
+static void lvgl_port_display_frame_callback(lv_event_t *e);
 static void lvgl_port_disp_size_update_callback(lv_event_t *e);
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx);
 static void lvgl_port_display_invalidate_callback(lv_event_t *e);
@@ -229,7 +241,7 @@ esp_err_t lvgl_port_remove_disp(lv_display_t *disp)
 void lvgl_port_flush_ready(lv_display_t *disp)
 {
     assert(disp);
-    lv_disp_flush_ready(disp);
+    lvgl_port_disp_flush_done(disp);
 }
 
 /*******************************************************************************
@@ -371,6 +383,10 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     lv_display_add_event_cb(disp, lvgl_port_disp_size_update_callback, LV_EVENT_RESOLUTION_CHANGED, disp_ctx);
     lv_display_add_event_cb(disp, lvgl_port_display_invalidate_callback, LV_EVENT_INVALIDATE_AREA, disp_ctx);
     lv_display_add_event_cb(disp, lvgl_port_display_invalidate_callback, LV_EVENT_REFR_REQUEST, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_display_frame_callback, LV_EVENT_REFR_START, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_display_frame_callback, LV_EVENT_RENDER_READY, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_display_frame_callback, LV_EVENT_FLUSH_WAIT_START, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_display_frame_callback, LV_EVENT_FLUSH_WAIT_FINISH, disp_ctx);
 
     lv_display_set_driver_data(disp, disp_ctx);
     disp_ctx->disp_drv = disp;
@@ -412,7 +428,7 @@ static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io
 {
     lv_display_t *disp_drv = (lv_display_t *)user_ctx;
     assert(disp_drv != NULL);
-    lv_disp_flush_ready(disp_drv);
+    lvgl_port_disp_flush_done(disp_drv);
     return false;
 }
 
@@ -421,7 +437,7 @@ static bool lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t pane
 {
     lv_display_t *disp_drv = (lv_display_t *)user_ctx;
     assert(disp_drv != NULL);
-    lv_disp_flush_ready(disp_drv);
+    lvgl_port_disp_flush_done(disp_drv);
     return false;
 }
 
@@ -559,11 +575,12 @@ void lvgl_port_rotate_area(lv_display_t *disp, lv_area_t *area)
     }
 }
 
-static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+void lvgl_port_disp_flush(lvgl_port_flush_req_t *req)
 {
-    assert(drv != NULL);
-    assert(area != NULL);
-    assert(color_map != NULL);
+    assert(req != NULL);
+    lv_display_t *drv = req->disp;
+    lv_area_t *area = &req->area;
+    uint8_t *color_map = req->color_map;
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
     assert(disp_ctx != NULL);
 
@@ -572,6 +589,8 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
     int offsety1 = area->y1;
     int offsety2 = area->y2;
 
+    bool swapped = false;
+
     /* SW rotation enabled */
     if (disp_ctx->flags.sw_rotate && (disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0)) {
         /* SW rotation */
@@ -581,7 +600,17 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
             lv_color_format_t cf = lv_display_get_color_format(drv);
             uint32_t w_stride = lv_draw_buf_width_to_stride(ww, cf);
             uint32_t h_stride = lv_draw_buf_width_to_stride(hh, cf);
-            if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
+            if (cf == LV_COLOR_FORMAT_RGB565) {
+                /* Tiled rotation, bytes are swapped in the same pass */
+                swapped = disp_ctx->flags.swap_bytes;
+                if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
+                    lvgl_port_rotate180_rgb565(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, w_stride, swapped);
+                } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
+                    lvgl_port_rotate90_rgb565(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, swapped);
+                } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_270) {
+                    lvgl_port_rotate270_rgb565(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, swapped);
+                }
+            } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], hh, ww, h_stride, h_stride, LV_DISPLAY_ROTATION_180, cf);
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, LV_DISPLAY_ROTATION_90, cf);
@@ -589,7 +618,7 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, LV_DISPLAY_ROTATION_270, cf);
             }
             color_map = (uint8_t *)disp_ctx->draw_buffs[2];
-            lvgl_port_rotate_area(drv, (lv_area_t *)area);
+            lvgl_port_rotate_area(drv, area);
             offsetx1 = area->x1;
             offsetx2 = area->x2;
             offsety1 = area->y1;
@@ -597,9 +626,13 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
         }
     }
 
-    if (disp_ctx->flags.swap_bytes) {
+    if (disp_ctx->flags.swap_bytes && !swapped) {
         size_t len = lv_area_get_size(area);
+#if LVGL_PORT_SIMD_FLUSH
+        lv_rgb565_swap_esp(color_map, color_map, len);
+#else
         lv_draw_sw_rgb565_swap(color_map, len);
+#endif
     }
 
     /* Transfer data in buffer for monochromatic screen */
@@ -608,7 +641,7 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
     }
 
     if ((disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) {
-        if (lv_disp_flush_is_last(drv)) {
+        if (req->last) {
             /* If the interface is I80 or SPI, this step cannot be used for drawing. */
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv), color_map);
             /* Waiting for the last frame buffer to complete transmission */
@@ -620,10 +653,46 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
     }
 
     if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh))) {
-        lv_disp_flush_ready(drv);
+        lvgl_port_disp_flush_done(drv);
     }
 }
 
+static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    assert(drv != NULL);
+    assert(area != NULL);
+    assert(color_map != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    lvgl_port_flush_req_t req = {
+        .disp = drv,
+        .area = *area,
+        .color_map = color_map,
+        .last = lv_disp_flush_is_last(drv),
+    };
+    disp_ctx->frame.flush_start_us = esp_timer_get_time();
+    disp_ctx->frame.flush_last = req.last;
+
+    /* Convert and send from the flush task, LVGL renders the next area meanwhile */
+    if (!lvgl_port_flush_task_post(&req)) {
+        lvgl_port_disp_flush(&req);
+    }
+}
+
+static void lvgl_port_disp_flush_done(lv_display_t *disp)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    disp_ctx->frame.flush_us += esp_timer_get_time() - disp_ctx->frame.flush_start_us;
+    if (disp_ctx->frame.flush_last) {
+        lvgl_port_frame_flushed(disp_ctx->frame.flush_us);
+        disp_ctx->frame.flush_us = 0;
+    }
+    lv_disp_flush_ready(disp);
+}
+
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx)
 {
     assert(disp_ctx != NULL);
@@ -682,3 +751,28 @@ static void lvgl_port_display_invalidate_callback(lv_event_t *e)
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
 }
+
+static void lvgl_port_display_frame_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    const int64_t now = esp_timer_get_time();
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+        disp_ctx->frame.refr_start_us = now;
+        disp_ctx->frame.wait_us = 0;
+        break;
+    case LV_EVENT_FLUSH_WAIT_START:
+        disp_ctx->frame.wait_start_us = now;
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+        disp_ctx->frame.wait_us += now - disp_ctx->frame.wait_start_us;
+        break;
+    case LV_EVENT_RENDER_READY:
+        /* Sent only when something was redrawn */
+        lvgl_port_frame_rendered(now - disp_ctx->frame.refr_start_us - disp_ctx->frame.wait_us);
+        break;
+    default:
+        break;
+    }
+}
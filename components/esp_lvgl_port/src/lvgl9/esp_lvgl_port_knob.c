@@ -8,6 +8,8 @@
 #include "esp_err.h"
 #include "esp_check.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_indev_ring.h"
 
 static const char *TAG = "LVGL";
 
@@ -19,8 +21,10 @@ typedef struct {
     knob_handle_t   knob_handle;    /* Encoder knob handlers */
     button_handle_t btn_handle;     /* Encoder button handlers */
     lv_indev_t      *indev;         /* LVGL input device driver */
-    bool btn_enter;                 /* Encoder button enter state */
-    int32_t diff;                   /* Encoder diff */
+    lvgl_port_indev_ring_t events;  /* Steps, presses and releases not read by LVGL yet */
+    int32_t pending_diff;           /* Encoder steps not added to the events, the ring was full */
+    int32_t last_count;             /* Knob count of the last step */
+    lv_indev_state_t btn_state;     /* Encoder button state reported to LVGL */
 } lvgl_port_encoder_ctx_t;
 
 /*******************************************************************************
@@ -32,7 +36,8 @@ static void lvgl_port_encoder_btn_down_handler(void *button_handle, void *usr_da
 static void lvgl_port_encoder_btn_up_handler(void *button_handle, void *usr_data);
 static void lvgl_port_encoder_left_handler(void *arg, void *arg2);
 static void lvgl_port_encoder_right_handler(void *arg, void *arg2);
-static int32_t lvgl_port_calculate_diff(knob_handle_t knob, knob_event_t event);
+static void lvgl_port_encoder_event(lvgl_port_encoder_ctx_t *ctx, const lvgl_port_indev_event_t *event);
+static int32_t lvgl_port_calculate_diff(lvgl_port_encoder_ctx_t *ctx, knob_event_t event);
 
 /*******************************************************************************
 * Public API functions
@@ -46,16 +51,19 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
     assert(encoder_cfg->disp != NULL);
 
     /* Encoder context */
-    lvgl_port_encoder_ctx_t *encoder_ctx = malloc(sizeof(lvgl_port_encoder_ctx_t));
+    lvgl_port_encoder_ctx_t *encoder_ctx = calloc(1, sizeof(lvgl_port_encoder_ctx_t));
     if (encoder_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for encoder context allocation!");
         return NULL;
     }
+    lvgl_port_indev_ring_init(&encoder_ctx->events);
+    encoder_ctx->btn_state = LV_INDEV_STATE_RELEASED;
 
     /* Encoder_a/b */
     if (encoder_cfg->encoder_a_b != NULL) {
         encoder_ctx->knob_handle = iot_knob_create(encoder_cfg->encoder_a_b);
         ESP_GOTO_ON_FALSE(encoder_ctx->knob_handle, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for knob create!");
+        encoder_ctx->last_count = iot_knob_get_count_value(encoder_ctx->knob_handle);
 
         ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_LEFT, lvgl_port_encoder_left_handler, encoder_ctx));
         ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_RIGHT, lvgl_port_encoder_right_handler, encoder_ctx));
@@ -80,9 +88,6 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
     ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_UP, NULL, lvgl_port_encoder_btn_up_handler, encoder_ctx));
 #endif
 
-    encoder_ctx->btn_enter = false;
-    encoder_ctx->diff = 0;
-
     lvgl_port_lock(0);
     /* Register a encoder input device */
     indev = lv_indev_create();
@@ -148,9 +153,47 @@ static void lvgl_port_encoder_read(lv_indev_t *indev_drv, lv_indev_data_t *data)
     lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)lv_indev_get_driver_data(indev_drv);
     assert(ctx);
 
-    data->enc_diff = ctx->diff;
-    data->state = (true == ctx->btn_enter) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
-    ctx->diff = 0;
+    lvgl_port_indev_event_t event;
+
+    /* One step, press or release per read, LVGL reads again while there are more */
+    data->enc_diff = 0;
+    if (lvgl_port_indev_ring_peek(&ctx->events, &event)) {
+        lvgl_port_indev_ring_drop(&ctx->events);
+        if (event.key == 0) {
+            data->enc_diff = event.enc_diff;
+        } else {
+            ctx->btn_state = event.state;
+        }
+        if (!lvgl_port_indev_ring_empty(&ctx->events)) {
+            lvgl_port_indev_continue_reading(data);
+        }
+    }
+    data->state = ctx->btn_state;
+}
+
+static void lvgl_port_encoder_event(lvgl_port_encoder_ctx_t *ctx, const lvgl_port_indev_event_t *event)
+{
+    /* Steps that didn't fit go first, so a press or release stays after them */
+    if (ctx->pending_diff != 0) {
+        const lvgl_port_indev_event_t step = {
+            .enc_diff = ctx->pending_diff,
+        };
+        if (lvgl_port_indev_ring_push(&ctx->events, &step)) {
+            ctx->pending_diff = 0;
+        }
+    }
+
+    if (event->key == 0) {
+        if (ctx->pending_diff != 0 || !lvgl_port_indev_ring_push(&ctx->events, event)) {
+            /* Kept until the ring has room */
+            ctx->pending_diff += event->enc_diff;
+        }
+    } else if (!lvgl_port_indev_ring_push(&ctx->events, event)) {
+        ESP_LOGW(TAG, "Encoder button event lost, LVGL doesn't read the encoder");
+    }
+
+    /* Wake LVGL task, if needed */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
 }
 
 static void lvgl_port_encoder_btn_down_handler(void *button_handle, void *usr_data)
@@ -160,12 +203,13 @@ static void lvgl_port_encoder_btn_down_handler(void *button_handle, void *usr_da
     if (ctx && button) {
         /* ENTER */
         if (button == ctx->btn_handle) {
-            ctx->btn_enter = true;
+            const lvgl_port_indev_event_t event = {
+                .key = LV_KEY_ENTER,
+                .state = LV_INDEV_STATE_PRESSED,
+            };
+            lvgl_port_encoder_event(ctx, &event);
         }
     }
-
-    /* Wake LVGL task, if needed */
-    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
 }
 
 static void lvgl_port_encoder_btn_up_handler(void *button_handle, void *usr_data)
@@ -175,12 +219,13 @@ static void lvgl_port_encoder_btn_up_handler(void *button_handle, void *usr_data
     if (ctx && button) {
         /* ENTER */
         if (button == ctx->btn_handle) {
-            ctx->btn_enter = false;
+            const lvgl_port_indev_event_t event = {
+                .key = LV_KEY_ENTER,
+                .state = LV_INDEV_STATE_RELEASED,
+            };
+            lvgl_port_encoder_event(ctx, &event);
         }
     }
-
-    /* Wake LVGL task, if needed */
-    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
 }
 
 static void lvgl_port_encoder_left_handler(void *arg, void *arg2)
@@ -190,11 +235,13 @@ static void lvgl_port_encoder_left_handler(void *arg, void *arg2)
     if (ctx && knob) {
         /* LEFT */
         if (knob == ctx->knob_handle) {
-            int32_t diff = lvgl_port_calculate_diff(knob, KNOB_LEFT);
-            ctx->diff = (ctx->diff > 0) ? diff : ctx->diff + diff;
+            const lvgl_port_indev_event_t event = {
+                .enc_diff = lvgl_port_calculate_diff(ctx, KNOB_LEFT),
+            };
+            if (event.enc_diff != 0) {
+                lvgl_port_encoder_event(ctx, &event);
+            }
         }
-        /* Wake LVGL task, if needed */
-        lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
     }
 }
 
@@ -205,28 +252,29 @@ static void lvgl_port_encoder_right_handler(void *arg, void *arg2)
     if (ctx && knob) {
         /* RIGHT */
         if (knob == ctx->knob_handle) {
-            int32_t diff = lvgl_port_calculate_diff(knob, KNOB_RIGHT);
-            ctx->diff = (ctx->diff < 0) ? diff : ctx->diff + diff;
+            const lvgl_port_indev_event_t event = {
+                .enc_diff = lvgl_port_calculate_diff(ctx, KNOB_RIGHT),
+            };
+            if (event.enc_diff != 0) {
+                lvgl_port_encoder_event(ctx, &event);
+            }
         }
-        /* Wake LVGL task, if needed */
-        lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
     }
 }
 
 
-static int32_t lvgl_port_calculate_diff(knob_handle_t knob, knob_event_t event)
+static int32_t lvgl_port_calculate_diff(lvgl_port_encoder_ctx_t *ctx, knob_event_t event)
 {
-    static int32_t last_v = 0;
-
     int32_t diff = 0;
-    int32_t invd = iot_knob_get_count_value(knob);
+    int32_t invd = iot_knob_get_count_value(ctx->knob_handle);
 
-    if (last_v ^ invd) {
+    /* Last count is per encoder, the knobs count independently */
+    if (ctx->last_count ^ invd) {
 
-        diff = (int32_t)((uint32_t)invd - (uint32_t)last_v);
-        diff += (event == KNOB_RIGHT && invd < last_v) ? CONFIG_KNOB_HIGH_LIMIT :
-                (event == KNOB_LEFT && invd > last_v) ? CONFIG_KNOB_LOW_LIMIT : 0;
-        last_v = invd;
+        diff = (int32_t)((uint32_t)invd - (uint32_t)ctx->last_count);
+        diff += (event == KNOB_RIGHT && invd < ctx->last_count) ? CONFIG_KNOB_HIGH_LIMIT :
+                (event == KNOB_LEFT && invd > ctx->last_count) ? CONFIG_KNOB_LOW_LIMIT : 0;
+        ctx->last_count = invd;
     }
 
     return diff;
@@ -0,0 +1,209 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "lvgl.h"
+
+#if LV_USE_OS == LV_OS_CUSTOM
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+/* Running threads, the next one is pinned to the core after the last one */
+static uint32_t lvgl_port_os_threads;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_os_thread(void *arg);
+static UBaseType_t lvgl_port_os_priority(lv_thread_prio_t prio);
+
+/*******************************************************************************
+* LVGL OSAL functions
+*******************************************************************************/
+
+lv_result_t lv_thread_init(lv_thread_t *thread, lv_thread_prio_t prio, void (*callback)(void *), size_t stack_size, void *user_data)
+{
+    thread->callback = callback;
+    thread->user_data = user_data;
+
+    /* Draw units render in parallel only on separate cores, they are spread over the cores in creation order */
+    const BaseType_t core = (configNUM_CORES > 1 ? (BaseType_t)(lvgl_port_os_threads % configNUM_CORES) : tskNO_AFFINITY);
+    if (xTaskCreatePinnedToCore(lvgl_port_os_thread, "taskLVGLdraw", stack_size, thread, lvgl_port_os_priority(prio), &thread->task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Create LVGL draw task fail!");
+        return LV_RESULT_INVALID;
+    }
+    lvgl_port_os_threads++;
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_delete(lv_thread_t *thread)
+{
+    if (thread->task) {
+        vTaskDelete(thread->task);
+        thread->task = NULL;
+        lvgl_port_os_threads--;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_init(lv_mutex_t *mutex)
+{
+    /* Recursive as in the LVGL OSALs, callbacks run under lv_lock() of lv_timer_handler() and may lock again */
+    mutex->mutex = xSemaphoreCreateRecursiveMutex();
+    if (mutex->mutex == NULL) {
+        ESP_LOGE(TAG, "Create LVGL mutex fail!");
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_lock(lv_mutex_t *mutex)
+{
+    return (xSemaphoreTakeRecursive(mutex->mutex, portMAX_DELAY) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_lock_isr(lv_mutex_t *mutex)
+{
+    BaseType_t need_yield = pdFALSE;
+    const BaseType_t res = xSemaphoreTakeFromISR(mutex->mutex, &need_yield);
+    if (need_yield) {
+        portYIELD_FROM_ISR( );
+    }
+
+    return (res == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_unlock(lv_mutex_t *mutex)
+{
+    return (xSemaphoreGiveRecursive(mutex->mutex) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_delete(lv_mutex_t *mutex)
+{
+    if (mutex->mutex) {
+        vSemaphoreDelete(mutex->mutex);
+        mutex->mutex = NULL;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_init(lv_thread_sync_t *sync)
+{
+    portMUX_INITIALIZE(&sync->lock);
+    sync->waiting_task = NULL;
+    sync->signal = false;
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t *sync)
+{
+    const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    portENTER_CRITICAL(&sync->lock);
+    const bool signal = sync->signal;
+    sync->signal = false;
+    if (!signal) {
+        /* Not signaled yet, the signal notifies this task */
+        sync->waiting_task = task;
+    }
+    portEXIT_CRITICAL(&sync->lock);
+
+    if (!signal) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t *sync)
+{
+    portENTER_CRITICAL(&sync->lock);
+    const TaskHandle_t task = sync->waiting_task;
+    sync->waiting_task = NULL;
+    if (task == NULL) {
+        /* Nobody waits, the next wait returns immediately */
+        sync->signal = true;
+    }
+    portEXIT_CRITICAL(&sync->lock);
+
+    if (task != NULL) {
+        xTaskNotifyGive(task);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal_isr(lv_thread_sync_t *sync)
+{
+    portENTER_CRITICAL_ISR(&sync->lock);
+    const TaskHandle_t task = sync->waiting_task;
+    sync->waiting_task = NULL;
+    if (task == NULL) {
+        sync->signal = true;
+    }
+    portEXIT_CRITICAL_ISR(&sync->lock);
+
+    if (task != NULL) {
+        BaseType_t need_yield = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &need_yield);
+        if (need_yield) {
+            portYIELD_FROM_ISR( );
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t *sync)
+{
+    sync->waiting_task = NULL;
+    sync->signal = false;
+
+    return LV_RESULT_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_os_thread(void *arg)
+{
+    lv_thread_t *thread = (lv_thread_t *)arg;
+
+    thread->callback(thread->user_data);
+
+    /* LVGL deletes the thread with lv_thread_delete() right after telling it to exit, possibly from the other core.
+     * The task doesn't delete itself, so the handle stays valid until then. */
+    vTaskSuspend( NULL );
+}
+
+static UBaseType_t lvgl_port_os_priority(lv_thread_prio_t prio)
+{
+    /* LVGL creates its threads from lv_init(), called in the LVGL task. LV_THREAD_PRIO_HIGH (draw units) runs with
+     * the priority of the LVGL task, which only waits while the draw units render. */
+    const int priority = (int)uxTaskPriorityGet(NULL) + (int)prio - (int)LV_THREAD_PRIO_HIGH;
+    if (priority < 1) {
+        return 1;
+    }
+    if (priority > configMAX_PRIORITIES - 1) {
+        return configMAX_PRIORITIES - 1;
+    }
+    return (UBaseType_t)priority;
+}
+
+#endif /* LV_USE_OS == LV_OS_CUSTOM */
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_lvgl_port_simd.h"
+
+/* Source block read for one destination row segment. 16 rows of 16 RGB565 pixels are 16 cache lines,
+ * they stay cached while the 16 destination rows of the tile are written. */
+#define LVGL_PORT_ROTATE_TILE   16
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline __attribute__((always_inline)) uint16_t rgb565_px(uint16_t px, const bool swap)
+{
+    return swap ? (uint16_t)((px >> 8) | (px << 8)) : px;
+}
+
+/* dst[i] = src[i * src_step], with 32-bit stores when dst allows it */
+static inline __attribute__((always_inline)) void rotate_segment(const uint16_t *src, int32_t src_step, uint16_t *dst, int32_t len, const bool swap)
+{
+    if (len > 0 && ((uintptr_t)dst & 2)) {
+        *dst++ = rgb565_px(*src, swap);
+        src += src_step;
+        len--;
+    }
+
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (; len >= 2; len -= 2) {
+        const uint32_t lo = rgb565_px(src[0], swap);
+        const uint32_t hi = rgb565_px(src[src_step], swap);
+        *dst32++ = lo | (hi << 16);
+        src += 2 * src_step;
+    }
+
+    if (len) {
+        *(uint16_t *)dst32 = rgb565_px(*src, swap);
+    }
+}
+
+/* 90 degrees: dst[(w - 1 - x) * dst_stride + y] = src[y * src_stride + x] */
+static inline __attribute__((always_inline)) void rotate90(const uint16_t *src, uint16_t *dst, int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, const bool swap)
+{
+    for (int32_t ty = 0; ty < h; ty += LVGL_PORT_ROTATE_TILE) {
+        const int32_t th = (h - ty < LVGL_PORT_ROTATE_TILE) ? h - ty : LVGL_PORT_ROTATE_TILE;
+        for (int32_t tx = 0; tx < w; tx += LVGL_PORT_ROTATE_TILE) {
+            const int32_t tw = (w - tx < LVGL_PORT_ROTATE_TILE) ? w - tx : LVGL_PORT_ROTATE_TILE;
+            for (int32_t x = tx; x < tx + tw; x++) {
+                rotate_segment(src + ty * src_stride + x, src_stride, dst + (w - 1 - x) * dst_stride + ty, th, swap);
+            }
+        }
+    }
+}
+
+/* 270 degrees: dst[x * dst_stride + (h - 1 - y)] = src[y * src_stride + x] */
+static inline __attribute__((always_inline)) void rotate270(const uint16_t *src, uint16_t *dst, int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, const bool swap)
+{
+    for (int32_t ty = 0; ty < h; ty += LVGL_PORT_ROTATE_TILE) {
+        const int32_t th = (h - ty < LVGL_PORT_ROTATE_TILE) ? h - ty : LVGL_PORT_ROTATE_TILE;
+        for (int32_t tx = 0; tx < w; tx += LVGL_PORT_ROTATE_TILE) {
+            const int32_t tw = (w - tx < LVGL_PORT_ROTATE_TILE) ? w - tx : LVGL_PORT_ROTATE_TILE;
+            for (int32_t x = tx; x < tx + tw; x++) {
+                /* Walk the source column bottom up, so the destination row is written left to right */
+                rotate_segment(src + (ty + th - 1) * src_stride + x, -src_stride, dst + x * dst_stride + (h - ty - th), th, swap);
+            }
+        }
+    }
+}
+
+/* 180 degrees: dst[(h - 1 - y) * dst_stride + (w - 1 - x)] = src[y * src_stride + x], rows are already cache friendly */
+static inline __attribute__((always_inline)) void rotate180(const uint16_t *src, uint16_t *dst, int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, const bool swap)
+{
+    for (int32_t y = 0; y < h; y++) {
+        rotate_segment(src + y * src_stride + w - 1, -1, dst + (h - 1 - y) * dst_stride, w, swap);
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_rotate90_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes)
+{
+    src_stride /= sizeof(uint16_t);
+    dst_stride /= sizeof(uint16_t);
+    if (swap_bytes) {
+        rotate90(src, dst, src_w, src_h, src_stride, dst_stride, true);
+    } else {
+        rotate90(src, dst, src_w, src_h, src_stride, dst_stride, false);
+    }
+}
+
+void lvgl_port_rotate180_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes)
+{
+    src_stride /= sizeof(uint16_t);
+    dst_stride /= sizeof(uint16_t);
+    if (swap_bytes) {
+        rotate180(src, dst, src_w, src_h, src_stride, dst_stride, true);
+    } else {
+        rotate180(src, dst, src_w, src_h, src_stride, dst_stride, false);
+    }
+}
+
+void lvgl_port_rotate270_rgb565(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes)
+{
+    src_stride /= sizeof(uint16_t);
+    dst_stride /= sizeof(uint16_t);
+    if (swap_bytes) {
+        rotate270(src, dst, src_w, src_h, src_stride, dst_stride, true);
+    } else {
+        rotate270(src, dst, src_w, src_h, src_stride, dst_stride, false);
+    }
+}
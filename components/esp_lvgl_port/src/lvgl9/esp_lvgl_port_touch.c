@@ -9,6 +9,7 @@
 #include "esp_check.h"
 #include "esp_lcd_touch.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
 
 static const char *TAG = "LVGL";
 
@@ -19,6 +20,11 @@ static const char *TAG = "LVGL";
 typedef struct {
     esp_lcd_touch_handle_t  handle;     /* LCD touch IO handle */
     lv_indev_t              *indev;     /* LVGL input device driver */
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    esp_lcd_touch_service_handle_t service; /* Touch service, NULL when read in LVGL task */
+    lv_point_t              point;      /* Last point read from the touch service */
+    lv_indev_state_t        state;      /* Last state read from the touch service */
+#endif
 } lvgl_port_touch_ctx_t;
 
 /*******************************************************************************
@@ -27,6 +33,11 @@ typedef struct {
 
 static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
 static void lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t tp);
+static inline bool lvgl_port_touch_has_service(const lvgl_port_touch_ctx_t *touch_ctx);
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+static void lvgl_port_touch_service_read(lvgl_port_touch_ctx_t *touch_ctx, lv_indev_data_t *data);
+static void lvgl_port_touch_frame_callback(esp_lcd_touch_service_handle_t service, void *user_data);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -41,14 +52,26 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     assert(touch_cfg->handle != NULL);
 
     /* Touch context */
-    lvgl_port_touch_ctx_t *touch_ctx = malloc(sizeof(lvgl_port_touch_ctx_t));
+    lvgl_port_touch_ctx_t *touch_ctx = calloc(1, sizeof(lvgl_port_touch_ctx_t));
     if (touch_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for touch context allocation!");
         return NULL;
     }
     touch_ctx->handle = touch_cfg->handle;
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_cfg->service != NULL) {
+        /* Touch service reads the touch and wakes LVGL task with new frames, it owns the touch interrupt */
+        esp_lcd_touch_service_config_t service_cfg = *touch_cfg->service;
+        service_cfg.frame_callback = lvgl_port_touch_frame_callback;
+        service_cfg.user_data = touch_ctx;
+        touch_ctx->state = LV_INDEV_STATE_RELEASED;
+        ret = esp_lcd_touch_service_create(touch_ctx->handle, &service_cfg, &touch_ctx->service);
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in create touch service.");
+    }
+#endif
+
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC && !lvgl_port_touch_has_service(touch_ctx)) {
         /* Register touch interrupt callback */
         ret = esp_lcd_touch_register_interrupt_callback_with_data(touch_ctx->handle, lvgl_port_touch_interrupt_callback, touch_ctx);
         ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in register touch interrupt.");
@@ -58,8 +81,8 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     /* Register a touchpad input device */
     indev = lv_indev_create();
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    /* Event mode can be set only, when touch interrupt enabled */
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+    /* Event mode can be set only, when touch interrupt enabled or the touch service publishes the frames */
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC || lvgl_port_touch_has_service(touch_ctx)) {
         lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
     }
     lv_indev_set_read_cb(indev, lvgl_port_touchpad_read);
@@ -88,7 +111,14 @@ esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
     lv_indev_delete(touch);
     lvgl_port_unlock();
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_ctx->service != NULL) {
+        /* Stops the service task and unregisters the touch interrupt */
+        esp_lcd_touch_service_del(touch_ctx->service);
+    }
+#endif
+
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC && !lvgl_port_touch_has_service(touch_ctx)) {
         /* Unregister touch interrupt callback */
         esp_lcd_touch_register_interrupt_callback(touch_ctx->handle, NULL);
     }
@@ -111,6 +141,13 @@ static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data
     assert(touch_ctx);
     assert(touch_ctx->handle);
 
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    if (touch_ctx->service != NULL) {
+        lvgl_port_touch_service_read(touch_ctx, data);
+        return;
+    }
+#endif
+
     uint16_t touchpad_x[1] = {0};
     uint16_t touchpad_y[1] = {0};
     uint8_t touchpad_cnt = 0;
@@ -137,3 +174,45 @@ static void IRAM_ATTR lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
 }
+
+static inline bool lvgl_port_touch_has_service(const lvgl_port_touch_ctx_t *touch_ctx)
+{
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+    return (touch_ctx->service != NULL);
+#else
+    return false;
+#endif
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_SERVICE
+static void lvgl_port_touch_service_read(lvgl_port_touch_ctx_t *touch_ctx, lv_indev_data_t *data)
+{
+    esp_lcd_touch_frame_t frame;
+
+    /* One frame per read, LVGL reads again while there are more. LVGL pointer uses the first point only. */
+    if (esp_lcd_touch_service_read_frame(touch_ctx->service, &frame)) {
+        if (frame.points > 0) {
+            touch_ctx->point.x = frame.coords[0].x;
+            touch_ctx->point.y = frame.coords[0].y;
+            touch_ctx->state = LV_INDEV_STATE_PRESSED;
+        } else {
+            touch_ctx->state = LV_INDEV_STATE_RELEASED;
+        }
+        if (esp_lcd_touch_service_has_frame(touch_ctx->service)) {
+            lvgl_port_indev_continue_reading(data);
+        }
+    }
+
+    /* No new frame, the point stays */
+    data->point = touch_ctx->point;
+    data->state = touch_ctx->state;
+}
+
+static void lvgl_port_touch_frame_callback(esp_lcd_touch_service_handle_t service, void *user_data)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *) user_data;
+
+    /* Wake LVGL task, if needed */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
+}
+#endif
@@ -5,6 +5,9 @@
  */
 
 
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_check.h"
@@ -180,17 +183,10 @@ static esp_err_t app_touch_deinit(void)
     return ESP_OK;
 }
 
-static esp_err_t app_lvgl_init(void)
+static esp_err_t app_lvgl_init(const lvgl_port_cfg_t *lvgl_cfg)
 {
     /* Initialize LVGL */
-    const lvgl_port_cfg_t lvgl_cfg = {
-        .task_priority = 4,         /* LVGL task priority */
-        .task_stack = 4096,         /* LVGL task stack size */
-        .task_affinity = -1,        /* LVGL task pinned to core (-1 is no affinity) */
-        .task_max_sleep_ms = 500,   /* Maximum sleep in LVGL task */
-        .timer_period_ms = 5        /* LVGL timer tick period in ms */
-    };
-    ESP_RETURN_ON_ERROR(lvgl_port_init(&lvgl_cfg), TAG, "LVGL port initialization failed");
+    ESP_RETURN_ON_ERROR(lvgl_port_init(lvgl_cfg), TAG, "LVGL port initialization failed");
 
     /* Add LCD screen */
     ESP_LOGD(TAG, "Add LCD screen");
@@ -292,7 +288,7 @@ static void check_leak(size_t start_free, size_t end_free, const char *type)
     TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE (delta, TEST_MEMORY_LEAK_THRESHOLD, "memory leak");
 }
 
-TEST_CASE("Main test LVGL port", "[lvgl port]")
+static void test_lvgl_port(const lvgl_port_cfg_t *lvgl_cfg)
 {
     size_t start_freemem_8bit = heap_caps_get_free_size(MALLOC_CAP_8BIT);
     size_t start_freemem_32bit = heap_caps_get_free_size(MALLOC_CAP_32BIT);
@@ -311,13 +307,21 @@ TEST_CASE("Main test LVGL port", "[lvgl port]")
     ESP_LOGI(TAG, "Initilize LVGL.");
 
     /* LVGL initialization */
-    TEST_ASSERT_EQUAL(app_lvgl_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(lvgl_cfg), ESP_OK);
 
     /* Show LVGL objects */
     app_main_display();
 
     vTaskDelay(5000 / portTICK_PERIOD_MS);
 
+#if LVGL_VERSION_MAJOR >= 9
+    lvgl_port_frame_stats_t stats;
+    TEST_ASSERT_EQUAL(lvgl_port_get_frame_stats(&stats), ESP_OK);
+    ESP_LOGI(TAG, "%"PRIu32" frames, %"PRIu32" dropped, render %"PRIu32" us (max %"PRIu32" us), flush %"PRIu32" us (max %"PRIu32" us)",
+             stats.frames, stats.dropped_frames, stats.render_time_us, stats.render_time_max_us, stats.flush_time_us, stats.flush_time_max_us);
+    TEST_ASSERT_GREATER_THAN(0, stats.frames);
+#endif
+
     /* LVGL deinit */
     TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
 
@@ -345,9 +349,164 @@ TEST_CASE("Main test LVGL port", "[lvgl port]")
     size_t end_freemem_32bit = heap_caps_get_free_size(MALLOC_CAP_32BIT);
     check_leak(start_freemem_8bit, end_freemem_8bit, "8BIT");
     check_leak(start_freemem_32bit, end_freemem_32bit, "32BIT");
+}
+
+TEST_CASE("Main test LVGL port", "[lvgl port]")
+{
+    const lvgl_port_cfg_t lvgl_cfg = {
+        .task_priority = 4,         /* LVGL task priority */
+        .task_stack = 4096,         /* LVGL task stack size */
+        .task_affinity = -1,        /* LVGL task pinned to core (-1 is no affinity) */
+        .task_max_sleep_ms = 500,   /* Maximum sleep in LVGL task */
+        .timer_period_ms = 5        /* LVGL timer tick period in ms */
+    };
+    test_lvgl_port(&lvgl_cfg);
+}
+
+#if LVGL_VERSION_MAJOR >= 9
+TEST_CASE("Frame paced LVGL port", "[lvgl port]")
+{
+    const lvgl_port_cfg_t lvgl_cfg = {
+        .task_priority = 4,         /* LVGL task priority */
+        .task_stack = 4096,         /* LVGL task stack size */
+        .task_affinity = 0,         /* LVGL task pinned to core 0, flush task on the other one */
+        .task_max_sleep_ms = 500,   /* Maximum sleep in LVGL task */
+        .timer_period_ms = 5,       /* LVGL timer tick period in ms */
+        .task_pacing = LVGL_PORT_TASK_PACING_PERIOD,
+        .frame_period_ms = 16,      /* ~60 FPS */
+        .flags = {
+            .flush_task = true,
+        }
+    };
+    test_lvgl_port(&lvgl_cfg);
+}
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+#define TEST_BENCHMARK_FRAMES       (60)
+#define TEST_BENCHMARK_FRAME_WAIT   (1000)  /* Ticks for one frame */
+
+/* Gradients, shadows, rounded corners and opacity over the whole screen, LVGL splits them into many draw tasks */
+static void app_benchmark_scene(void)
+{
+    lv_obj_t *scr = lv_scr_act();
+
+    /* Task lock */
+    lvgl_port_lock(0);
+
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x202040), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x4060C0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    for (int i = 0; i < 12; i++) {
+        lv_obj_t *obj = lv_obj_create(scr);
+        lv_obj_set_size(obj, 64, 56);
+        lv_obj_set_pos(obj, 16 + (i % 4) * 76, 16 + (i / 4) * 76);
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_style_radius(obj, 12, 0);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_80, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main((lv_palette_t)(i % LV_PALETTE_LAST)), 0);
+        lv_obj_set_style_bg_grad_color(obj, lv_palette_darken((lv_palette_t)(i % LV_PALETTE_LAST), 3), 0);
+        lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+        lv_obj_set_style_shadow_width(obj, 16, 0);
+        lv_obj_set_style_shadow_opa(obj, LV_OPA_50, 0);
+
+        lv_obj_t *label = lv_label_create(obj);
+        lv_label_set_text_fmt(label, LV_SYMBOL_IMAGE" %d", i);
+        lv_obj_center(label);
+    }
+
+    /* Task unlock */
+    lvgl_port_unlock();
+}
+
+/* CPU time of the draw unit tasks, each one counts while it renders on its own core */
+static uint64_t app_draw_units_run_time(void)
+{
+    uint64_t run_time = 0;
+#if LV_USE_OS == LV_OS_CUSTOM && configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    const UBaseType_t task_count = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t *tasks = malloc(task_count * sizeof(TaskStatus_t));
+    TEST_ASSERT_NOT_NULL(tasks);
+
+    const UBaseType_t count = uxTaskGetSystemState(tasks, task_count, NULL);
+    for (UBaseType_t i = 0; i < count; i++) {
+        if (strcmp(tasks[i].pcTaskName, "taskLVGLdraw") == 0) {
+            run_time += tasks[i].ulRunTimeCounter;
+        }
+    }
+    free(tasks);
+#endif
+    return run_time;
+}
+
+/*
+Draw units benchmark
+
+Purpose:
+    - Report the render time of the same scene with LV_DRAW_SW_DRAW_UNIT_CNT draw units
+      (sdkconfig.ci.draw_units: two units on the esp_lvgl_port OSAL, pinned to separate cores)
+    - The speed-up is the ratio of the render times of a build with sdkconfig.ci.draw_units and one without,
+      the unit count is fixed at build time
+
+Procedure:
+    - Invalidate the whole benchmark scene, wait for the frame and sum the render times from the frame statistics
+    - Sum the CPU time of the draw unit tasks over the same frames
+    - Draw unit parallelism is the draw units CPU time over the render time, how many units were busy on average,
+      1.0 without LVGL OS (the LVGL task renders alone)
+*/
+TEST_CASE("LVGL draw units benchmark", "[lvgl port][benchmark]")
+{
+    const lvgl_port_cfg_t lvgl_cfg = {
+        .task_priority = 4,         /* LVGL task priority */
+        .task_stack = 6144,         /* LVGL task stack size */
+        .task_affinity = 0,         /* LVGL task pinned to core 0 */
+        .task_max_sleep_ms = 500,   /* Maximum sleep in LVGL task */
+        .timer_period_ms = 5        /* LVGL timer tick period in ms */
+    };
+    lvgl_port_frame_stats_t stats;
+    uint64_t render_time_us = 0;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(&lvgl_cfg), ESP_OK);
+
+    /* First frames fill the caches */
+    app_benchmark_scene();
+    vTaskDelay(500 / portTICK_PERIOD_MS);
 
+    const uint64_t draw_time_start_us = app_draw_units_run_time();
+    for (int i = 0; i < TEST_BENCHMARK_FRAMES; i++) {
+        TEST_ASSERT_EQUAL(lvgl_port_get_frame_stats(&stats), ESP_OK);
+        const uint32_t frames = stats.frames;
 
+        lvgl_port_lock(0);
+        lv_obj_invalidate(lv_scr_act());
+        lvgl_port_unlock();
+
+        for (int t = 0; t < TEST_BENCHMARK_FRAME_WAIT && stats.frames == frames; t++) {
+            vTaskDelay(1);
+            lvgl_port_get_frame_stats(&stats);
+        }
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(frames, stats.frames, "frame not rendered");
+        render_time_us += stats.render_time_us;
+    }
+    const uint64_t draw_time_us = app_draw_units_run_time() - draw_time_start_us;
+
+    ESP_LOGI(TAG, "%d draw unit(s), %d frames: render %"PRIu64" us per frame, max %"PRIu32" us",
+             LV_DRAW_SW_DRAW_UNIT_CNT, TEST_BENCHMARK_FRAMES, render_time_us / TEST_BENCHMARK_FRAMES, stats.render_time_max_us);
+    if (draw_time_us > 0) {
+        ESP_LOGI(TAG, "draw units busy %"PRIu64" us per frame, draw unit parallelism %.2f",
+                 draw_time_us / TEST_BENCHMARK_FRAMES, (double)draw_time_us / render_time_us);
+    } else {
+        ESP_LOGI(TAG, "rendered by the LVGL task, draw unit parallelism 1.00");
+    }
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
 }
+#endif
 
 void app_main(void)
 {
@@ -43,7 +43,7 @@ extern "C" {
  * Opacity percentages.
  */
 
-typedef enum {
+enum _lv_opa_t {
     LV_OPA_TRANSP = 0,
     LV_OPA_0      = 0,
     LV_OPA_10     = 25,
@@ -57,7 +57,9 @@ typedef enum {
     LV_OPA_90     = 229,
     LV_OPA_100    = 255,
     LV_OPA_COVER  = 255,
-} lv_opa_t;
+};
+
+typedef uint8_t lv_opa_t;    // Byte sized as in LVGL, an enum would be int sized
 
 #define LV_OPA_MIN 2    /*Opacities below this will be transparent*/
 #define LV_OPA_MAX 253  /*Opacities above this will fully cover*/
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This file is derived from the LVGL project.
+ * See https://github.com/lvgl/lvgl for details.
+ */
+
+/**
+ * @file lv_draw_sw_rotate_rgb565.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_ROTATE_RGB565_H
+#define LV_DRAW_SW_ROTATE_RGB565_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/* RGB565 part of lv_draw_sw_rotate(), rotation is 1 - 3 like lv_display_rotation_t, strides in bytes */
+void lv_draw_sw_rotate_rgb565(const void *src, void *dest, int32_t src_width, int32_t src_height, int32_t src_stride,
+                              int32_t dest_stride, int rotation);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_ROTATE_RGB565_H*/
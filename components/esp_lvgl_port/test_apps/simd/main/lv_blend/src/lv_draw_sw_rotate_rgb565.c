@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This file is derived from the LVGL project.
+ * See https://github.com/lvgl/lvgl for details.
+ */
+
+/**
+ * @file lv_draw_sw_rotate_rgb565.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_rotate_rgb565.h"
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void rotate90_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_width, int32_t src_height,
+                            int32_t src_stride,
+                            int32_t dst_stride);
+static void rotate180_rgb565(const uint16_t *src, uint16_t *dst, int32_t width, int32_t height, int32_t src_stride,
+                             int32_t dest_stride);
+static void rotate270_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride,
+                             int32_t dst_stride);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_rotate_rgb565(const void *src, void *dest, int32_t src_width, int32_t src_height, int32_t src_stride,
+                              int32_t dest_stride, int rotation)
+{
+    if (rotation == 1) {
+        rotate90_rgb565(src, dest, src_width, src_height, src_stride, dest_stride);
+    } else if (rotation == 2) {
+        rotate180_rgb565(src, dest, src_width, src_height, src_stride, dest_stride);
+    } else if (rotation == 3) {
+        rotate270_rgb565(src, dest, src_width, src_height, src_stride, dest_stride);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void rotate270_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_width, int32_t src_height,
+                             int32_t src_stride,
+                             int32_t dst_stride)
+{
+    src_stride /= sizeof(uint16_t);
+    dst_stride /= sizeof(uint16_t);
+
+    for (int32_t x = 0; x < src_width; ++x) {
+        int32_t dstIndex = x * dst_stride;
+        int32_t srcIndex = x;
+        for (int32_t y = 0; y < src_height; ++y) {
+            dst[dstIndex + (src_height - y - 1)] = src[srcIndex];
+            srcIndex += src_stride;
+        }
+    }
+}
+
+static void rotate180_rgb565(const uint16_t *src, uint16_t *dst, int32_t width, int32_t height, int32_t src_stride,
+                             int32_t dest_stride)
+{
+    src_stride /= sizeof(uint16_t);
+    dest_stride /= sizeof(uint16_t);
+
+    for (int32_t y = 0; y < height; ++y) {
+        int32_t dstIndex = (height - y - 1) * dest_stride;
+        int32_t srcIndex = y * src_stride;
+        for (int32_t x = 0; x < width; ++x) {
+            dst[dstIndex + width - x - 1] = src[srcIndex + x];
+        }
+    }
+}
+
+static void rotate90_rgb565(const uint16_t *src, uint16_t *dst, int32_t src_width, int32_t src_height,
+                            int32_t src_stride,
+                            int32_t dst_stride)
+{
+    src_stride /= sizeof(uint16_t);
+    dst_stride /= sizeof(uint16_t);
+
+    for (int32_t x = 0; x < src_width; ++x) {
+        int32_t dstIndex = (src_width - x - 1);
+        int32_t srcIndex = x;
+        for (int32_t y = 0; y < src_height; ++y) {
+            dst[dstIndex * dst_stride + y] = src[srcIndex];
+            srcIndex += src_stride;
+        }
+    }
+}
@@ -0,0 +1,304 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Seeded fuzz cases for the lv_blend reference functions, shared by the target test app
+// and the host harness (host/blend_fuzz.c at the top of the repository), so both produce the same buffers from the same seed
+
+#include <string.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include "lv_blend_fuzz.h"
+#include "lv_draw_sw_blend_to_rgb565.h"
+#include "lv_draw_sw_blend_to_rgb888.h"
+#include "lv_draw_sw_blend_to_argb8888.h"
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Hash the sequence seed and the case index into the case seed, never 0
+ */
+static uint32_t case_seed(uint32_t seed, uint32_t index);
+
+/**
+ * @brief xorshift32 step
+ */
+static uint32_t rand_next(uint32_t *state);
+
+/**
+ * @brief Opacity byte, biased towards the values the kernels branch on
+ */
+static lv_opa_t rand_opa(uint32_t *state);
+
+/**
+ * @brief Mask or alpha byte, a quarter transparent, a quarter opaque
+ */
+static uint8_t rand_mask_byte(uint32_t *state);
+
+/**
+ * @brief Natural alignment of a pixel type, RGB888 and fills without source have none
+ */
+static uint32_t px_align(uint32_t px_size);
+
+// ------------------------------------------------ Functions ----------------------------------------------------------
+
+void lv_blend_fuzz_case_init(uint32_t seed, uint32_t index, lv_blend_fuzz_case_t *fuzz_case)
+{
+    uint32_t state = case_seed(seed, index);
+    memset(fuzz_case, 0, sizeof(*fuzz_case));
+
+    fuzz_case->seed = state;
+    fuzz_case->op = rand_next(&state) % LV_BLEND_FUZZ_OP_COUNT;
+
+    const uint32_t dest_px_size = lv_blend_fuzz_dest_px_size(fuzz_case->op);
+    const uint32_t src_px_size = lv_blend_fuzz_src_px_size(fuzz_case->op);
+
+    // A quarter of the cases is narrower than the unrolled main loops
+    const uint32_t max_w = (rand_next(&state) % 4 == 0) ? 8 : LV_BLEND_FUZZ_MAX_W;
+    fuzz_case->dest_w = 1 + rand_next(&state) % max_w;
+    fuzz_case->dest_h = 1 + rand_next(&state) % LV_BLEND_FUZZ_MAX_H;
+    fuzz_case->dest_stride = (fuzz_case->dest_w + rand_next(&state) % (LV_BLEND_FUZZ_MAX_PADDING + 1)) * dest_px_size;
+    if (src_px_size) {
+        fuzz_case->src_stride = (fuzz_case->dest_w + rand_next(&state) % (LV_BLEND_FUZZ_MAX_PADDING + 1)) * src_px_size;
+    }
+    fuzz_case->use_mask = rand_next(&state) & 1;
+    if (fuzz_case->use_mask) {
+        fuzz_case->mask_stride = fuzz_case->dest_w + rand_next(&state) % (LV_BLEND_FUZZ_MAX_PADDING + 1);
+    }
+
+    // LVGL never hands out buffers below the pixel alignment, the kernels may rely on it
+    fuzz_case->dest_unalign_byte = (rand_next(&state) % (LV_BLEND_FUZZ_MAX_UNALIGN + 1)) & ~(px_align(dest_px_size) - 1);
+    fuzz_case->src_unalign_byte = (rand_next(&state) % (LV_BLEND_FUZZ_MAX_UNALIGN + 1)) & ~(px_align(src_px_size) - 1);
+
+    fuzz_case->opa = rand_opa(&state);
+    fuzz_case->color.red = rand_mask_byte(&state);
+    fuzz_case->color.green = rand_mask_byte(&state);
+    fuzz_case->color.blue = rand_mask_byte(&state);
+}
+
+bool lv_blend_fuzz_run(const lv_blend_fuzz_case_t *fuzz_case, bool use_asm, lv_blend_fuzz_result_t *result)
+{
+    const lv_blend_fuzz_op_t op = fuzz_case->op;
+    const size_t dest_len = fuzz_case->dest_h * fuzz_case->dest_stride + LV_BLEND_FUZZ_CANARY_BYTES * 2;
+    const size_t src_len = fuzz_case->dest_h * fuzz_case->src_stride;
+    const size_t mask_len = fuzz_case->dest_h * fuzz_case->mask_stride;
+    uint32_t state = fuzz_case->seed ^ 0x5EED5EED;
+
+    uint8_t *dest_mem = memalign(16, dest_len + fuzz_case->dest_unalign_byte);
+    uint8_t *src_mem = memalign(16, src_len + fuzz_case->src_unalign_byte + 1);
+    uint8_t *mask_mem = memalign(16, mask_len + fuzz_case->src_unalign_byte + 1);
+    if (!dest_mem || !src_mem || !mask_mem) {
+        free(dest_mem);
+        free(src_mem);
+        free(mask_mem);
+        return false;
+    }
+
+    uint8_t *dest = dest_mem + fuzz_case->dest_unalign_byte;
+    uint8_t *src = src_mem + fuzz_case->src_unalign_byte;
+    lv_opa_t *mask = mask_mem + fuzz_case->src_unalign_byte;
+
+    // Canary bytes around, the stride padding is random like the drawn pixels and must stay untouched as well
+    memset(dest, LV_BLEND_FUZZ_CANARY_VALUE, dest_len);
+    for (size_t i = LV_BLEND_FUZZ_CANARY_BYTES; i < dest_len - LV_BLEND_FUZZ_CANARY_BYTES; i++) {
+        dest[i] = rand_next(&state);
+    }
+    for (size_t i = 0; i < src_len; i++) {
+        src[i] = rand_next(&state);
+    }
+    if (op == LV_BLEND_FUZZ_IMAGE_ARGB8888_TO_RGB565) {
+        for (size_t i = 3; i < src_len; i += 4) {
+            src[i] = rand_mask_byte(&state);
+        }
+    }
+    for (size_t i = 0; i < mask_len; i++) {
+        mask[i] = rand_mask_byte(&state);
+    }
+
+    _lv_draw_sw_blend_fill_dsc_t fill_dsc = {
+        .dest_buf = dest + LV_BLEND_FUZZ_CANARY_BYTES,
+        .dest_w = fuzz_case->dest_w,
+        .dest_h = fuzz_case->dest_h,
+        .dest_stride = fuzz_case->dest_stride,
+        .mask_buf = fuzz_case->use_mask ? mask : NULL,
+        .mask_stride = fuzz_case->mask_stride,
+        .color = fuzz_case->color,
+        .opa = fuzz_case->opa,
+        .use_asm = use_asm,
+    };
+    _lv_draw_sw_blend_image_dsc_t image_dsc = {
+        .dest_buf = fill_dsc.dest_buf,
+        .dest_w = fuzz_case->dest_w,
+        .dest_h = fuzz_case->dest_h,
+        .dest_stride = fuzz_case->dest_stride,
+        .mask_buf = fill_dsc.mask_buf,
+        .mask_stride = fuzz_case->mask_stride,
+        .src_buf = src,
+        .src_stride = fuzz_case->src_stride,
+        .opa = fuzz_case->opa,
+        .blend_mode = LV_BLEND_MODE_NORMAL,
+        .use_asm = use_asm,
+    };
+    lv_blend_fuzz_call(op, &fill_dsc, &image_dsc);
+
+    result->crc = lv_blend_fuzz_crc32(0, dest, dest_len);
+    result->canary_ok = true;
+    for (size_t i = 0; i < LV_BLEND_FUZZ_CANARY_BYTES; i++) {
+        if (dest[i] != LV_BLEND_FUZZ_CANARY_VALUE || dest[dest_len - 1 - i] != LV_BLEND_FUZZ_CANARY_VALUE) {
+            result->canary_ok = false;
+        }
+    }
+
+    free(dest_mem);
+    free(src_mem);
+    free(mask_mem);
+    return true;
+}
+
+void lv_blend_fuzz_call(lv_blend_fuzz_op_t op, _lv_draw_sw_blend_fill_dsc_t *fill_dsc, _lv_draw_sw_blend_image_dsc_t *image_dsc)
+{
+    switch (op) {
+    case LV_BLEND_FUZZ_FILL_RGB565:
+        lv_draw_sw_blend_color_to_rgb565(fill_dsc);
+        break;
+    case LV_BLEND_FUZZ_FILL_RGB888:
+        lv_draw_sw_blend_color_to_rgb888(fill_dsc, 3);
+        break;
+    case LV_BLEND_FUZZ_FILL_ARGB8888:
+        lv_draw_sw_blend_color_to_argb8888(fill_dsc);
+        break;
+    case LV_BLEND_FUZZ_IMAGE_RGB565_TO_RGB565:
+        image_dsc->src_color_format = LV_COLOR_FORMAT_RGB565;
+        lv_draw_sw_blend_image_to_rgb565(image_dsc);
+        break;
+    case LV_BLEND_FUZZ_IMAGE_RGB888_TO_RGB565:
+        image_dsc->src_color_format = LV_COLOR_FORMAT_RGB888;
+        lv_draw_sw_blend_image_to_rgb565(image_dsc);
+        break;
+    case LV_BLEND_FUZZ_IMAGE_ARGB8888_TO_RGB565:
+        image_dsc->src_color_format = LV_COLOR_FORMAT_ARGB8888;
+        lv_draw_sw_blend_image_to_rgb565(image_dsc);
+        break;
+    default:
+        break;
+    }
+}
+
+const char *lv_blend_fuzz_op_name(lv_blend_fuzz_op_t op)
+{
+    static const char *names[LV_BLEND_FUZZ_OP_COUNT] = {
+        [LV_BLEND_FUZZ_FILL_RGB565] = "fill_rgb565",
+        [LV_BLEND_FUZZ_FILL_RGB888] = "fill_rgb888",
+        [LV_BLEND_FUZZ_FILL_ARGB8888] = "fill_argb8888",
+        [LV_BLEND_FUZZ_IMAGE_RGB565_TO_RGB565] = "rgb565_to_rgb565",
+        [LV_BLEND_FUZZ_IMAGE_RGB888_TO_RGB565] = "rgb888_to_rgb565",
+        [LV_BLEND_FUZZ_IMAGE_ARGB8888_TO_RGB565] = "argb8888_to_rgb565",
+    };
+    return (op < LV_BLEND_FUZZ_OP_COUNT) ? names[op] : "unknown";
+}
+
+uint32_t lv_blend_fuzz_dest_px_size(lv_blend_fuzz_op_t op)
+{
+    switch (op) {
+    case LV_BLEND_FUZZ_FILL_RGB888:
+        return 3;
+    case LV_BLEND_FUZZ_FILL_ARGB8888:
+        return 4;
+    default:
+        return 2;
+    }
+}
+
+uint32_t lv_blend_fuzz_src_px_size(lv_blend_fuzz_op_t op)
+{
+    switch (op) {
+    case LV_BLEND_FUZZ_IMAGE_RGB565_TO_RGB565:
+        return 2;
+    case LV_BLEND_FUZZ_IMAGE_RGB888_TO_RGB565:
+        return 3;
+    case LV_BLEND_FUZZ_IMAGE_ARGB8888_TO_RGB565:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t lv_blend_fuzz_crc32(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// ------------------------------------------------ Static functions ---------------------------------------------------
+
+static uint32_t case_seed(uint32_t seed, uint32_t index)
+{
+    uint32_t x = seed ^ (index * 0x9E3779B9);
+
+    x ^= x >> 16;
+    x *= 0x7FEB352D;
+    x ^= x >> 15;
+    x *= 0x846CA68B;
+    x ^= x >> 16;
+    return x ? x : 1;
+}
+
+static uint32_t rand_next(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static lv_opa_t rand_opa(uint32_t *state)
+{
+    const uint32_t r = rand_next(state);
+
+    switch (r % 8) {
+    case 0:
+    case 1:
+    case 2:
+        return LV_OPA_COVER;
+    case 3:
+        return LV_OPA_TRANSP;
+    case 4:
+        return LV_OPA_MAX;
+    case 5:
+        return LV_OPA_MAX - 1;
+    default:
+        return (r >> 8) & 0xFF;
+    }
+}
+
+static uint8_t rand_mask_byte(uint32_t *state)
+{
+    const uint32_t r = rand_next(state);
+
+    switch (r % 4) {
+    case 0:
+        return LV_OPA_TRANSP;
+    case 1:
+        return LV_OPA_COVER;
+    default:
+        return (r >> 8) & 0xFF;
+    }
+}
+
+static uint32_t px_align(uint32_t px_size)
+{
+    return (px_size == 2 || px_size == 4) ? px_size : 1;
+}
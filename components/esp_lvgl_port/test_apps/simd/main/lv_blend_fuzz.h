@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lv_color.h"
+#include "lv_draw_sw_blend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Canary bytes on both sides of the fuzzed destination buffer
+ * @note 16 bytes, to also catch the 16-byte wide Q register stores of esp32s3
+ */
+#define LV_BLEND_FUZZ_CANARY_BYTES  16
+#define LV_BLEND_FUZZ_CANARY_VALUE  0xA5
+
+/**
+ * @brief Limits of the fuzzed geometry
+ */
+#define LV_BLEND_FUZZ_MAX_W         48          // Covers the main and tail loops of all the kernels
+#define LV_BLEND_FUZZ_MAX_H         4
+#define LV_BLEND_FUZZ_MAX_PADDING   5           // Row padding in pixels
+#define LV_BLEND_FUZZ_MAX_UNALIGN   15          // Bytes, rounded down to the natural alignment of the pixel type
+
+/**
+ * @brief Fuzzed blend API entry, each selects one of the lv_blend reference functions
+ */
+typedef enum {
+    LV_BLEND_FUZZ_FILL_RGB565,                  /*!< lv_draw_sw_blend_color_to_rgb565() */
+    LV_BLEND_FUZZ_FILL_RGB888,                  /*!< lv_draw_sw_blend_color_to_rgb888(), 3-byte destination */
+    LV_BLEND_FUZZ_FILL_ARGB8888,                /*!< lv_draw_sw_blend_color_to_argb8888() */
+    LV_BLEND_FUZZ_IMAGE_RGB565_TO_RGB565,       /*!< lv_draw_sw_blend_image_to_rgb565(), RGB565 source */
+    LV_BLEND_FUZZ_IMAGE_RGB888_TO_RGB565,       /*!< lv_draw_sw_blend_image_to_rgb565(), RGB888 source */
+    LV_BLEND_FUZZ_IMAGE_ARGB8888_TO_RGB565,     /*!< lv_draw_sw_blend_image_to_rgb565(), ARGB8888 source */
+    LV_BLEND_FUZZ_OP_COUNT,
+} lv_blend_fuzz_op_t;
+
+/**
+ * @brief One fuzz case, fully derived from its seed by lv_blend_fuzz_case_init()
+ */
+typedef struct {
+    uint32_t seed;                              /*!< Seed of the case, also seeds the buffer contents */
+    lv_blend_fuzz_op_t op;                      /*!< Blend API entry */
+    int32_t dest_w;                             /*!< Destination width in pixels */
+    int32_t dest_h;                             /*!< Destination height in pixels */
+    int32_t dest_stride;                        /*!< Destination stride in bytes */
+    int32_t src_stride;                         /*!< Source stride in bytes, 0 for fills */
+    int32_t mask_stride;                        /*!< Mask stride in bytes, 0 without mask */
+    uint32_t dest_unalign_byte;                 /*!< Destination buffer memory unalignment */
+    uint32_t src_unalign_byte;                  /*!< Source and mask buffers memory unalignment */
+    lv_color_t color;                           /*!< Fill color */
+    lv_opa_t opa;                               /*!< Global opacity */
+    bool use_mask;                              /*!< Blend through a mask buffer */
+} lv_blend_fuzz_case_t;
+
+/**
+ * @brief Result of one fuzz case run
+ */
+typedef struct {
+    uint32_t crc;                               /*!< CRC-32 of the destination buffer, the Canary bytes included */
+    bool canary_ok;                             /*!< Canary bytes on both sides are intact */
+} lv_blend_fuzz_result_t;
+
+// ------------------------------------------------- Functions ---------------------------------------------------------
+
+/**
+ * @brief Derive case number `index` of the sequence started by `seed`
+ *
+ * Same seed and index give the same case on the host and on the target.
+ * Opacity, mask, alpha and color bytes favour 0, 255 and LV_OPA_MAX, the values the kernels branch on.
+ *
+ * @param[in] seed Seed of the whole sequence
+ * @param[in] index Case index
+ * @param[out] fuzz_case Generated case
+ */
+void lv_blend_fuzz_case_init(uint32_t seed, uint32_t index, lv_blend_fuzz_case_t *fuzz_case);
+
+/**
+ * @brief Allocate and fill the buffers of a case, run the blend and free the buffers
+ *
+ * @param[in] fuzz_case Case to run
+ * @param[in] use_asm Run the assembly hooks (target only), or the ANSI reference
+ * @param[out] result CRC of the destination and the Canary check
+ * @return false if the buffers could not be allocated
+ */
+bool lv_blend_fuzz_run(const lv_blend_fuzz_case_t *fuzz_case, bool use_asm, lv_blend_fuzz_result_t *result);
+
+/**
+ * @brief Name of a blend API entry, for the logs
+ */
+const char *lv_blend_fuzz_op_name(lv_blend_fuzz_op_t op);
+
+/**
+ * @brief Destination pixel size of a blend API entry in bytes
+ */
+uint32_t lv_blend_fuzz_dest_px_size(lv_blend_fuzz_op_t op);
+
+/**
+ * @brief Source pixel size of a blend API entry in bytes, 0 for fills
+ */
+uint32_t lv_blend_fuzz_src_px_size(lv_blend_fuzz_op_t op);
+
+/**
+ * @brief Run a blend API entry on prepared descriptors
+ *
+ * Used by the fuzz runs and by the host benchmark, fills use `fill_dsc`, images `image_dsc`.
+ */
+void lv_blend_fuzz_call(lv_blend_fuzz_op_t op, _lv_draw_sw_blend_fill_dsc_t *fill_dsc, _lv_draw_sw_blend_image_dsc_t *image_dsc);
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected), continues from `crc`, start with 0
+ */
+uint32_t lv_blend_fuzz_crc32(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Generated by host/blend_fuzz --write, do not edit
+// CRC-32 of the destination buffers (Canary bytes included) of the lv_blend ANSI reference,
+// for cases 0 .. LV_BLEND_GOLDEN_CASES - 1 of lv_blend_fuzz_case_init(LV_BLEND_GOLDEN_SEED, index)
+
+#pragma once
+
+#include <stdint.h>
+
+#define LV_BLEND_GOLDEN_SEED    0x4C56424CU
+#define LV_BLEND_GOLDEN_CASES   1024
+
+static const uint32_t lv_blend_golden_crc[LV_BLEND_GOLDEN_CASES] = {
+    0xDEF372C2, 0x8E39550F, 0xF35BDE1E, 0xBC5FD93D, 0x0957C353, 0xEB253453, 0x46AE9BFC, 0xF22CBCE1,
+    0xCC878B27, 0xA9C9C67F, 0xDF2C5A25, 0xA2B33F42, 0xB585F887, 0x64675D54, 0x1E4354F1, 0xA7AF21AD,
+    0x83DD6449, 0xBB64A4F0, 0x9CC3A869, 0xDF8ED7CE, 0x506239F4, 0x877E493E, 0x27027125, 0xECE951AB,
+    0x247BF2C6, 0x4DC60549, 0xB47754A1, 0xCCCAB55C, 0xFE50AF28, 0xFCC2BE08, 0xABF5892C, 0x5839945E,
+    0x067CB5C7, 0x105FADC6, 0x6D5A31F4, 0xF415020A, 0x2BF2E813, 0x2D968A89, 0x2A98DD71, 0xF0457CC6,
+    0xA1A80FB5, 0xFF63DC7A, 0x55A1B308, 0xFFF351AC, 0xB1AFF6E5, 0x46435762, 0xFDAD22B1, 0x1ABD3536,
+    0xB397C12E, 0x0CD7A72E, 0xF45BA447, 0x4B69AA63, 0xB28891EA, 0x4EE1D02B, 0x0C8CB89C, 0x617C6F02,
+    0x412AB775, 0x52B0097C, 0x2D79B9E5, 0x8967BB06, 0xBC94C967, 0xC109D48D, 0xF099F4CB, 0x9A29364A,
+    0x245C011A, 0xFBC86A4E, 0xC0C8C9C3, 0x26F64052, 0x3A8434B5, 0x26A3272B, 0x60B4012C, 0x2651B544,
+    0xEE61CCF4, 0x64F35920, 0x145B5FD6, 0x91E3AE04, 0xB80F3B5A, 0x5C527A46, 0xB8489DC9, 0x5F529056,
+    0x966214FB, 0x42700A7F, 0x981EB2EA, 0xC9508389, 0x031ADE7E, 0x2E68147C, 0x61C1BCA9, 0x7A0CC587,
+    0xF71588C2, 0x3B25CC3D, 0x7A6C1F9F, 0x08F910FC, 0x1694E38D, 0xA8BCB30D, 0xC86CDE1F, 0x82EF43A2,
+    0x32072A88, 0x59C953D4, 0xB32FA515, 0x9F31919E, 0x3B6F34E8, 0x2A03E461, 0x254CCD8B, 0x78D9FB98,
+    0xCA9FA7ED, 0x8D5994E1, 0x7D0DAEEF, 0x70371F91, 0x64AFF3DC, 0x38331031, 0x48EB6ABE, 0xC8070266,
+    0x9DD22FBC, 0x866F79CE, 0xB9F62DC7, 0x7A65245E, 0x04F3704F, 0xE205B2D4, 0xD8D0A55F, 0x6753CF21,
+    0xC689A58C, 0x4C5709CF, 0x5E9C79A4, 0x92233D1E, 0xBCB2C966, 0x1E203E1C, 0xF604DA1B, 0xAD30EC2C,
+    0x3F25C0B7, 0xEA74CF2C, 0x529EB4F8, 0x1DDD8C14, 0x9F8A9101, 0xA27ABB5A, 0x260F6448, 0x1231319A,
+    0x58312DD3, 0x04BC36D9, 0xE5A46A12, 0xBDAE400F, 0x8BB15103, 0x22447D0A, 0x44EA8F7A, 0xBFF7A26E,
+    0xE31C2745, 0x9D24BEB9, 0x88A41159, 0x7CFFF6FC, 0x10453745, 0x705AADBC, 0x429A496B, 0xD62C2F1E,
+    0x5B0EEB1C, 0xC7C50906, 0x684F5113, 0x03C4EF5F, 0x17D686F9, 0x9E6F63EA, 0xED78B327, 0x9B829C62,
+    0x0AEB2C3A, 0x7C5660F4, 0x2DA6CA04, 0x0415A76F, 0xD65CF7F0, 0x6B3804F2, 0x42E5BD47, 0xFAF03B49,
+    0x62BD3D6A, 0xD79ACA8A, 0xBF00C882, 0x5F708EE3, 0x2AF0B269, 0x97B7716D, 0x247CCE92, 0x0D8E8B2C,
+    0xC96ECE83, 0xC825200E, 0x9CF7149B, 0x4F2DFB40, 0xFEB7BC09, 0xDA0CED27, 0x879226EF, 0x12CCCB62,
+    0x5AFD606E, 0xB609AA97, 0x1100A681, 0xCAADFBA9, 0xFDF04A9B, 0xC0718B95, 0xD42F481C, 0xB7E21E8D,
+    0x5D21A1A9, 0x346DB133, 0xAAB87108, 0x3C7EFED5, 0xEA98D4BB, 0xB4C4A053, 0xB3B945AC, 0x2E1EB91E,
+    0xDDE6206C, 0xA3AE561B, 0xB6892E1E, 0x2207898C, 0x4FECEF3F, 0xAB86291F, 0x4DE3810D, 0xBADDFA1B,
+    0xC0FC5491, 0xD400FA57, 0x00AC45AE, 0x8EBA8E89, 0x36C25BAC, 0x48A50472, 0x7217FF79, 0xEDAC824F,
+    0xC659EA8D, 0x43BADBD6, 0x4716F155, 0x96C43519, 0xA18D84ED, 0x7CCBF58F, 0x76DA48C3, 0xF7CDD645,
+    0x7321BE84, 0xB9AA5592, 0x9099B290, 0x2993938C, 0x07807AD4, 0x261DD7AF, 0x6A506B7C, 0x1F075A2B,
+    0xECCD2363, 0x5E6BBBC2, 0xA7D62877, 0x7700F0DC, 0x3D6E0605, 0xE8D1B990, 0x6B70CF7C, 0x3AF89BA3,
+    0x0FA6AB12, 0x05A7304D, 0x4E2BBB79, 0x795DEA10, 0x2BA92F90, 0x2F0E6723, 0x23B699AD, 0x51DA6B75,
+    0xDF66E5B0, 0x86E9383F, 0x1C65DF6C, 0x55B90651, 0xA91EA25C, 0x93E3F409, 0xBE9E1D82, 0xB81CE7B8,
+    0x43C85F9B, 0x1C315267, 0x24277BFD, 0x2DE4BA05, 0x359F3252, 0xB7768678, 0xD3C3A8CE, 0x638C7E2A,
+    0x8E9B8EF5, 0x65271B81, 0x42D2192A, 0xDB51BAE5, 0xD48DDF91, 0xEE0D16A4, 0x1748BCFA, 0x967ECD65,
+    0xA0C35FFB, 0x0B282636, 0x1FB65DA3, 0x381F1E69, 0x5DDADBD0, 0x9BD6B809, 0xCC66A36F, 0xC7C12B6F,
+    0x435E2F14, 0x6CF4F016, 0xCE7597EA, 0x6E56D396, 0xEEDFCC7A, 0x26018A92, 0x996CBA40, 0x3AD26DD4,
+    0xA7AA17F9, 0x6D3D8D94, 0x56242AC3, 0x60E0B121, 0xCC1AEAE1, 0xD7B87AB8, 0xFE7561E8, 0xA198C45C,
+    0x322F26A5, 0x63C0BB7B, 0x486599EA, 0x00AE0E34, 0x437D8C52, 0x27B8AEBF, 0x643A7395, 0x7A23BDB2,
+    0x973A3FF8, 0x8B93CDD7, 0xE522F9C7, 0x9C74B7B9, 0x1DFE228B, 0xB0ED46F6, 0x82333841, 0x17AF8231,
+    0xA1CB017E, 0xFAA55465, 0x568AEB01, 0xB1398D5B, 0xBDA9C5F4, 0xF0D47AF9, 0x64C93D62, 0xC2088B3D,
+    0x147C9EEF, 0x26B101C7, 0x0A2A1029, 0xDE4A8C51, 0x4713790A, 0xC507E11D, 0x44132929, 0xF3539761,
+    0x48EA0A29, 0xAF2F4B42, 0xB8DB5782, 0x9DCC518E, 0x88D0667C, 0x1CF8CA28, 0x5CB62D86, 0x35B9983F,
+    0x6B0A2BB3, 0x44C55CCA, 0x870E1D7E, 0xBF8B86BC, 0x8179B162, 0xCB6CB629, 0x9A4FF3C6, 0x858BA999,
+    0x921D52BE, 0x6C86B910, 0x26E60E5D, 0x1129A888, 0x1D274246, 0xEFF70D6A, 0x629DD34C, 0x23D1612D,
+    0x67F93B72, 0x738DAA4C, 0x34612E5B, 0xC61029A8, 0x2ADE4BD6, 0x9200F92A, 0xBC15C38B, 0x8C3DE351,
+    0xBA9A015D, 0x9BC7603F, 0x11EE979D, 0x837DFE84, 0xE2DB6640, 0x3E702A41, 0x66FF6CAF, 0x86DEFDDE,
+    0xAAA8F94F, 0x5FDB3437, 0x0180C573, 0xBA16D04C, 0x7956FD09, 0xE1EBF0CF, 0x063C4443, 0x8B07889B,
+    0x12F39E68, 0x46CE3694, 0xEBECB90B, 0xF12F6FF0, 0x7DE66F18, 0x68186CC7, 0xE110EABF, 0x67097BAA,
+    0x7015197E, 0x3762F44C, 0xA81C6101, 0xAEE2B771, 0x3EA2265F, 0x5A3AEA5B, 0x59F047F3, 0xFFF1F0DD,
+    0x7E78B3CF, 0x5483F938, 0x1D10DE04, 0xB4EE7D41, 0x8821EF3E, 0x99903D47, 0xB375BF64, 0xD819DC6D,
+    0x4849E17C, 0xB0DEA682, 0xFD082FBD, 0x85C910C2, 0x9A3089F2, 0xC055EBD9, 0xFB0777D9, 0x71B11960,
+    0x45FECA9C, 0x9F71C8E9, 0x1F0A172A, 0x1C396EC8, 0xEE73989E, 0xFB3E8EC6, 0x4D801C3C, 0x64809676,
+    0xDC52C8D4, 0x3563ABF7, 0x07611140, 0x2E503426, 0xFF3FCF70, 0xA810BEB1, 0x0126EB4A, 0x82D8DEEE,
+    0x0593A621, 0x2824EF05, 0x72DF573C, 0x6F05926E, 0xE0E634F5, 0xC87AF561, 0x5BBCC254, 0x34EE1D22,
+    0x550D66A8, 0xEDC5DCBC, 0x989FBE3F, 0x2D4A9466, 0x484C287A, 0x23BDFDC0, 0xAE8D54C2, 0x06707295,
+    0xC2B73878, 0x846E9279, 0x891BF986, 0x53933347, 0x404DF8D8, 0x7C8855FA, 0x91C5483D, 0x6436DCE5,
+    0x87C88E5E, 0x98D1013E, 0xB912435F, 0x30CF7213, 0xA17B41BD, 0x1645627E, 0x331129C3, 0xD6654C6C,
+    0x848017D1, 0x0C87956C, 0xDCDF6AB9, 0x4E610BCA, 0x520B86A3, 0x2978F507, 0x8C9A3683, 0xE83DD977,
+    0x8AC41B1F, 0x02BAD41D, 0x3406D560, 0x81D50A0A, 0xB908B883, 0xF33FEB45, 0x3A5370EE, 0x7E8A90C0,
+    0x50F6132E, 0xA4EC9C0C, 0xC2C9123D, 0x9AC1C553, 0x52E4D9EB, 0xD3838A60, 0x0523455F, 0xA055F4A7,
+    0xC62D4F6A, 0xA28900B2, 0xBE1202AC, 0xF579277A, 0x8869FF30, 0xCBA6C087, 0x3A132915, 0xA95A6231,
+    0x7FE812BF, 0x721E59AC, 0x23698AEA, 0xF74C1FF3, 0xC6B8E7C5, 0x1370550B, 0x8E81B1FF, 0x4007EECB,
+    0x17C90CCF, 0x3B6BFF52, 0xEB75938B, 0x8E93F7D0, 0x5091AB88, 0x2299D81E, 0xD46AD245, 0x970B94C8,
+    0xFF5D07A2, 0x5C822DC7, 0x19FEF7E2, 0x94DFAD4A, 0x46274F3A, 0x455EDCCD, 0xD69EDFF9, 0x05A4F9E0,
+    0x9828A2A4, 0x49661646, 0x5F4C5382, 0xD5B53DAE, 0x7B857D2F, 0x0106A12F, 0x4178AA35, 0x2944DB33,
+    0xAFACA47C, 0xC25E7B87, 0x744E30A8, 0xF170BFDC, 0x07942123, 0x37D33AA2, 0x870DE989, 0x3A5CB332,
+    0xC9B565F1, 0x0B124C37, 0x6D70D471, 0xFB6DB8F4, 0x4087AC19, 0x5CD9B4AA, 0x5DF67D9D, 0x2CA169A1,
+    0x5E498427, 0xF1D2E8BC, 0x97E80738, 0x76272636, 0x13D16CF0, 0xF92C494D, 0x0BB42A9A, 0x0EAE3560,
+    0xD08E2DB5, 0x60FB57B7, 0x745694E0, 0x6379EF3E, 0x914460AA, 0x496623CB, 0x70B802DA, 0x423F1FDA,
+    0xD279BC47, 0x2FB69203, 0x5375A3BF, 0x5B888F1F, 0x14E5D369, 0x6E09165B, 0xF173EC2D, 0xC52E96B0,
+    0xADEFB875, 0x4384C586, 0x3EFCD090, 0xE1C22FFC, 0x4B354172, 0x89043F21, 0x8D266AA8, 0x0E0AF093,
+    0x8223BF7D, 0x271D46CC, 0x4945F3E9, 0x6D0F8881, 0xD433B8CD, 0x3C7EB998, 0x4F3B8ADF, 0x1F31B538,
+    0x810B6F9C, 0xC963C659, 0xAD9CAD7C, 0xEC97C0D6, 0x2B6BC714, 0x882BC639, 0x9B2F67C4, 0x3E3AEE51,
+    0xA65B2E05, 0x76CCC4C7, 0xF0F55AFF, 0xEEC45EE6, 0xA85948D4, 0x457BAE8C, 0xFBB5222F, 0xEFE35781,
+    0x1C0A6DE0, 0xE0810FC7, 0x6EC49816, 0x811098A8, 0x6EF1812A, 0xADD624CA, 0x07EE6EDC, 0x5E92AED2,
+    0x1C0C5674, 0x49EFC43E, 0xDC1CB571, 0xA2D11557, 0x53ACEED3, 0x579BA3F9, 0x959EF5EF, 0x5EC408A8,
+    0x86EF1A2D, 0x5004B95A, 0xA0FE46E2, 0xFD9B6851, 0x8CE91E7C, 0xFD1415AF, 0x8D7465D2, 0x80D6DF69,
+    0x2A192A2A, 0x96AC2F50, 0xD17D295A, 0xC97353A2, 0x7DAC83CF, 0x454A90DA, 0x08FA1D0E, 0x719FAB54,
+    0xA48AB217, 0xC4E0E420, 0xB0654531, 0x064A3D62, 0x11452F96, 0x85F4DFFC, 0xEE4D2750, 0x1FB8F1D7,
+    0xC847E903, 0xA0630A23, 0x422D1330, 0x5EBAA964, 0x917F013D, 0x71DF55D9, 0x55752156, 0x80A351C0,
+    0x1E37C1EE, 0x3D22EE52, 0xC984F6D6, 0x1E77A756, 0x8ECF4949, 0x8E2266AF, 0x6EA213CB, 0x0AC0C5E4,
+    0x7A89316D, 0xF6AB0BDC, 0xCE493298, 0x6FC77665, 0xAD008EB1, 0xB48A5050, 0xC5E38E40, 0xB763919A,
+    0xA6ACB166, 0x988D2AFD, 0xAB212314, 0xC89CD5DC, 0xCC6A25E4, 0x25C7ED80, 0x844DDA7D, 0x8967E6B7,
+    0xEA5E52C1, 0xD43B44B3, 0xD9E862AC, 0x53AFF8C2, 0x7D6ED21A, 0x68A175B6, 0x62510CA1, 0xBDE537A2,
+    0x5AC50176, 0x144D5AE1, 0x95002E0D, 0xCB83E26F, 0xECBEEA98, 0x0D6B9A34, 0x723AA687, 0x0652B4BA,
+    0xA69960CC, 0x56B8A050, 0xB4740F21, 0xB32077D6, 0xC14C5DD5, 0x82393520, 0x54FF2980, 0x24B73CAA,
+    0x7632CC71, 0xDBC24D97, 0xC280D258, 0x5624508A, 0xF521C322, 0xE1836BC6, 0x6DF12D62, 0xD0DE8D20,
+    0xC43C63C8, 0xCEEE4129, 0x65D9313A, 0x5132A95D, 0x453E708B, 0x4CAEDA7E, 0x53421860, 0x110B3D81,
+    0xC20A0317, 0x047C3904, 0xFC48299C, 0xFDC9C380, 0x65B6F53A, 0xC97952AA, 0x041CEEAC, 0x6FDC1F0F,
+    0x9D103B23, 0x6BE202FC, 0x72258738, 0x50CCEDC0, 0x1E553D48, 0x4CBF230F, 0x4DCD2AE3, 0x1D8D3639,
+    0x36655394, 0x7B097FE6, 0x72F92EA0, 0x4075D53C, 0x573D714D, 0x3E028462, 0xAC51D400, 0x4F4F55D2,
+    0x60D61AD9, 0x4EF1766E, 0x2933F844, 0x764BB8BB, 0x6A1762C2, 0x4CC76345, 0xBE1ABB4F, 0xBA1A7650,
+    0xA597A6AA, 0xD9C2A4BD, 0x9DEBB888, 0x1C19050A, 0xCEE1E222, 0xE6A2CBAE, 0x13D6CA57, 0x539B048F,
+    0xC8D1B759, 0x2A8161EE, 0x88A73D27, 0x351950C0, 0xB006E4D8, 0xD221B7F1, 0x18E7EBB6, 0x0C6CB4C2,
+    0xC912E8AF, 0x955E0BAC, 0x923D39D0, 0xCF6CB404, 0xD26A2E1A, 0xBF6BCF85, 0x5D4EE529, 0x32BAD88D,
+    0xF948865D, 0x67E208F0, 0x9414ECB8, 0x0169D714, 0xF1615F26, 0x41AD53CE, 0x58173546, 0x687D6A20,
+    0x6BA574C8, 0x9EB9E42B, 0xC1E205FD, 0x205EF543, 0xC9F966C4, 0xABADC435, 0x2DEF6B9C, 0x6CF7DFB5,
+    0x5703879B, 0x5F1EC982, 0xD25C4FEE, 0x2FE0DF96, 0x1CD1FB4B, 0x8D82C7CC, 0xE8086C23, 0xF9BCA16A,
+    0x4054510F, 0x3F6901C2, 0x0E95933D, 0x5F9AFC73, 0xB223A01A, 0x9AF1FA66, 0x4ABC87D8, 0x5EF6B89A,
+    0x26FE8DDF, 0x747407AB, 0x284E1581, 0x2224FFDD, 0x7693EFB9, 0x3EF9F2D6, 0x30EC78B7, 0x9ACB8455,
+    0x5D288B81, 0x803050CC, 0x04ECB7E3, 0xC00F1C22, 0x7038B1EC, 0x755014D0, 0x5368073A, 0x995D90CB,
+    0xE9AF6B62, 0xF1A956B2, 0xCCFF4B20, 0xD1BB1528, 0xF5547431, 0xAE7830C9, 0xB7E44D3E, 0xECACA5E4,
+    0x8D3A1301, 0x87B7523D, 0x147C97F4, 0xD1D27885, 0xAF5D7A71, 0x760E9BB9, 0x0873EACF, 0x4623A9DD,
+    0x12E768DF, 0x5658980A, 0x3DE20B1A, 0x660F5CC2, 0x7395CD8C, 0xDA270B9E, 0xB6D9E4C5, 0xCF9DDE5D,
+    0xFC3E093C, 0x303DBDF3, 0x7945FE0C, 0x6C02C54D, 0x20EF8DE2, 0x1A491D18, 0xEA299A19, 0x20DC6049,
+    0x584647F0, 0x22F2F437, 0x43679923, 0x5C88B46E, 0x07CF3C8D, 0x50F1441B, 0xECBA495D, 0xA33B1AF8,
+    0x343D8571, 0x54429682, 0x7D2AE99E, 0xB2F9E0B9, 0x8140A85C, 0x7646E4F6, 0xE8346777, 0xB1FFDC8A,
+    0x2D0C2971, 0xF2078CC1, 0xBB1301A0, 0xF227B58B, 0x1A6DC59E, 0x4C347322, 0xD3CF53FF, 0x7BC8B3A8,
+    0x6513C073, 0xDD10CA31, 0x736D8182, 0x0F3F0D76, 0x2596C239, 0x7AD997F4, 0x6D7A7203, 0x8805EFBE,
+    0x7E13A030, 0x1E435AF8, 0x632D058A, 0xC6ADE84A, 0x1C1C7077, 0x24D73B4E, 0x1E01121B, 0x87E1B82D,
+    0xD4E61DB4, 0x1F7B5392, 0x244BF56A, 0xC060C87D, 0x6CCD5306, 0x8DDEC378, 0xC477545C, 0xA23938FE,
+    0x78801730, 0xBEE3837B, 0x44E3701F, 0x832CA473, 0x115D0FE3, 0xB60FC9CE, 0x9FC69A8F, 0xAF84AD4D,
+    0xE28622FC, 0xC4D63CF5, 0xECF63B42, 0x237AF90F, 0xD7DC1877, 0x05C296DF, 0x51A44547, 0xA44C6431,
+    0xD28746AD, 0x224F035D, 0xE57034D3, 0x81AC6D83, 0xA156B330, 0x66D2719A, 0x5C398D81, 0x9A9780F2,
+    0xFBB9B699, 0x40C0DC12, 0xBC3C72B9, 0xED3AE061, 0x7B2464A1, 0x9EF6FA72, 0x371B77DD, 0xC96932C9,
+    0x6BCA84CD, 0x8B10D749, 0x5FC58291, 0xAF12A732, 0x0C00172C, 0x40DE1C95, 0x1CDEF322, 0x92ADA5C1,
+    0xDCC74C37, 0x010F4622, 0x61D02A4C, 0xF613921D, 0x1C8936BD, 0x657B3F3B, 0x8F79A405, 0x008B4800,
+    0x194DDCB6, 0xF089AD4D, 0x1F34071D, 0x7FF5B26D, 0xA7501B93, 0x35F15459, 0x6CAAF256, 0x5F15254D,
+    0x70133ECB, 0xEF36CFCB, 0xD90B2164, 0x26A20FB8, 0x5771779A, 0x3DA5F062, 0xCAAEE26E, 0xB0ACDBB6,
+    0x204F633E, 0xA94E2533, 0x1CF5275A, 0x05E346D8, 0x30C77E71, 0x02F44EB5, 0x2447F3E6, 0x23A888FD,
+    0x697873B4, 0x49DBB54D, 0x402CA676, 0xBEDAD0F5, 0x6E2C1B60, 0x42734E6E, 0x3EA2F82A, 0xAA3422F3,
+    0x9F391A49, 0xA1D13391, 0x2ADB8F0F, 0x932AF94A, 0x43FD3454, 0xFCD2A824, 0x392578A0, 0x09F6EDCC,
+    0x0D893674, 0xC6E04E54, 0xBA4884EE, 0x0A0E7227, 0x9B4CED12, 0x523CF73B, 0x2934146D, 0xFC9BF952,
+    0xE0C27063, 0x6C0E3C12, 0x918F0964, 0x80E78865, 0x1608FF13, 0x96677D39, 0x2AB8FE2F, 0x75E774CE,
+    0xAB1129B8, 0x45763AC2, 0x743FA9C0, 0xE971AC97, 0x7D10847D, 0xD03B7CDC, 0xC34C0C26, 0x0C520076,
+    0xBEAABEE2, 0x41D4C12A, 0xEBB956DC, 0xFEEC3687, 0x940500D0, 0x42B6E753, 0xD0C4DDC7, 0xE78AC0AE,
+    0x40BB816C, 0xF29BC2D6, 0x6329084A, 0x61960023, 0xE99DAC22, 0x64A3FE46, 0x6002CB13, 0xC009A549,
+    0xBC607EE9, 0x6A7BB835, 0x8DC4D038, 0xA7BAA6C6, 0xD7432364, 0xE99C4D1C, 0x0ADA3A87, 0x36461F7E,
+};
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lv_color.h"
+#include "lv_draw_sw_blend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Source of the per-pixel blend to RGB565
+ */
+typedef enum {
+    BLEND_SRC_COLOR,                                          /*!< Fill with lv_color_t, lv_draw_sw_blend_color_to_rgb565() */
+    BLEND_SRC_RGB888,                                         /*!< RGB888 image, lv_draw_sw_blend_image_to_rgb565() */
+    BLEND_SRC_ARGB8888,                                       /*!< ARGB8888 image, lv_draw_sw_blend_image_to_rgb565() */
+} blend_rgb565_src_t;
+
+/**
+ * @brief Functionality test combinations for the per-pixel blends to RGB565
+ */
+typedef struct {
+    unsigned int max_w;                                       /*!< Maximum width of the test array */
+    unsigned int max_h;                                       /*!< Maximum height of the test array */
+    unsigned int max_padding;                                 /*!< Maximum row padding in pixels, for all the strides */
+    unsigned int dest_max_unalign_byte;                       /*!< Maximum amount of unaligned bytes of the destination test array, stepped by 2 */
+    unsigned int src_max_unalign_byte;                        /*!< Maximum amount of unaligned bytes of the source and mask test arrays */
+    unsigned int test_combinations_count;                     /*!< Count of fest combinations */
+} test_matrix_lv_blend_rgb565_params_t;
+
+/**
+ * @brief Functionality test case parameters for the per-pixel blends to RGB565
+ */
+typedef struct {
+    struct {
+        uint8_t *p_src;                                       /*!< pointer to the source test buff, common for both the ANSI and ASM */
+        lv_opa_t *p_mask;                                     /*!< pointer to the mask test buff, common for both the ANSI and ASM, NULL without mask */
+        uint16_t *p_dest_asm;                                 /*!< pointer to the destination ASM test buf, after the Canary pixels */
+        uint16_t *p_dest_ansi;                                /*!< pointer to the destination ANSI test buf, after the Canary pixels */
+        void *p_src_alloc;                                    /*!< pointer to the beginning of the memory allocated for the source test buf, used in free() */
+        void *p_mask_alloc;                                   /*!< pointer to the beginning of the memory allocated for the mask test buf, used in free() */
+        void *p_dest_asm_alloc;                               /*!< pointer to the beginning of the memory allocated for the destination ASM test buf, used in free() */
+        void *p_dest_ansi_alloc;                              /*!< pointer to the beginning of the memory allocated for the destination ANSI test buf, used in free() */
+    } buf;
+    blend_rgb565_src_t src_type;                              /*!< Source of the blend */
+    lv_opa_t opa;                                             /*!< Global opacity */
+    bool use_mask;                                            /*!< Blend through a mask buffer */
+    size_t canary_pixels;                                     /*!< Canary pixels on both sides of the destination buffer */
+    unsigned int dest_w;                                      /*!< Destination buffer width */
+    unsigned int dest_h;                                      /*!< Destination buffer height */
+    unsigned int padding;                                     /*!< Row padding in pixels, for all the strides */
+    unsigned int src_unalign_byte;                            /*!< Source and mask buffers memory unalignment */
+    unsigned int dest_unalign_byte;                           /*!< Destination buffer memory unalignment */
+} func_test_case_lv_blend_rgb565_params_t;
+
+/**
+ * @brief Benchmark test case parameters for the per-pixel blends to RGB565
+ */
+typedef struct {
+    const char *name;                                         /*!< Benchmarked hook, for the log */
+    blend_rgb565_src_t src_type;                              /*!< Source of the blend */
+    lv_opa_t opa;                                             /*!< Global opacity */
+    bool use_mask;                                            /*!< Blend through a mask buffer */
+} bench_test_case_lv_blend_rgb565_params_t;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Rotation of the DUT function, same values as lv_display_rotation_t
+ */
+typedef enum {
+    ROTATION_90 = 1,
+    ROTATION_180 = 2,
+    ROTATION_270 = 3,
+} rotation_t;
+
+/**
+ * @brief Signature of the tiled rotation functions
+ */
+typedef void (*rotate_func_t)(const void *src, void *dst, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t dst_stride, bool swap_bytes);
+
+/**
+ * @brief Functionality test combinations for the RGB565 rotation
+ */
+typedef struct {
+    unsigned int min_w;                                       /*!< Minimum width of the source test array */
+    unsigned int min_h;                                       /*!< Minimum height of the source test array */
+    unsigned int max_w;                                       /*!< Maximum width of the source test array */
+    unsigned int max_h;                                       /*!< Maximum height of the source test array */
+    unsigned int max_padding;                                 /*!< Maximum matrix padding in pixels, for both source and destination stride */
+    unsigned int dest_max_unalign_byte;                       /*!< Maximum amount of unaligned bytes of the destination test array */
+    unsigned int test_combinations_count;                     /*!< Count of fest combinations */
+} test_matrix_lv_rotate_params_t;
+
+/**
+ * @brief Functionality test case parameters for the RGB565 rotation
+ */
+typedef struct {
+    rotation_t rotation;                                      /*!< Rotation of the DUT function */
+    rotate_func_t rotate_func;                                /*!< Pointer to the DUT function */
+    bool swap_bytes;                                          /*!< Swap bytes in the same pass */
+    unsigned int src_w;                                       /*!< Source buffer width */
+    unsigned int src_h;                                       /*!< Source buffer height */
+    unsigned int src_stride;                                  /*!< Source buffer stride in pixels */
+    unsigned int dest_w;                                      /*!< Destination buffer width, src_h for 90 and 270 degrees */
+    unsigned int dest_h;                                      /*!< Destination buffer height, src_w for 90 and 270 degrees */
+    unsigned int dest_stride;                                 /*!< Destination buffer stride in pixels */
+    unsigned int dest_unalign_byte;                           /*!< Destination buffer memory unalignment */
+    size_t canary_pixels;                                     /*!< Canary pixels on both sides of the destination buffer */
+} func_test_case_lv_rotate_params_t;
+
+/**
+ * @brief Benchmark test case parameters for the RGB565 rotation
+ */
+typedef struct {
+    unsigned int width;                                       /*!< Source test array width */
+    unsigned int height;                                      /*!< Source test array height */
+    unsigned int benchmark_cycles;                            /*!< Count of benchmark cycles */
+    uint16_t *src_array;                                      /*!< Source test array */
+    uint16_t *dest_array;                                     /*!< Destination test array */
+} bench_test_case_lv_rotate_params_t;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Functionality test combinations for RGB565 swap
+ */
+typedef struct {
+    unsigned int min_len;                                     /*!< Minimum length of the test array in pixels */
+    unsigned int max_len;                                     /*!< Maximum length of the test array in pixels */
+    unsigned int src_max_unalign_byte;                        /*!< Maximum amount of unaligned bytes of the source test array */
+    unsigned int dest_max_unalign_byte;                       /*!< Maximum amount of unaligned bytes of the destination test array */
+    unsigned int unalign_step;                                /*!< Increment step in bytes unalignment, RGB565 buffers are always 2-byte aligned */
+    unsigned int test_combinations_count;                     /*!< Count of fest combinations */
+} test_matrix_lv_swap_params_t;
+
+/**
+ * @brief Functionality test case parameters for RGB565 swap
+ */
+typedef struct {
+    struct {
+        uint16_t *p_src;                                      /*!< pointer to the source test buff, the destination itself for in place swap */
+        uint16_t *p_dest_asm;                                 /*!< pointer to the destination ASM test buf, after the Canary pixels */
+        uint16_t *p_dest_ansi;                                /*!< pointer to the destination ANSI test buf, after the Canary pixels */
+        void *p_src_alloc;                                    /*!< pointer to the beginning of the memory allocated for the source test buf, used in free() */
+        void *p_dest_asm_alloc;                               /*!< pointer to the beginning of the memory allocated for the destination ASM test buf, used in free() */
+        void *p_dest_ansi_alloc;                              /*!< pointer to the beginning of the memory allocated for the destination ANSI test buf, used in free() */
+    } buf;
+    bool in_place;                                            /*!< Swap the destination buffer in place, like the flush callback does */
+    size_t len;                                               /*!< Length of the swapped part in pixels */
+    size_t canary_pixels;                                     /*!< Canary pixels on both sides of the destination buffer */
+    unsigned int src_unalign_byte;                            /*!< Source buffer memory unalignment */
+    unsigned int dest_unalign_byte;                           /*!< Destination buffer memory unalignment */
+} func_test_case_lv_swap_params_t;
+
+/**
+ * @brief Benchmark test case parameters for RGB565 swap
+ */
+typedef struct {
+    unsigned int len;                                         /*!< Test array length in pixels */
+    unsigned int cc_len;                                      /*!< Corner case test array length in pixels */
+    unsigned int benchmark_cycles;                            /*!< Count of benchmark cycles */
+    uint16_t *array_align16;                                  /*!< Test array with 16 byte alignment - testing most ideal case */
+    uint16_t *array_align4;                                   /*!< Test array with 4 byte alignment - testing worst case of LVGL draw buffers */
+} bench_test_case_lv_swap_params_t;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_blend_fuzz.h"
+#include "lv_blend_golden.h"
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_BLEND_GOLDEN = "LV Blend Golden";
+static char test_msg_buf[200];
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the golden sequence and compare every destination CRC with lv_blend_golden.h
+ *
+ * @param[in] use_asm Run the assembly hooks, or the ANSI hard copy
+ */
+static void lv_blend_golden_run(bool use_asm);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Golden output tests
+
+Purpose:
+    - Test the blend API against outputs generated off-device, by host/blend_fuzz at the top of the repository
+      from the same ANSI hard copy and the same seeded cases (lv_blend_fuzz.c)
+
+Procedure:
+    - Generate each case of the golden sequence: blend entry, widths, strides, alignments, opacity, mask, buffer contents
+    - Run it, compute the CRC of the destination buffer with the Canary bytes
+    - Compare with the golden CRC
+    - The ANSI run checks that the hard copy behaves on target as on the host, the assembly run checks the kernels
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Blend golden outputs ANSI", "[blend][golden]")
+{
+    ESP_LOGI(TAG_LV_BLEND_GOLDEN, "running %d golden cases with ANSI", LV_BLEND_GOLDEN_CASES);
+    lv_blend_golden_run(false);
+}
+
+TEST_CASE("LV Blend golden outputs ASM", "[blend][golden]")
+{
+    ESP_LOGI(TAG_LV_BLEND_GOLDEN, "running %d golden cases with ASM", LV_BLEND_GOLDEN_CASES);
+    lv_blend_golden_run(true);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_blend_golden_run(bool use_asm)
+{
+    for (uint32_t i = 0; i < LV_BLEND_GOLDEN_CASES; i++) {
+        lv_blend_fuzz_case_t fuzz_case;
+        lv_blend_fuzz_result_t result;
+
+        lv_blend_fuzz_case_init(LV_BLEND_GOLDEN_SEED, i, &fuzz_case);
+        TEST_ASSERT_TRUE_MESSAGE(lv_blend_fuzz_run(&fuzz_case, use_asm, &result), "Lack of memory");
+
+        snprintf(test_msg_buf, sizeof(test_msg_buf), "Case %"PRIu32": %s %"PRIi32"x%"PRIi32", dest_stride = %"PRIi32", src_stride = %"PRIi32
+                 ", mask = %d, dest_unalign_byte = %"PRIu32", src_unalign_byte = %"PRIu32", opa = %d",
+                 i, lv_blend_fuzz_op_name(fuzz_case.op), fuzz_case.dest_w, fuzz_case.dest_h, fuzz_case.dest_stride,
+                 fuzz_case.src_stride, fuzz_case.use_mask, fuzz_case.dest_unalign_byte, fuzz_case.src_unalign_byte, fuzz_case.opa);
+        TEST_ASSERT_TRUE_MESSAGE(result.canary_ok, test_msg_buf);
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_blend_golden_crc[i], result.crc, test_msg_buf);
+    }
+}
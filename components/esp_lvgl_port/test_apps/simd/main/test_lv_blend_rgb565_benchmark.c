@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "lv_blend_rgb565_common.h"
+#include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_to_rgb565.h"
+
+#define COMMON_DIM 128      // Common matrix dimension 128x128 pixels
+#define WIDTH COMMON_DIM
+#define HEIGHT COMMON_DIM
+#define STRIDE WIDTH
+#define UNALIGN_BYTES 3
+#define BENCHMARK_CYCLES 100    // Per-pixel blends are slower than the fills and copies, keep the test time reasonable
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_BLEND_RGB565_BENCH = "LV Blend RGB565 Benchmark";
+static const char *asm_ansi_func[] = {"ASM", "ANSI"};
+
+static const lv_color_t test_color = {
+    .blue = 0x56,
+    .green = 0x34,
+    .red = 0x12,
+};
+
+// Every new hook, LV_OPA_50 selects the _WITH_OPA and _MIX_MASK_OPA ones
+static const bench_test_case_lv_blend_rgb565_params_t bench_cases[] = {
+    {"color with opa",          BLEND_SRC_COLOR,    LV_OPA_50,      false},
+    {"color with mask",         BLEND_SRC_COLOR,    LV_OPA_COVER,   true},
+    {"color mix mask opa",      BLEND_SRC_COLOR,    LV_OPA_50,      true},
+    {"RGB888 normal",           BLEND_SRC_RGB888,   LV_OPA_COVER,   false},
+    {"RGB888 with opa",         BLEND_SRC_RGB888,   LV_OPA_50,      false},
+    {"RGB888 with mask",        BLEND_SRC_RGB888,   LV_OPA_COVER,   true},
+    {"RGB888 mix mask opa",     BLEND_SRC_RGB888,   LV_OPA_50,      true},
+    {"ARGB8888 normal",         BLEND_SRC_ARGB8888, LV_OPA_COVER,   false},
+    {"ARGB8888 with opa",       BLEND_SRC_ARGB8888, LV_OPA_50,      false},
+    {"ARGB8888 with mask",      BLEND_SRC_ARGB8888, LV_OPA_COVER,   true},
+    {"ARGB8888 mix mask opa",   BLEND_SRC_ARGB8888, LV_OPA_50,      true},
+};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the benchmark test, returns cycles per one blend call
+ *
+ * @param[in] test_params Pointer to structure defining the benchmarked hook
+ * @param[in] fill_dsc Fill descriptor, used for BLEND_SRC_COLOR
+ * @param[in] image_dsc Image descriptor, used for the image sources
+ */
+static float lv_blend_rgb565_benchmark_run(const bench_test_case_lv_blend_rgb565_params_t *test_params,
+                                           _lv_draw_sw_blend_fill_dsc_t *fill_dsc, _lv_draw_sw_blend_image_dsc_t *image_dsc);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that an acceleration is achieved by the assembly opacity / mask fills and RGB888 / ARGB8888 image blends
+
+Procedure:
+    - Run each hook in the ideal case (aligned arrays, no padding) and in the corner case
+      (unaligned arrays, width one pixel smaller, non 0 matrix padding), assembly first, then ANSI
+    - Count how many CPU cycles does it take, per call and per pixel
+    - Source, alpha and mask bytes are a mixture of transparent, opaque and in between values, like antialiased edges
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Blend benchmark per-pixel blends to RGB565", "[blend][benchmark][RGB565]")
+{
+    const size_t px_count = STRIDE * HEIGHT;
+    uint16_t *dest_array_align16 = (uint16_t *)memalign(16, px_count * sizeof(uint16_t) + UNALIGN_BYTES);
+    uint8_t *src_array_align16 = (uint8_t *)memalign(16, px_count * sizeof(uint32_t) + UNALIGN_BYTES);
+    lv_opa_t *mask_array_align16 = (lv_opa_t *)memalign(16, px_count + UNALIGN_BYTES);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, mask_array_align16);
+
+    for (int i = 0; i < px_count * sizeof(uint32_t); i++) {
+        src_array_align16[i] = (uint8_t)(i * 73 + 29);
+    }
+    for (int i = 0; i < px_count; i++) {
+        mask_array_align16[i] = (i % 4 == 0) ? LV_OPA_TRANSP : (i % 4 == 1) ? LV_OPA_COVER : (uint8_t)(i * 37 + 11);
+        src_array_align16[i * 4 + 3] = mask_array_align16[i];
+        dest_array_align16[i] = i * 0x1F3D;
+    }
+
+    // Apply byte unalignment for the worst-case test scenario, RGB565 destination stays 2-byte aligned
+    uint16_t *dest_array_align2 = (uint16_t *)((uint8_t *)dest_array_align16 + UNALIGN_BYTES - 1);
+    uint8_t *src_array_align1 = src_array_align16 + UNALIGN_BYTES;
+    lv_opa_t *mask_array_align1 = mask_array_align16 + UNALIGN_BYTES;
+
+    for (int c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        const bench_test_case_lv_blend_rgb565_params_t *test_params = &bench_cases[c];
+        const unsigned int src_px_size = (test_params->src_type == BLEND_SRC_ARGB8888) ? 4 : 3;
+
+        _lv_draw_sw_blend_fill_dsc_t fill_dsc = {
+            .dest_buf = dest_array_align16,
+            .dest_w = WIDTH,
+            .dest_h = HEIGHT,
+            .dest_stride = STRIDE * sizeof(uint16_t),
+            .mask_buf = test_params->use_mask ? mask_array_align16 : NULL,
+            .mask_stride = STRIDE,
+            .color = test_color,
+            .opa = test_params->opa,
+            .use_asm = true,
+        };
+        _lv_draw_sw_blend_image_dsc_t image_dsc = {
+            .dest_buf = dest_array_align16,
+            .dest_w = WIDTH,
+            .dest_h = HEIGHT,
+            .dest_stride = STRIDE * sizeof(uint16_t),
+            .mask_buf = test_params->use_mask ? mask_array_align16 : NULL,
+            .mask_stride = STRIDE,
+            .src_buf = src_array_align16,
+            .src_stride = STRIDE * src_px_size,
+            .src_color_format = (test_params->src_type == BLEND_SRC_ARGB8888) ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_RGB888,
+            .opa = test_params->opa,
+            .blend_mode = LV_BLEND_MODE_NORMAL,
+            .use_asm = true,
+        };
+
+        // Corner case: unaligned arrays, width one pixel smaller than the stride
+        _lv_draw_sw_blend_fill_dsc_t fill_dsc_cc = fill_dsc;
+        fill_dsc_cc.dest_buf = dest_array_align2;
+        fill_dsc_cc.dest_w = WIDTH - 1;
+        fill_dsc_cc.dest_h = HEIGHT - 1;
+        fill_dsc_cc.mask_buf = test_params->use_mask ? mask_array_align1 : NULL;
+        _lv_draw_sw_blend_image_dsc_t image_dsc_cc = image_dsc;
+        image_dsc_cc.dest_buf = dest_array_align2;
+        image_dsc_cc.dest_w = WIDTH - 1;
+        image_dsc_cc.dest_h = HEIGHT - 1;
+        image_dsc_cc.src_buf = src_array_align1;
+        image_dsc_cc.mask_buf = fill_dsc_cc.mask_buf;
+
+        ESP_LOGI(TAG_LV_BLEND_RGB565_BENCH, "running test for %s", test_params->name);
+
+        // Run benchmark 2 times:
+        // First run using assembly, second run using ANSI
+        for (int i = 0; i < 2; i++) {
+            float cycles = lv_blend_rgb565_benchmark_run(test_params, &fill_dsc, &image_dsc);
+            ESP_LOGI(TAG_LV_BLEND_RGB565_BENCH, " %s ideal case: %.3f cycles for %dx%d matrix, %.3f cycles per sample", asm_ansi_func[i],
+                     cycles, WIDTH, HEIGHT, cycles / (WIDTH * HEIGHT));
+
+            cycles = lv_blend_rgb565_benchmark_run(test_params, &fill_dsc_cc, &image_dsc_cc);
+            ESP_LOGI(TAG_LV_BLEND_RGB565_BENCH, " %s corner case: %.3f cycles for %dx%d matrix, %.3f cycles per sample\n", asm_ansi_func[i],
+                     cycles, WIDTH - 1, HEIGHT - 1, cycles / ((WIDTH - 1) * (HEIGHT - 1)));
+
+            // change to ANSI
+            fill_dsc.use_asm = false;
+            fill_dsc_cc.use_asm = false;
+            image_dsc.use_asm = false;
+            image_dsc_cc.use_asm = false;
+        }
+    }
+
+    free(dest_array_align16);
+    free(src_array_align16);
+    free(mask_array_align16);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static float lv_blend_rgb565_benchmark_run(const bench_test_case_lv_blend_rgb565_params_t *test_params,
+                                           _lv_draw_sw_blend_fill_dsc_t *fill_dsc, _lv_draw_sw_blend_image_dsc_t *image_dsc)
+{
+    const bool fill = (test_params->src_type == BLEND_SRC_COLOR);
+
+    // Call the DUT function for the first time to init the benchmark test
+    if (fill) {
+        lv_draw_sw_blend_color_to_rgb565(fill_dsc);
+    } else {
+        lv_draw_sw_blend_image_to_rgb565(image_dsc);
+    }
+
+    const unsigned int start_b = xthal_get_ccount();
+    for (int i = 0; i < BENCHMARK_CYCLES; i++) {
+        if (fill) {
+            lv_draw_sw_blend_color_to_rgb565(fill_dsc);
+        } else {
+            lv_draw_sw_blend_image_to_rgb565(image_dsc);
+        }
+    }
+    const unsigned int end_b = xthal_get_ccount();
+
+    const float total_b = end_b - start_b;
+    return total_b / BENCHMARK_CYCLES;
+}
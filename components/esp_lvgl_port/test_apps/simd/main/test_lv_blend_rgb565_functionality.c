@@ -0,0 +1,317 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_blend_rgb565_common.h"
+#include "lv_image_common.h"        // canary_pixels_t
+#include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_to_rgb565.h"
+
+// ------------------------------------------------- Defines -----------------------------------------------------------
+
+#define DBG_PRINT_OUTPUT false
+
+// The assembly kernels read the mask by bytes, as LVGL does
+_Static_assert(sizeof(lv_opa_t) == 1, "lv_opa_t must be a byte, the mask buffers are byte arrays");
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_BLEND_RGB565_FUNC = "LV Blend RGB565 Functionality";
+static char test_msg_buf[200];
+
+static const test_matrix_lv_blend_rgb565_params_t default_test_matrix_blend_rgb565 = {
+    .max_w = 16,                  // The kernels are pixel by pixel on both chips, 16 covers widths of all the row loops
+    .max_h = 3,
+    .max_padding = 3,
+    .dest_max_unalign_byte = 4,   // RGB565 destination is always 2-byte aligned
+    .src_max_unalign_byte = 3,    // Source and mask are read by bytes
+    .test_combinations_count = 0,
+};
+
+static const lv_color_t test_color = {
+    .blue = 0xE7,
+    .green = 0x3C,
+    .red = 0xA5,
+};
+
+// Opacities below LV_OPA_MAX select the _WITH_OPA and _MIX_MASK_OPA hooks, LV_OPA_COVER the normal and _WITH_MASK ones
+static const lv_opa_t test_opa[] = {LV_OPA_COVER, LV_OPA_TRANSP, 1, 8, LV_OPA_50, 200, LV_OPA_MAX - 1};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Generate all the functionality test combinations for one blend source
+ *
+ * @param[in] test_matrix Pointer to structure defining test matrix - all the test combinations
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void functionality_test_matrix(test_matrix_lv_blend_rgb565_params_t *test_matrix, func_test_case_lv_blend_rgb565_params_t *test_case);
+
+/**
+ * @brief Allocate and fill test buffers for the blend functionality test
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void fill_test_bufs(func_test_case_lv_blend_rgb565_params_t *test_case);
+
+/**
+ * @brief The actual functionality test
+ *
+ * - function prepares structures for functionality testing and runs the LVGL API
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void lv_blend_rgb565_functionality(func_test_case_lv_blend_rgb565_params_t *test_case);
+
+/**
+ * @brief Evaluate results of the blend functionality
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void test_eval_blend_rgb565(func_test_case_lv_blend_rgb565_params_t *test_case);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the assembly versions of the opacity / mask fills and the RGB888 / ARGB8888 image blends
+      achieve the same results as the ANSI versions, bit exact
+
+Procedure:
+    - Prepare testing matrix, to cover combinations of widths, heights, strides, memory alignments, opacities and masks
+    - Source, alpha and mask bytes cover the transparent (0), opaque (255) and in between values
+    - Run assembly version of the LVGL blending API
+    - Run ANSI C version of the LVGL blending API
+    - Compare the results, check the Canary pixels
+    - Repeat above 3 steps for each test matrix setup
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Blend functionality color blend to RGB565 with opa and mask", "[blend][functionality][RGB565]")
+{
+    test_matrix_lv_blend_rgb565_params_t test_matrix = default_test_matrix_blend_rgb565;
+    func_test_case_lv_blend_rgb565_params_t test_case = {
+        .src_type = BLEND_SRC_COLOR,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_BLEND_RGB565_FUNC, "running test for color fill");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Blend functionality RGB888 blend to RGB565", "[blend][functionality][RGB888]")
+{
+    test_matrix_lv_blend_rgb565_params_t test_matrix = default_test_matrix_blend_rgb565;
+    func_test_case_lv_blend_rgb565_params_t test_case = {
+        .src_type = BLEND_SRC_RGB888,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_BLEND_RGB565_FUNC, "running test for RGB888 color format");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Blend functionality ARGB8888 blend to RGB565", "[blend][functionality][ARGB8888]")
+{
+    test_matrix_lv_blend_rgb565_params_t test_matrix = default_test_matrix_blend_rgb565;
+    func_test_case_lv_blend_rgb565_params_t test_case = {
+        .src_type = BLEND_SRC_ARGB8888,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_BLEND_RGB565_FUNC, "running test for ARGB8888 color format");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void functionality_test_matrix(test_matrix_lv_blend_rgb565_params_t *test_matrix, func_test_case_lv_blend_rgb565_params_t *test_case)
+{
+    // Step opacity and mask, to select every hook
+    for (int opa_idx = 0; opa_idx < sizeof(test_opa) / sizeof(test_opa[0]); opa_idx++) {
+        for (int use_mask = 0; use_mask <= 1; use_mask++) {
+            test_case->opa = test_opa[opa_idx];
+            test_case->use_mask = use_mask;
+
+            // Step destination array width and height
+            for (int dest_w = 1; dest_w <= test_matrix->max_w; dest_w++) {
+                for (int dest_h = 1; dest_h <= test_matrix->max_h; dest_h++) {
+
+                    // Step the row padding of all the arrays
+                    for (int padding = 0; padding <= test_matrix->max_padding; padding += test_matrix->max_padding) {
+
+                        // Step source and mask array unalignment
+                        for (int src_unalign_byte = 0; src_unalign_byte <= test_matrix->src_max_unalign_byte; src_unalign_byte++) {
+
+                            // Step destination array unalignment
+                            for (int dest_unalign_byte = 0; dest_unalign_byte <= test_matrix->dest_max_unalign_byte; dest_unalign_byte += 2) {
+
+                                test_case->dest_w = dest_w;
+                                test_case->dest_h = dest_h;
+                                test_case->padding = padding;
+                                test_case->src_unalign_byte = src_unalign_byte;
+                                test_case->dest_unalign_byte = dest_unalign_byte;
+                                lv_blend_rgb565_functionality(test_case);
+                                test_matrix->test_combinations_count++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ESP_LOGI(TAG_LV_BLEND_RGB565_FUNC, "test combinations: %d\n", test_matrix->test_combinations_count);
+}
+
+static void lv_blend_rgb565_functionality(func_test_case_lv_blend_rgb565_params_t *test_case)
+{
+    fill_test_bufs(test_case);
+
+    const unsigned int stride = test_case->dest_w + test_case->padding;     // Stride of all the arrays in pixels
+    const unsigned int src_px_size = (test_case->src_type == BLEND_SRC_ARGB8888) ? 4 : 3;
+
+    if (test_case->src_type == BLEND_SRC_COLOR) {
+        _lv_draw_sw_blend_fill_dsc_t dsc_asm = {
+            .dest_buf = test_case->buf.p_dest_asm,
+            .dest_w = test_case->dest_w,
+            .dest_h = test_case->dest_h,
+            .dest_stride = stride * sizeof(uint16_t),
+            .mask_buf = test_case->buf.p_mask,
+            .mask_stride = stride,
+            .color = test_color,
+            .opa = test_case->opa,
+            .use_asm = true,
+        };
+
+        _lv_draw_sw_blend_fill_dsc_t dsc_ansi = dsc_asm;
+        dsc_ansi.dest_buf = test_case->buf.p_dest_ansi;
+        dsc_ansi.use_asm = false;
+
+        lv_draw_sw_blend_color_to_rgb565(&dsc_asm);     // Call the LVGL API with Assembly code
+        lv_draw_sw_blend_color_to_rgb565(&dsc_ansi);    // Call the LVGL API with ANSI code
+    } else {
+        _lv_draw_sw_blend_image_dsc_t dsc_asm = {
+            .dest_buf = test_case->buf.p_dest_asm,
+            .dest_w = test_case->dest_w,
+            .dest_h = test_case->dest_h,
+            .dest_stride = stride * sizeof(uint16_t),
+            .mask_buf = test_case->buf.p_mask,
+            .mask_stride = stride,
+            .src_buf = test_case->buf.p_src,
+            .src_stride = stride * src_px_size,
+            .src_color_format = (test_case->src_type == BLEND_SRC_ARGB8888) ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_RGB888,
+            .opa = test_case->opa,
+            .blend_mode = LV_BLEND_MODE_NORMAL,
+            .use_asm = true,
+        };
+
+        _lv_draw_sw_blend_image_dsc_t dsc_ansi = dsc_asm;
+        dsc_ansi.dest_buf = test_case->buf.p_dest_ansi;
+        dsc_ansi.use_asm = false;
+
+        lv_draw_sw_blend_image_to_rgb565(&dsc_asm);     // Call the LVGL API with Assembly code
+        lv_draw_sw_blend_image_to_rgb565(&dsc_ansi);    // Call the LVGL API with ANSI code
+    }
+
+    // Evaluate the results
+    sprintf(test_msg_buf, "Test case: src = %d, opa = %d, mask = %d, dest_w = %d, dest_h = %d, padding = %d, dest_unalign_byte = %d, src_unalign_byte = %d\n",
+            test_case->src_type, test_case->opa, test_case->use_mask, test_case->dest_w, test_case->dest_h, test_case->padding,
+            test_case->dest_unalign_byte, test_case->src_unalign_byte);
+#if DBG_PRINT_OUTPUT
+    printf("%s\n", test_msg_buf);
+#endif
+    test_eval_blend_rgb565(test_case);
+
+    // Free memory allocated for test buffers
+    free(test_case->buf.p_dest_asm_alloc);
+    free(test_case->buf.p_dest_ansi_alloc);
+    free(test_case->buf.p_src_alloc);
+    free(test_case->buf.p_mask_alloc);
+}
+
+static void fill_test_bufs(func_test_case_lv_blend_rgb565_params_t *test_case)
+{
+    const size_t canary_pixels = test_case->canary_pixels;
+    const unsigned int stride = test_case->dest_w + test_case->padding;
+    const size_t px_count = stride * test_case->dest_h;                     // Data part of all the buffers including matrix padding, in pixels
+    const size_t total_dest_len = px_count + (canary_pixels * 2);           // Destination buffer length including the Canary pixels
+    const size_t src_len = px_count * 4;                                     // Big enough for both source formats
+
+    // Allocate the destination arrays, the source array and the mask array
+    void *src_mem  = memalign(16, src_len + test_case->src_unalign_byte);
+    void *mask_mem = memalign(16, px_count * sizeof(lv_opa_t) + test_case->src_unalign_byte);
+    void *dest_mem_asm  = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    void *dest_mem_ansi = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    TEST_ASSERT_NOT_NULL_MESSAGE(src_mem, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(mask_mem, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_asm, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_ansi, "Lack of memory");
+
+    // Save a pointer to the beginning of the allocated memory which will be used to free()
+    test_case->buf.p_src_alloc = src_mem;
+    test_case->buf.p_mask_alloc = mask_mem;
+    test_case->buf.p_dest_asm_alloc = dest_mem_asm;
+    test_case->buf.p_dest_ansi_alloc = dest_mem_ansi;
+
+    // Apply the unalignment
+    uint8_t *src = (uint8_t *)src_mem + test_case->src_unalign_byte;
+    lv_opa_t *mask = (lv_opa_t *)((uint8_t *)mask_mem + test_case->src_unalign_byte);
+    uint16_t *dest_asm = (uint16_t *)((uint8_t *)dest_mem_asm + test_case->dest_unalign_byte);
+    uint16_t *dest_ansi = (uint16_t *)((uint8_t *)dest_mem_ansi + test_case->dest_unalign_byte);
+
+    // Canary pixels are 0, the data part gets the same known values in both destination buffers
+    memset(dest_asm, 0, total_dest_len * sizeof(uint16_t));
+    memset(dest_ansi, 0, total_dest_len * sizeof(uint16_t));
+    for (int i = 0; i < px_count; i++) {
+        dest_asm[canary_pixels + i] = i * 0x1F3D + ((i & 1) ? 0x6699 : 0x9966);
+        dest_ansi[canary_pixels + i] = dest_asm[canary_pixels + i];
+    }
+
+    // Opacity bytes (mask and ARGB8888 alpha) are transparent, opaque or in between
+    for (int i = 0; i < src_len; i++) {
+        src[i] = (uint8_t)(i * 73 + 29);
+    }
+    for (int i = 0; i < px_count; i++) {
+        const uint8_t opa_px = (i % 5 == 0) ? LV_OPA_TRANSP : (i % 5 == 1) ? LV_OPA_COVER : (uint8_t)(i * 37 + 11);
+        mask[i] = (i % 3 == 0) ? LV_OPA_COVER : opa_px;
+        src[i * 4 + 3] = opa_px;
+    }
+
+    // Save a pointer to the working part of the memory, where the test data are stored
+    test_case->buf.p_src = src;
+    test_case->buf.p_mask = test_case->use_mask ? mask : NULL;
+    test_case->buf.p_dest_asm = dest_asm + canary_pixels;
+    test_case->buf.p_dest_ansi = dest_ansi + canary_pixels;
+}
+
+static void test_eval_blend_rgb565(func_test_case_lv_blend_rgb565_params_t *test_case)
+{
+    const size_t canary_pixels = test_case->canary_pixels;
+    const size_t px_count = (test_case->dest_w + test_case->padding) * test_case->dest_h;
+
+#if DBG_PRINT_OUTPUT
+    printf("\nEval\nDestination buffers fill:\n");
+    for (uint32_t i = 0; i < px_count; i++) {
+        printf("dest_buf[%"PRIi32"] %s ansi = %8"PRIx16" \t asm = %8"PRIx16"   %s \n", i, ((i < 10) ? (" ") : ("")), test_case->buf.p_dest_ansi[i], test_case->buf.p_dest_asm[i], (test_case->buf.p_dest_ansi[i] == test_case->buf.p_dest_asm[i]) ? ("OK") : ("FAIL"));
+    }
+    printf("\n");
+#endif
+
+    // Canary pixels area must stay 0
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, test_case->buf.p_dest_asm - canary_pixels, canary_pixels, test_msg_buf);
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, test_case->buf.p_dest_asm + px_count, canary_pixels, test_msg_buf);
+
+    // dest_buf_asm and dest_buf_ansi must be equal, the matrix padding included
+    TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(test_case->buf.p_dest_ansi, test_case->buf.p_dest_asm, px_count, test_msg_buf);
+}
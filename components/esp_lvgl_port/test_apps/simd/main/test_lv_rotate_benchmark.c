@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "lv_rotate_common.h"
+#include "lv_draw_sw_rotate_rgb565.h"
+#include "esp_lvgl_port_simd.h"
+
+#define WIDTH 320           // One flush of a 320x240 panel with 1/10 screen draw buffers, before rotation
+#define HEIGHT 24
+#define BENCHMARK_CYCLES 100
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_ROTATE_BENCH = "LV Rotate Benchmark";
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the benchmark for one rotation
+ */
+static void lv_rotate_benchmark(bench_test_case_lv_rotate_params_t *test_params, rotation_t rotation, rotate_func_t rotate_func);
+
+/**
+ * @brief Hard copy of lv_draw_sw_rgb565_swap() ANSI part from LVGL v9.2, expects a 4-byte aligned buffer
+ */
+static void lv_draw_sw_rgb565_swap_ansi(void *buf, uint32_t buf_size_px);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that the tiled rotation, with the byte swap in the same pass, is faster than the flush callback did before:
+      lv_draw_sw_rotate() followed by lv_draw_sw_rgb565_swap()
+
+Procedure:
+    - Rotate a 320x24 pixels area (one partial flush) multiple times, for each rotation
+    - Count CPU cycles of the tiled rotation alone, the tiled rotation with the swap and the LVGL rotation with the swap
+*/
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Rotate benchmark RGB565", "[rotate][benchmark][RGB565]")
+{
+    uint16_t *src_array = (uint16_t *)memalign(16, WIDTH * HEIGHT * sizeof(uint16_t));
+    uint16_t *dest_array = (uint16_t *)memalign(16, WIDTH * HEIGHT * sizeof(uint16_t));
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array);
+
+    bench_test_case_lv_rotate_params_t test_params = {
+        .width = WIDTH,
+        .height = HEIGHT,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array = src_array,
+        .dest_array = dest_array,
+    };
+
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, "running test for RGB565 rotation of %dx%d pixels", WIDTH, HEIGHT);
+    lv_rotate_benchmark(&test_params, ROTATION_90, &lvgl_port_rotate90_rgb565);
+    lv_rotate_benchmark(&test_params, ROTATION_180, &lvgl_port_rotate180_rgb565);
+    lv_rotate_benchmark(&test_params, ROTATION_270, &lvgl_port_rotate270_rgb565);
+
+    free(src_array);
+    free(dest_array);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_rotate_benchmark(bench_test_case_lv_rotate_params_t *test_params, rotation_t rotation, rotate_func_t rotate_func)
+{
+    const int32_t w = test_params->width;
+    const int32_t h = test_params->height;
+    const int32_t src_stride = w * sizeof(uint16_t);
+    const int32_t dest_stride = ((rotation == ROTATION_180) ? w : h) * sizeof(uint16_t);
+    const float px = (float)(w * h);
+    float cycles[3];
+
+    // Tiled, without and with the swap
+    for (int swap = 0; swap < 2; swap++) {
+        rotate_func(test_params->src_array, test_params->dest_array, w, h, src_stride, dest_stride, swap);    // Init run
+        const unsigned int start_b = xthal_get_ccount();
+        for (int i = 0; i < test_params->benchmark_cycles; i++) {
+            rotate_func(test_params->src_array, test_params->dest_array, w, h, src_stride, dest_stride, swap);
+        }
+        const unsigned int end_b = xthal_get_ccount();
+        cycles[swap] = (float)(end_b - start_b) / test_params->benchmark_cycles;
+    }
+
+    // LVGL rotation and a separate swap pass
+    lv_draw_sw_rotate_rgb565(test_params->src_array, test_params->dest_array, w, h, src_stride, dest_stride, rotation);
+    const unsigned int start_b = xthal_get_ccount();
+    for (int i = 0; i < test_params->benchmark_cycles; i++) {
+        lv_draw_sw_rotate_rgb565(test_params->src_array, test_params->dest_array, w, h, src_stride, dest_stride, rotation);
+        lv_draw_sw_rgb565_swap_ansi(test_params->dest_array, w * h);
+    }
+    const unsigned int end_b = xthal_get_ccount();
+    cycles[2] = (float)(end_b - start_b) / test_params->benchmark_cycles;
+
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, " %d deg tiled: %.3f cycles, %.3f cycles per sample", rotation * 90, cycles[0], cycles[0] / px);
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, " %d deg tiled + swap: %.3f cycles, %.3f cycles per sample", rotation * 90, cycles[1], cycles[1] / px);
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, " %d deg ANSI + swap: %.3f cycles, %.3f cycles per sample\n", rotation * 90, cycles[2], cycles[2] / px);
+}
+
+static void lv_draw_sw_rgb565_swap_ansi(void *buf, uint32_t buf_size_px)
+{
+    uint32_t u32_cnt = buf_size_px / 2;
+    uint16_t *buf16 = buf;
+    uint32_t *buf32 = buf;
+
+    while (u32_cnt >= 8) {
+        buf32[0] = ((buf32[0] & 0xff00ff00) >> 8) | ((buf32[0] & 0x00ff00ff) << 8);
+        buf32[1] = ((buf32[1] & 0xff00ff00) >> 8) | ((buf32[1] & 0x00ff00ff) << 8);
+        buf32[2] = ((buf32[2] & 0xff00ff00) >> 8) | ((buf32[2] & 0x00ff00ff) << 8);
+        buf32[3] = ((buf32[3] & 0xff00ff00) >> 8) | ((buf32[3] & 0x00ff00ff) << 8);
+        buf32[4] = ((buf32[4] & 0xff00ff00) >> 8) | ((buf32[4] & 0x00ff00ff) << 8);
+        buf32[5] = ((buf32[5] & 0xff00ff00) >> 8) | ((buf32[5] & 0x00ff00ff) << 8);
+        buf32[6] = ((buf32[6] & 0xff00ff00) >> 8) | ((buf32[6] & 0x00ff00ff) << 8);
+        buf32[7] = ((buf32[7] & 0xff00ff00) >> 8) | ((buf32[7] & 0x00ff00ff) << 8);
+        buf32 += 8;
+        u32_cnt -= 8;
+    }
+
+    while (u32_cnt) {
+        *buf32 = ((*buf32 & 0xff00ff00) >> 8) | ((*buf32 & 0x00ff00ff) << 8);
+        buf32++;
+        u32_cnt--;
+    }
+
+    if (buf_size_px & 0x1) {
+        uint32_t e = buf_size_px - 1;
+        buf16[e] = ((buf16[e] & 0xff00) >> 8) | ((buf16[e] & 0x00ff) << 8);
+    }
+}
@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_rotate_common.h"
+#include "lv_image_common.h"        // canary_pixels_t
+#include "lv_draw_sw_rotate_rgb565.h"
+#include "esp_lvgl_port_simd.h"
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_ROTATE_FUNC = "LV Rotate Functionality";
+static char test_msg_buf[200];
+
+static const test_matrix_lv_rotate_params_t default_test_matrix_rotate_rgb565 = {
+    .min_w = 1,
+    .min_h = 1,
+    .max_w = 35,                  // More than 2 tiles, with a partial one
+    .max_h = 35,
+    .max_padding = 2,
+    .dest_max_unalign_byte = 2,   // Pixel pairs are stored as 32-bit words, check a 2-byte aligned destination too
+    .test_combinations_count = 0,
+};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Generate all the functionality test combinations
+ *
+ * @param[in] test_matrix Pointer to structure defining test matrix - all the test combinations
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void functionality_test_matrix(test_matrix_lv_rotate_params_t *test_matrix, func_test_case_lv_rotate_params_t *test_case);
+
+/**
+ * @brief The actual functionality test
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void lv_rotate_functionality(func_test_case_lv_rotate_params_t *test_case);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the tiled rotation used by the flush callback achieves the same results as lv_draw_sw_rotate(),
+      followed by lv_draw_sw_rgb565_swap() when the bytes are swapped in the same pass
+
+Procedure:
+    - Prepare testing matrix, to cover widths and heights around the tile size, strides and destination alignment
+    - Run the tiled rotation
+    - Run the hard copy of the LVGL rotation, swap the bytes of the result
+    - Compare the results, Canary pixels around the destination buffer and matrix padding must stay untouched
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Rotate functionality RGB565 90", "[rotate][functionality][RGB565]")
+{
+    test_matrix_lv_rotate_params_t test_matrix = default_test_matrix_rotate_rgb565;
+    func_test_case_lv_rotate_params_t test_case = {
+        .rotation = ROTATION_90,
+        .rotate_func = &lvgl_port_rotate90_rgb565,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB565 rotation by 90 degrees");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Rotate functionality RGB565 180", "[rotate][functionality][RGB565]")
+{
+    test_matrix_lv_rotate_params_t test_matrix = default_test_matrix_rotate_rgb565;
+    func_test_case_lv_rotate_params_t test_case = {
+        .rotation = ROTATION_180,
+        .rotate_func = &lvgl_port_rotate180_rgb565,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB565 rotation by 180 degrees");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Rotate functionality RGB565 270", "[rotate][functionality][RGB565]")
+{
+    test_matrix_lv_rotate_params_t test_matrix = default_test_matrix_rotate_rgb565;
+    func_test_case_lv_rotate_params_t test_case = {
+        .rotation = ROTATION_270,
+        .rotate_func = &lvgl_port_rotate270_rgb565,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB565 rotation by 270 degrees");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void functionality_test_matrix(test_matrix_lv_rotate_params_t *test_matrix, func_test_case_lv_rotate_params_t *test_case)
+{
+    const bool transpose = (test_case->rotation != ROTATION_180);
+
+    // Step source array width
+    for (int src_w = test_matrix->min_w; src_w <= test_matrix->max_w; src_w++) {
+
+        // Step source array height
+        for (int src_h = test_matrix->min_h; src_h <= test_matrix->max_h; src_h++) {
+
+            // Step matrix padding
+            for (int padding = 0; padding <= test_matrix->max_padding; padding++) {
+
+                // Step destination array unalignment
+                for (int dest_unalign_byte = 0; dest_unalign_byte <= test_matrix->dest_max_unalign_byte; dest_unalign_byte += 2) {
+
+                    // Without and with the byte swap
+                    for (int swap = 0; swap < 2; swap++) {
+                        test_case->src_w = src_w;
+                        test_case->src_h = src_h;
+                        test_case->src_stride = src_w + padding;
+                        test_case->dest_w = transpose ? src_h : src_w;
+                        test_case->dest_h = transpose ? src_w : src_h;
+                        test_case->dest_stride = test_case->dest_w + padding;
+                        test_case->dest_unalign_byte = dest_unalign_byte;
+                        test_case->swap_bytes = swap;
+                        lv_rotate_functionality(test_case);
+                        test_matrix->test_combinations_count++;
+                    }
+                }
+            }
+        }
+    }
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "test combinations: %d\n", test_matrix->test_combinations_count);
+}
+
+static void lv_rotate_functionality(func_test_case_lv_rotate_params_t *test_case)
+{
+    const size_t canary_pixels = test_case->canary_pixels;
+    const size_t src_len = test_case->src_h * test_case->src_stride;
+    const size_t dest_len = test_case->dest_h * test_case->dest_stride;
+    const size_t total_dest_len = dest_len + canary_pixels * 2;
+
+    // Allocate destination arrays and source array
+    uint16_t *src = (uint16_t *)memalign(16, src_len * sizeof(uint16_t));
+    void *dest_mem_tiled = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    void *dest_mem_ansi = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    TEST_ASSERT_NOT_NULL_MESSAGE(src, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_tiled, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_ansi, "Lack of memory");
+
+    // Apply destination array unalignment, set the whole destination buffer to 0, including the Canary pixels part
+    uint16_t *dest_tiled = (uint16_t *)((uint8_t *)dest_mem_tiled + test_case->dest_unalign_byte);
+    uint16_t *dest_ansi = (uint16_t *)((uint8_t *)dest_mem_ansi + test_case->dest_unalign_byte);
+    memset(dest_tiled, 0, total_dest_len * sizeof(uint16_t));
+    memset(dest_ansi, 0, total_dest_len * sizeof(uint16_t));
+    dest_tiled += canary_pixels;
+    dest_ansi += canary_pixels;
+
+    for (int i = 0; i < src_len; i++) {
+        src[i] = i + ((i & 1) ? 0x55AA : 0xA51F);
+    }
+
+    test_case->rotate_func(src, dest_tiled, test_case->src_w, test_case->src_h,
+                           test_case->src_stride * sizeof(uint16_t), test_case->dest_stride * sizeof(uint16_t), test_case->swap_bytes);
+    lv_draw_sw_rotate_rgb565(src, dest_ansi, test_case->src_w, test_case->src_h,
+                             test_case->src_stride * sizeof(uint16_t), test_case->dest_stride * sizeof(uint16_t), test_case->rotation);
+
+    // Swap the bytes of the reference, matrix padding included, the tiled version must leave it 0
+    if (test_case->swap_bytes) {
+        for (int i = 0; i < dest_len; i++) {
+            dest_ansi[i] = (uint16_t)((dest_ansi[i] >> 8) | (dest_ansi[i] << 8));
+        }
+    }
+
+    sprintf(test_msg_buf, "Test case: rotation = %d, src_w = %d, src_h = %d, src_stride = %d, dest_stride = %d, dest_unalign_byte = %d, swap = %d\n",
+            test_case->rotation * 90, test_case->src_w, test_case->src_h, test_case->src_stride, test_case->dest_stride, test_case->dest_unalign_byte, test_case->swap_bytes);
+
+    // Canary pixels area must stay 0
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, dest_tiled - canary_pixels, canary_pixels, test_msg_buf);
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, dest_tiled + dest_len, canary_pixels, test_msg_buf);
+
+    // dest_tiled and dest_ansi must be equal, matrix padding included
+    TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_ansi, dest_tiled, dest_len, test_msg_buf);
+
+    free(src);
+    free(dest_mem_tiled);
+    free(dest_mem_ansi);
+}
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "lv_swap_common.h"
+#include "esp_lvgl_port_simd.h"
+
+#define COMMON_DIM 128      // Common matrix dimension 128x128 pixels
+#define LEN (COMMON_DIM * COMMON_DIM)
+#define UNALIGN_BYTES 4     // LVGL draw buffers are at least 4-byte aligned
+#define BENCHMARK_CYCLES 1000
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_SWAP_BENCH = "LV Swap Benchmark";
+static const char *asm_ansi_func[] = {"ASM", "ANSI"};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the benchmark test
+ */
+static float lv_swap_benchmark_run(bench_test_case_lv_swap_params_t *test_params, uint16_t *buf, uint32_t len, bool use_asm);
+
+/**
+ * @brief Hard copy of lv_draw_sw_rgb565_swap() ANSI part from LVGL v9.2, expects a 4-byte aligned buffer
+ */
+static void lv_draw_sw_rgb565_swap_ansi(void *buf, uint32_t buf_size_px);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that an acceleration is achieved by the assembly RGB565 swap over lv_draw_sw_rgb565_swap()
+
+Procedure:
+    - Swap a 128x128 pixels buffer in place, like the flush callback does, multiple times (1000-times or so)
+    - Firstly use a 16-byte aligned buffer with an even length (the most ideal case)
+    - Then use a 4-byte aligned buffer with an odd length, head and tail are swapped by the scalar code (worst case of LVGL draw buffers)
+    - Count how many CPU cycles does it take for each case, for assembly and ANSI version
+*/
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Swap benchmark RGB565", "[swap][benchmark][RGB565]")
+{
+    uint16_t *array_align16 = (uint16_t *)memalign(16, LEN * sizeof(uint16_t) + UNALIGN_BYTES);
+    TEST_ASSERT_NOT_EQUAL(NULL, array_align16);
+
+    bench_test_case_lv_swap_params_t test_params = {
+        .len = LEN,
+        .cc_len = LEN - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .array_align16 = array_align16,
+        .array_align4 = (uint16_t *)((uint8_t *)array_align16 + UNALIGN_BYTES),
+    };
+
+    ESP_LOGI(TAG_LV_SWAP_BENCH, "running test for RGB565 swap in place");
+
+    // Run benchmark 2 times:
+    // First run using assembly, second run using ANSI
+    for (int i = 0; i < 2; i++) {
+        const bool use_asm = (i == 0);
+
+        // Run benchmark with the most ideal input parameters
+        float cycles = lv_swap_benchmark_run(&test_params, test_params.array_align16, test_params.len, use_asm);
+        float per_sample = cycles / ((float)test_params.len);
+        ESP_LOGI(TAG_LV_SWAP_BENCH, " %s ideal case: %.3f cycles for %u pixels, %.3f cycles per sample", asm_ansi_func[i], cycles, test_params.len, per_sample);
+
+        // Run benchmark with the corner case input parameters
+        cycles = lv_swap_benchmark_run(&test_params, test_params.array_align4, test_params.cc_len, use_asm);
+        per_sample = cycles / ((float)test_params.cc_len);
+        ESP_LOGI(TAG_LV_SWAP_BENCH, " %s corner case: %.3f cycles for %u pixels, %.3f cycles per sample\n", asm_ansi_func[i], cycles, test_params.cc_len, per_sample);
+    }
+
+    free(array_align16);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static float lv_swap_benchmark_run(bench_test_case_lv_swap_params_t *test_params, uint16_t *buf, uint32_t len, bool use_asm)
+{
+    // Call the DUT function for the first time to init the benchmark test
+    if (use_asm) {
+        lv_rgb565_swap_esp(buf, buf, len);
+    } else {
+        lv_draw_sw_rgb565_swap_ansi(buf, len);
+    }
+
+    const unsigned int start_b = xthal_get_ccount();
+    if (use_asm) {
+        for (int i = 0; i < test_params->benchmark_cycles; i++) {
+            lv_rgb565_swap_esp(buf, buf, len);
+        }
+    } else {
+        for (int i = 0; i < test_params->benchmark_cycles; i++) {
+            lv_draw_sw_rgb565_swap_ansi(buf, len);
+        }
+    }
+    const unsigned int end_b = xthal_get_ccount();
+
+    const float total_b = end_b - start_b;
+    const float cycles = total_b / (test_params->benchmark_cycles);
+    return cycles;
+}
+
+static void lv_draw_sw_rgb565_swap_ansi(void *buf, uint32_t buf_size_px)
+{
+    uint32_t u32_cnt = buf_size_px / 2;
+    uint16_t *buf16 = buf;
+    uint32_t *buf32 = buf;
+
+    while (u32_cnt >= 8) {
+        buf32[0] = ((buf32[0] & 0xff00ff00) >> 8) | ((buf32[0] & 0x00ff00ff) << 8);
+        buf32[1] = ((buf32[1] & 0xff00ff00) >> 8) | ((buf32[1] & 0x00ff00ff) << 8);
+        buf32[2] = ((buf32[2] & 0xff00ff00) >> 8) | ((buf32[2] & 0x00ff00ff) << 8);
+        buf32[3] = ((buf32[3] & 0xff00ff00) >> 8) | ((buf32[3] & 0x00ff00ff) << 8);
+        buf32[4] = ((buf32[4] & 0xff00ff00) >> 8) | ((buf32[4] & 0x00ff00ff) << 8);
+        buf32[5] = ((buf32[5] & 0xff00ff00) >> 8) | ((buf32[5] & 0x00ff00ff) << 8);
+        buf32[6] = ((buf32[6] & 0xff00ff00) >> 8) | ((buf32[6] & 0x00ff00ff) << 8);
+        buf32[7] = ((buf32[7] & 0xff00ff00) >> 8) | ((buf32[7] & 0x00ff00ff) << 8);
+        buf32 += 8;
+        u32_cnt -= 8;
+    }
+
+    while (u32_cnt) {
+        *buf32 = ((*buf32 & 0xff00ff00) >> 8) | ((*buf32 & 0x00ff00ff) << 8);
+        buf32++;
+        u32_cnt--;
+    }
+
+    if (buf_size_px & 0x1) {
+        uint32_t e = buf_size_px - 1;
+        buf16[e] = ((buf16[e] & 0xff00) >> 8) | ((buf16[e] & 0x00ff) << 8);
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_swap_common.h"
+#include "lv_image_common.h"        // canary_pixels_t
+#include "esp_lvgl_port_simd.h"
+
+// ------------------------------------------------- Defines -----------------------------------------------------------
+
+#define DBG_PRINT_OUTPUT false
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_SWAP_FUNC = "LV Swap Functionality";
+static char test_msg_buf[200];
+
+static const test_matrix_lv_swap_params_t default_test_matrix_rgb565_swap = {
+#if CONFIG_IDF_TARGET_ESP32S3
+    .max_len = 56,                // Covers the head, both main loop runs, the remaining 8 pixels and the tail
+    .src_max_unalign_byte = 16,   // Use 16-byte boundary check for Xtensa PIE
+    .dest_max_unalign_byte = 16,
+#else
+    .max_len = 24,
+    .src_max_unalign_byte = 4,    // Use 4-byte boundary check for Xtensa base
+    .dest_max_unalign_byte = 4,
+#endif
+    .min_len = 0,
+    .unalign_step = 2,
+    .test_combinations_count = 0,
+};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Generate all the functionality test combinations
+ *
+ * @param[in] test_matrix Pointer to structure defining test matrix - all the test combinations
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void functionality_test_matrix(test_matrix_lv_swap_params_t *test_matrix, func_test_case_lv_swap_params_t *test_case);
+
+/**
+ * @brief Allocate and fill test buffers for swap functionality test
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void fill_test_bufs(func_test_case_lv_swap_params_t *test_case);
+
+/**
+ * @brief The actual functionality test
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void lv_swap_functionality(func_test_case_lv_swap_params_t *test_case);
+
+/**
+ * @brief ANSI reference, pixel by pixel
+ */
+static void rgb565_swap_ansi(const uint16_t *src, uint16_t *dest, uint32_t len);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the assembly RGB565 byte swap, used by the flush callback, achieves the same results as the ANSI version
+
+Procedure:
+    - Prepare testing matrix, to cover all the lengths and source / destination memory alignments
+    - Run assembly version of the swap, in place and from a source buffer
+    - Run ANSI C version of the swap
+    - Compare the results, Canary pixels around the destination buffer must stay untouched
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Swap functionality RGB565 in place", "[swap][functionality][RGB565]")
+{
+    test_matrix_lv_swap_params_t test_matrix = default_test_matrix_rgb565_swap;
+    test_matrix.src_max_unalign_byte = 0;    // Source is the destination
+
+    func_test_case_lv_swap_params_t test_case = {
+        .in_place = true,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_SWAP_FUNC, "running test for RGB565 swap in place");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Swap functionality RGB565 to a separate buffer", "[swap][functionality][RGB565]")
+{
+    test_matrix_lv_swap_params_t test_matrix = default_test_matrix_rgb565_swap;
+
+    func_test_case_lv_swap_params_t test_case = {
+        .in_place = false,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+    };
+
+    ESP_LOGI(TAG_LV_SWAP_FUNC, "running test for RGB565 swap to a separate buffer");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void functionality_test_matrix(test_matrix_lv_swap_params_t *test_matrix, func_test_case_lv_swap_params_t *test_case)
+{
+    // Step array length
+    for (int len = test_matrix->min_len; len <= test_matrix->max_len; len++) {
+
+        // Step source array unalignment
+        for (int src_unalign_byte = 0; src_unalign_byte <= test_matrix->src_max_unalign_byte; src_unalign_byte += test_matrix->unalign_step) {
+
+            // Step destination array unalignment
+            for (int dest_unalign_byte = 0; dest_unalign_byte <= test_matrix->dest_max_unalign_byte; dest_unalign_byte += test_matrix->unalign_step) {
+
+                test_case->len = len;
+                test_case->src_unalign_byte = src_unalign_byte;
+                test_case->dest_unalign_byte = dest_unalign_byte;
+                lv_swap_functionality(test_case);
+                test_matrix->test_combinations_count++;
+            }
+        }
+    }
+    ESP_LOGI(TAG_LV_SWAP_FUNC, "test combinations: %d\n", test_matrix->test_combinations_count);
+}
+
+static void lv_swap_functionality(func_test_case_lv_swap_params_t *test_case)
+{
+    fill_test_bufs(test_case);
+
+    const size_t canary_pixels = test_case->canary_pixels;
+    const size_t len = test_case->len;
+
+    if (test_case->in_place) {
+        lv_rgb565_swap_esp(test_case->buf.p_dest_asm, test_case->buf.p_dest_asm, len);
+        rgb565_swap_ansi(test_case->buf.p_dest_ansi, test_case->buf.p_dest_ansi, len);
+    } else {
+        lv_rgb565_swap_esp(test_case->buf.p_src, test_case->buf.p_dest_asm, len);
+        rgb565_swap_ansi(test_case->buf.p_src, test_case->buf.p_dest_ansi, len);
+    }
+
+    sprintf(test_msg_buf, "Test case: len = %d, in_place = %d, dest_unalign_byte = %d, src_unalign_byte = %d\n",
+            (int)len, test_case->in_place, test_case->dest_unalign_byte, test_case->src_unalign_byte);
+#if DBG_PRINT_OUTPUT
+    printf("%s\n", test_msg_buf);
+    for (uint32_t i = 0; i < len; i++) {
+        printf("dest_buf[%"PRIi32"] %s ansi = %8"PRIx16" \t asm = %8"PRIx16" \n", i, ((i < 10) ? (" ") : ("")), test_case->buf.p_dest_ansi[i], test_case->buf.p_dest_asm[i]);
+    }
+#endif
+
+    // Canary pixels area must stay 0
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, test_case->buf.p_dest_asm - canary_pixels, canary_pixels, test_msg_buf);
+    TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, test_case->buf.p_dest_asm + len, canary_pixels, test_msg_buf);
+
+    // dest_buf_asm and dest_buf_ansi must be equal
+    if (len > 0) {
+        TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(test_case->buf.p_dest_ansi, test_case->buf.p_dest_asm, len, test_msg_buf);
+    }
+
+    // Source buffer must stay untouched when not swapping in place
+    if (!test_case->in_place) {
+        for (uint32_t i = 0; i < len; i++) {
+            TEST_ASSERT_EQUAL_UINT16_MESSAGE(i + ((i & 1) ? 0x55AA : 0xA51F), test_case->buf.p_src[i], test_msg_buf);
+        }
+    }
+
+    // Free memory allocated for test buffers
+    free(test_case->buf.p_dest_asm_alloc);
+    free(test_case->buf.p_dest_ansi_alloc);
+    free(test_case->buf.p_src_alloc);
+}
+
+static void fill_test_bufs(func_test_case_lv_swap_params_t *test_case)
+{
+    const size_t canary_pixels = test_case->canary_pixels;
+    const size_t total_dest_len = test_case->len + canary_pixels * 2;
+
+    // Allocate destination arrays and source array
+    void *src_mem = memalign(16, test_case->len * sizeof(uint16_t) + test_case->src_unalign_byte + 16);
+    void *dest_mem_asm = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    void *dest_mem_ansi = memalign(16, total_dest_len * sizeof(uint16_t) + test_case->dest_unalign_byte);
+    TEST_ASSERT_NOT_NULL_MESSAGE(src_mem, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_asm, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_mem_ansi, "Lack of memory");
+
+    test_case->buf.p_src_alloc = src_mem;
+    test_case->buf.p_dest_asm_alloc = dest_mem_asm;
+    test_case->buf.p_dest_ansi_alloc = dest_mem_ansi;
+
+    // Apply destination and source array unalignment
+    uint16_t *src = (uint16_t *)((uint8_t *)src_mem + test_case->src_unalign_byte);
+    uint16_t *dest_asm = (uint16_t *)((uint8_t *)dest_mem_asm + test_case->dest_unalign_byte);
+    uint16_t *dest_ansi = (uint16_t *)((uint8_t *)dest_mem_ansi + test_case->dest_unalign_byte);
+
+    // Set the whole destination buffer to 0, including the Canary pixels part
+    memset(dest_asm, 0, total_dest_len * sizeof(uint16_t));
+    memset(dest_ansi, 0, total_dest_len * sizeof(uint16_t));
+
+    // Shift array pointers by Canary pixels amount forward
+    dest_asm += canary_pixels;
+    dest_ansi += canary_pixels;
+
+    // Fill with known values, the source with different ones so an accidental copy shows up
+    for (int i = 0; i < test_case->len; i++) {
+        src[i] = i + ((i & 1) ? 0x55AA : 0xA51F);
+        dest_asm[i] = test_case->in_place ? src[i] : (i + ((i & 1) ? 0x6699 : 0x9966));
+        dest_ansi[i] = dest_asm[i];
+    }
+
+    test_case->buf.p_src = src;
+    test_case->buf.p_dest_asm = dest_asm;
+    test_case->buf.p_dest_ansi = dest_ansi;
+}
+
+static void rgb565_swap_ansi(const uint16_t *src, uint16_t *dest, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        dest[i] = (uint16_t)((src[i] >> 8) | (src[i] << 8));
+    }
+}
@@ -26,6 +26,8 @@
 #define SSD1681_LUT_SIZE                   159
 #define SSD1681_EPD_1IN54_V2_WIDTH         200
 #define SSD1681_EPD_1IN54_V2_HEIGHT        200
+#define SSD1681_VRAM_ROW_BYTES             (SSD1681_EPD_1IN54_V2_WIDTH / 8)
+#define SSD1681_VRAM_SIZE                  (SSD1681_VRAM_ROW_BYTES * SSD1681_EPD_1IN54_V2_HEIGHT)
 
 
 static const char *TAG = "lcd_panel.epaper";
@@ -61,6 +63,22 @@ typedef struct {
     bool _mirror_x;
     uint8_t *_framebuffer;
     bool _invert_color;
+    // --- Waveform LUTs
+    uint8_t _full_lut[SSD1681_LUT_SIZE];
+    bool _has_full_lut;             // Custom LUT for full refresh, or the built-in one
+    uint8_t _partial_lut[SSD1681_LUT_SIZE];
+    bool _has_partial_lut;          // Custom LUT for partial refresh, or DISPLAY Mode 2 of the OTP
+    bool _partial_lut_loaded;       // LUT register doesn't hold the full refresh LUT
+    // --- Partial refresh mode
+    bool _partial_refresh;
+    uint32_t _full_refresh_period;  // Partial refreshes between two full refreshes, 0 for no limit
+    uint32_t _partial_refresh_cnt;
+    uint8_t *_vram_copy;            // Copy of the BLACK VRAM, in VRAM layout
+    bool _vram_copy_valid;
+    int _drawn_y_start;             // Rows drawn since the last refresh
+    int _drawn_y_end;
+    int _old_y_start;               // Rows refreshed, but not written to the RED VRAM (old frame) yet
+    int _old_y_end;
 } epaper_panel_t;
 
 // --- Utility functions
@@ -74,6 +92,14 @@ static esp_err_t epaper_set_lut(esp_lcd_panel_io_handle_t io, const uint8_t *lut
 static esp_err_t epaper_set_cursor(esp_lcd_panel_io_handle_t io, uint32_t cur_x, uint32_t cur_y);
 static esp_err_t epaper_set_area(esp_lcd_panel_io_handle_t io, uint32_t start_x, uint32_t start_y, uint32_t end_x, uint32_t end_y);
 static esp_err_t panel_epaper_set_vram(esp_lcd_panel_io_handle_t io, uint8_t *bw_bitmap, uint8_t *red_bitmap, size_t size);
+// --- Partial refresh mode
+static esp_err_t epaper_load_full_lut(esp_lcd_panel_t *panel);
+static esp_err_t epaper_full_lut_loaded(esp_lcd_panel_t *panel);
+static esp_err_t epaper_load_partial_lut(esp_lcd_panel_t *panel);
+static bool epaper_diff_area(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y,
+                             int *row_first, int *row_last, int *col_first, int *col_last);
+static esp_err_t epaper_draw_changed(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y);
+static esp_err_t epaper_write_old_frame(epaper_panel_t *epaper_panel);
 // --- SSD1681 specific functions, exported to user in public header file
 // extern esp_err_t esp_lcd_new_panel_ssd1681(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config,
 //                                            esp_lcd_panel_handle_t *ret_panel);
@@ -81,6 +107,8 @@ static esp_err_t panel_epaper_set_vram(esp_lcd_panel_io_handle_t io, uint8_t *bw
 // extern esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel);
 // extern esp_err_t epaper_panel_set_bitmap_color(esp_lcd_panel_t* panel, esp_lcd_ssd1681_bitmap_color_t color);
 // extern esp_err_t epaper_panel_set_custom_lut(esp_lcd_panel_t *panel, uint8_t *lut, size_t size);
+// extern esp_err_t epaper_panel_set_partial_refresh(esp_lcd_panel_t *panel, bool enable, const uint8_t *lut, size_t size,
+//                                                   uint32_t full_refresh_period);
 // --- Used to implement esp_lcd_panel_interface
 static esp_err_t epaper_panel_del(esp_lcd_panel_t *panel);
 static esp_err_t epaper_panel_reset(esp_lcd_panel_t *panel);
@@ -121,7 +149,46 @@ esp_err_t epaper_panel_set_custom_lut(esp_lcd_panel_t *panel, uint8_t *lut, size
     ESP_RETURN_ON_FALSE(lut, ESP_ERR_INVALID_ARG, TAG, "lut is NULL");
     ESP_RETURN_ON_FALSE(size == SSD1681_LUT_SIZE, ESP_ERR_INVALID_ARG, TAG, "Invalid lut size");
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    // Kept for the full refreshes of partial refresh mode, which load their own LUT in between
+    memcpy(epaper_panel->_full_lut, lut, SSD1681_LUT_SIZE);
+    epaper_panel->_has_full_lut = true;
     epaper_set_lut(epaper_panel->io, lut);
+    return epaper_full_lut_loaded(panel);
+}
+
+esp_err_t epaper_panel_set_partial_refresh(esp_lcd_panel_t *panel, bool enable, const uint8_t *lut, size_t size,
+        uint32_t full_refresh_period)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
+    ESP_RETURN_ON_FALSE(!lut || (size == SSD1681_LUT_SIZE), ESP_ERR_INVALID_ARG, TAG, "Invalid lut size");
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    if (!enable) {
+        epaper_panel->_partial_refresh = false;
+        free(epaper_panel->_vram_copy);
+        epaper_panel->_vram_copy = NULL;
+        return ESP_OK;
+    }
+    // --- Copy of the BLACK VRAM, diffed with the next bitmaps and written to the RED VRAM as the old frame
+    if (epaper_panel->_vram_copy == NULL) {
+        epaper_panel->_vram_copy = heap_caps_calloc(1, SSD1681_VRAM_SIZE, MALLOC_CAP_DMA);
+        ESP_RETURN_ON_FALSE(epaper_panel->_vram_copy, ESP_ERR_NO_MEM, TAG, "epaper_panel_set_partial_refresh allocating buffer memory err");
+    }
+    epaper_panel->_has_partial_lut = (lut != NULL);
+    if (lut) {
+        memcpy(epaper_panel->_partial_lut, lut, SSD1681_LUT_SIZE);
+    }
+    // Reload the partial LUT, it may have changed
+    epaper_panel->_partial_lut_loaded = false;
+    epaper_panel->_full_refresh_period = full_refresh_period;
+    epaper_panel->_partial_refresh_cnt = 0;
+    // The VRAM content is unknown until the next full refresh, which the whole screen should be drawn for
+    epaper_panel->_vram_copy_valid = false;
+    epaper_panel->full_refresh = true;
+    epaper_panel->_drawn_y_start = SSD1681_EPD_1IN54_V2_HEIGHT;
+    epaper_panel->_drawn_y_end = -1;
+    epaper_panel->_old_y_start = SSD1681_EPD_1IN54_V2_HEIGHT;
+    epaper_panel->_old_y_end = -1;
+    epaper_panel->_partial_refresh = true;
     return ESP_OK;
 }
 
@@ -213,9 +280,38 @@ esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel)
 {
     ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    bool partial = false;
+    if (epaper_panel->_partial_refresh) {
+        // Refreshed twice without drawing in between, the RED VRAM may still hold the frame before
+        ESP_RETURN_ON_ERROR(epaper_write_old_frame(epaper_panel), TAG, "epaper_write_old_frame() error");
+        // Full refresh first and every full_refresh_period partial refreshes, to clear the ghosting
+        partial = !(epaper_panel->full_refresh) &&
+                  ((epaper_panel->_full_refresh_period == 0) || (epaper_panel->_partial_refresh_cnt < epaper_panel->_full_refresh_period));
+    }
+    if (partial) {
+        ESP_RETURN_ON_ERROR(epaper_load_partial_lut(panel), TAG, "epaper_load_partial_lut() error");
+        epaper_panel->_partial_refresh_cnt++;
+        // The rows drawn are the new old frame
+        epaper_panel->_old_y_start = epaper_panel->_drawn_y_start;
+        epaper_panel->_old_y_end = epaper_panel->_drawn_y_end;
+    } else {
+        ESP_RETURN_ON_ERROR(epaper_load_full_lut(panel), TAG, "epaper_load_full_lut() error");
+        if (epaper_panel->_partial_refresh) {
+            epaper_panel->full_refresh = false;
+            epaper_panel->_partial_refresh_cnt = 0;
+            epaper_panel->_vram_copy_valid = true;
+            epaper_panel->_old_y_start = 0;
+            epaper_panel->_old_y_end = SSD1681_EPD_1IN54_V2_HEIGHT - 1;
+        }
+    }
+    epaper_panel->_drawn_y_start = SSD1681_EPD_1IN54_V2_HEIGHT;
+    epaper_panel->_drawn_y_end = -1;
     // --- Set color invert
     uint8_t duc_flag = 0x00;
-    if (!(epaper_panel->_invert_color)) {
+    if (partial) {
+        // The RED VRAM holds the old frame, it is compared with the BLACK VRAM in the same polarity
+        duc_flag = epaper_panel->_invert_color ? 0x00 : (SSD1681_PARAM_COLOR_BW_INVERSE_BIT | SSD1681_PARAM_COLOR_RW_INVERSE_BIT);
+    } else if (!(epaper_panel->_invert_color)) {
         duc_flag |= SSD1681_PARAM_COLOR_BW_INVERSE_BIT;
         duc_flag &= (~SSD1681_PARAM_COLOR_RW_INVERSE_BIT);
     } else {
@@ -229,7 +325,7 @@ esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel)
     gpio_intr_enable(epaper_panel->busy_gpio_num);
     // --- Send refresh command
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_SET_DISP_UPDATE_CTRL, (uint8_t[]) {
-        SSD1681_PARAM_DISP_WITH_MODE_2
+        (partial && !(epaper_panel->_has_partial_lut)) ? SSD1681_PARAM_DISP_UPDATE_MODE_2_OTP : SSD1681_PARAM_DISP_WITH_MODE_2
     }, 1), TAG, "SSD1681_CMD_SET_DISP_UPDATE_CTRL err");
 
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ, NULL, 0), TAG,
@@ -339,6 +435,7 @@ static esp_err_t epaper_panel_del(esp_lcd_panel_t *panel)
         // Should not free if buffer is not allocated by driver
         free(epaper_panel->_framebuffer);
     }
+    free(epaper_panel->_vram_copy);
     ESP_LOGD(TAG, "del ssd1681 epaper panel @%p", epaper_panel);
     free(epaper_panel);
     return ESP_OK;
@@ -406,6 +503,11 @@ static esp_err_t epaper_panel_init(esp_lcd_panel_t *panel)
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ, NULL, 0), TAG,
                         "param SSD1681_CMD_SET_DISP_UPDATE_CTRL err");
     panel_epaper_wait_busy(panel);
+    // --- Built-in LUT loaded, the VRAM content is unknown
+    epaper_panel->_has_full_lut = false;
+    epaper_panel->_partial_lut_loaded = false;
+    epaper_panel->_vram_copy_valid = false;
+    epaper_panel->full_refresh = true;
 
     return ESP_OK;
 }
@@ -428,6 +530,14 @@ epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x
     }
     ESP_RETURN_ON_FALSE(color_data, ESP_ERR_INVALID_ARG, TAG, "bitmap is null");
     ESP_RETURN_ON_FALSE((x_start < x_end) && (y_start < y_end), ESP_ERR_INVALID_ARG, TAG, "start position must be smaller than end position");
+    if (epaper_panel->_partial_refresh) {
+        // The VRAM copy is kept in the layout of data entry mode 3, for the BLACK VRAM only
+        ESP_RETURN_ON_FALSE(epaper_panel->bitmap_color == SSD1681_EPAPER_BITMAP_BLACK, ESP_ERR_INVALID_STATE, TAG, "red bitmap is unavailable in partial refresh mode");
+        ESP_RETURN_ON_FALSE(epaper_panel->_mirror_x == epaper_panel->_mirror_y, ESP_ERR_INVALID_STATE, TAG, "mirror of one axis is unavailable in partial refresh mode");
+        ESP_RETURN_ON_FALSE((x_start >= 0) && (y_start >= 0) && (x_end <= SSD1681_EPD_1IN54_V2_WIDTH) && (y_end <= SSD1681_EPD_1IN54_V2_HEIGHT),
+                            ESP_ERR_INVALID_ARG, TAG, "area out of the panel");
+        ESP_RETURN_ON_FALSE(((x_start % 8) == 0) && ((x_end % 8) == 0), ESP_ERR_INVALID_ARG, TAG, "x must be aligned to 8 in partial refresh mode");
+    }
     // --- Calculate coordinates & sizes
     int len_x = abs(x_start - x_end);
     int len_y = abs(y_start - y_end);
@@ -445,6 +555,12 @@ epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x
         // Copy & convert image according to configuration
         process_bitmap(panel, len_x, len_y, buffer_size, color_data);
     }
+    if (epaper_panel->_partial_refresh) {
+        // --- Old frame first, the BLACK VRAM copy is still the frame on the screen
+        ESP_RETURN_ON_ERROR(epaper_write_old_frame(epaper_panel), TAG, "epaper_write_old_frame() error");
+        // --- Send the changed window only
+        return epaper_draw_changed(epaper_panel, x_start, y_start, len_x, len_y);
+    }
     // --- Set cursor & data entry sequence
     if ((!(epaper_panel->_mirror_x)) && (!(epaper_panel->_mirror_y))) {
         // --- Cursor Settings
@@ -561,6 +677,9 @@ static esp_err_t epaper_panel_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
         ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ, NULL, 0), TAG,
                             "SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ err");
         panel_epaper_wait_busy(panel);
+        // Built-in LUT loaded, the next full refresh in partial refresh mode won't use the custom one
+        epaper_panel->_has_full_lut = false;
+        ESP_RETURN_ON_ERROR(epaper_full_lut_loaded(panel), TAG, "epaper_full_lut_loaded() error");
     } else {
         // Sleep mode, BUSY pin will keep HIGH after entering sleep mode
         // Perform reset and re-run init to resume the display
@@ -573,6 +692,172 @@ static esp_err_t epaper_panel_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     return ESP_OK;
 }
 
+static esp_err_t epaper_load_full_lut(esp_lcd_panel_t *panel)
+{
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    if (!(epaper_panel->_partial_lut_loaded)) {
+        return ESP_OK;
+    }
+    if (epaper_panel->_has_full_lut) {
+        ESP_RETURN_ON_ERROR(epaper_set_lut(epaper_panel->io, epaper_panel->_full_lut), TAG, "epaper_set_lut() error");
+    } else {
+        // --- Load built-in waveform LUT
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_SET_DISP_UPDATE_CTRL, (uint8_t[]) {
+            SSD1681_PARAM_DISP_UPDATE_MODE_1
+        }, 1), TAG, "SSD1681_CMD_SET_DISP_UPDATE_CTRL err");
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ, NULL, 0), TAG,
+                            "SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ err");
+        panel_epaper_wait_busy(panel);
+    }
+    return epaper_full_lut_loaded(panel);
+}
+
+static esp_err_t epaper_full_lut_loaded(esp_lcd_panel_t *panel)
+{
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    // LUT register was overwritten, the next partial refresh must load its LUT and border again
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_SET_BORDER_WAVEFORM, (uint8_t[]) {
+        SSD1681_PARAM_BORDER_WAVEFORM
+    }, 1), TAG, "SSD1681_CMD_SET_BORDER_WAVEFORM err");
+    epaper_panel->_partial_lut_loaded = false;
+    return ESP_OK;
+}
+
+static esp_err_t epaper_load_partial_lut(esp_lcd_panel_t *panel)
+{
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    if (epaper_panel->_partial_lut_loaded) {
+        return ESP_OK;
+    }
+    // Without custom LUT, the refresh command loads DISPLAY Mode 2 of the OTP itself
+    if (epaper_panel->_has_partial_lut) {
+        ESP_RETURN_ON_ERROR(epaper_set_lut(epaper_panel->io, epaper_panel->_partial_lut), TAG, "epaper_set_lut() error");
+    }
+    // Border keeps its level, it would flash at every partial refresh
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_SET_BORDER_WAVEFORM, (uint8_t[]) {
+        SSD1681_PARAM_BORDER_WAVEFORM_PARTIAL
+    }, 1), TAG, "SSD1681_CMD_SET_BORDER_WAVEFORM err");
+    epaper_panel->_partial_lut_loaded = true;
+    return ESP_OK;
+}
+
+static bool epaper_diff_area(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y,
+                             int *row_first, int *row_last, int *col_first, int *col_last)
+{
+    const int row_bytes = len_x / 8;
+    if (!(epaper_panel->_vram_copy_valid)) {
+        // VRAM content unknown, everything is sent
+        *row_first = 0;
+        *row_last = len_y - 1;
+        *col_first = 0;
+        *col_last = row_bytes - 1;
+        return true;
+    }
+    *row_first = len_y;
+    *row_last = -1;
+    *col_first = row_bytes;
+    *col_last = -1;
+    for (int row = 0; row < len_y; row++) {
+        const uint8_t *new_row = epaper_panel->_framebuffer + row * row_bytes;
+        const uint8_t *old_row = epaper_panel->_vram_copy + (y_start + row) * SSD1681_VRAM_ROW_BYTES + x_start / 8;
+        if (memcmp(new_row, old_row, row_bytes) == 0) {
+            continue;
+        }
+        // Changed columns of the row, only where they widen the window
+        int col = 0;
+        while ((col < *col_first) && (new_row[col] == old_row[col])) {
+            col++;
+        }
+        if (col < *col_first) {
+            *col_first = col;
+        }
+        col = row_bytes - 1;
+        while ((col > *col_last) && (new_row[col] == old_row[col])) {
+            col--;
+        }
+        if (col > *col_last) {
+            *col_last = col;
+        }
+        if (*row_first > row) {
+            *row_first = row;
+        }
+        *row_last = row;
+    }
+    return (*row_last >= 0);
+}
+
+static esp_err_t epaper_draw_changed(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y)
+{
+    const int row_bytes = len_x / 8;
+    int row_first, row_last, col_first, col_last;
+    if (!epaper_diff_area(epaper_panel, x_start, y_start, len_x, len_y, &row_first, &row_last, &col_first, &col_last)) {
+        // Same as on the screen, nothing to send
+        return ESP_OK;
+    }
+    // --- Update the VRAM copy
+    for (int row = row_first; row <= row_last; row++) {
+        memcpy(epaper_panel->_vram_copy + (y_start + row) * SSD1681_VRAM_ROW_BYTES + x_start / 8,
+               epaper_panel->_framebuffer + row * row_bytes, row_bytes);
+    }
+    // --- Changed window of the bitmap
+    uint8_t *window = epaper_panel->_framebuffer + row_first * row_bytes;
+    if (epaper_panel->_non_copy_mode) {
+        // User buffer is not modified, the changed rows are sent whole
+        col_first = 0;
+        col_last = row_bytes - 1;
+    } else {
+        // Pack the changed columns, the rows move towards the buffer start only
+        const int window_bytes = col_last - col_first + 1;
+        for (int row = row_first; row <= row_last; row++) {
+            memmove(window + (row - row_first) * window_bytes, epaper_panel->_framebuffer + row * row_bytes + col_first, window_bytes);
+        }
+    }
+    const int window_x_start = x_start + col_first * 8;
+    const int window_x_end = x_start + col_last * 8 + 7;
+    // --- Cursor Settings
+    ESP_RETURN_ON_ERROR(epaper_set_area(epaper_panel->io, window_x_start, y_start + row_first, window_x_end, y_start + row_last), TAG,
+                        "epaper_set_area() error");
+    ESP_RETURN_ON_ERROR(epaper_set_cursor(epaper_panel->io, window_x_start, y_start + row_first), TAG,
+                        "epaper_set_cursor() error");
+    // --- Data Entry Sequence Setting
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_DATA_ENTRY_MODE, (uint8_t[]) {
+        SSD1681_PARAM_DATA_ENTRY_MODE_3
+    }, 1), TAG, "SSD1681_CMD_DATA_ENTRY_MODE err");
+    // --- Send bitmap to e-Paper VRAM
+    ESP_RETURN_ON_ERROR(panel_epaper_set_vram(epaper_panel->io, window, NULL, (col_last - col_first + 1) * (row_last - row_first + 1)),
+                        TAG, "panel_epaper_set_vram error");
+    // --- Rows to refresh, and to write as the old frame after it
+    if (epaper_panel->_drawn_y_start > y_start + row_first) {
+        epaper_panel->_drawn_y_start = y_start + row_first;
+    }
+    if (epaper_panel->_drawn_y_end < y_start + row_last) {
+        epaper_panel->_drawn_y_end = y_start + row_last;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t epaper_write_old_frame(epaper_panel_t *epaper_panel)
+{
+    if (epaper_panel->_old_y_start > epaper_panel->_old_y_end) {
+        return ESP_OK;
+    }
+    // The partial waveform drives the pixels differing between the RED VRAM (old frame) and the BLACK VRAM (new frame)
+    ESP_RETURN_ON_ERROR(epaper_set_area(epaper_panel->io, 0, epaper_panel->_old_y_start, SSD1681_EPD_1IN54_V2_WIDTH - 1,
+                                        epaper_panel->_old_y_end), TAG, "epaper_set_area() error");
+    ESP_RETURN_ON_ERROR(epaper_set_cursor(epaper_panel->io, 0, epaper_panel->_old_y_start), TAG,
+                        "epaper_set_cursor() error");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_DATA_ENTRY_MODE, (uint8_t[]) {
+        SSD1681_PARAM_DATA_ENTRY_MODE_3
+    }, 1), TAG, "SSD1681_CMD_DATA_ENTRY_MODE err");
+    ESP_RETURN_ON_ERROR(panel_epaper_set_vram(epaper_panel->io, NULL,
+                        epaper_panel->_vram_copy + epaper_panel->_old_y_start * SSD1681_VRAM_ROW_BYTES,
+                        (epaper_panel->_old_y_end - epaper_panel->_old_y_start + 1) * SSD1681_VRAM_ROW_BYTES),
+                        TAG, "panel_epaper_set_vram error");
+    epaper_panel->_old_y_start = SSD1681_EPD_1IN54_V2_HEIGHT;
+    epaper_panel->_old_y_end = -1;
+    return ESP_OK;
+}
+
 static esp_err_t process_bitmap(esp_lcd_panel_t *panel, int len_x, int len_y, int buffer_size, const void *color_data)
 {
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
@@ -47,6 +47,8 @@
 // GS Transition control Follow LUT
 // GS Transition setting for VBD LUT1
 #define SSD1681_PARAM_BORDER_WAVEFORM       0x01
+// Select VCOM as border level, the border doesn't change in partial refresh
+#define SSD1681_PARAM_BORDER_WAVEFORM_PARTIAL   0x80
 // --- Temperature Sensor Control
 #define SSD1681_CMD_SET_TEMP_SENSOR         0x18
 // Select to use internal sensor, 0x48 for external
@@ -65,6 +67,14 @@
 // Disable Analog
 // Disable OSC
 #define SSD1681_PARAM_DISP_UPDATE_MODE_2      0xcf
+// Enable clock signal
+// Enable Analog
+// Load temperature value
+// Load LUT with DISPLAY Mode 2 (partial update waveform of the panel OTP)
+// Display with DISPLAY Mode 2
+// Disable Analog
+// Disable OSC
+#define SSD1681_PARAM_DISP_UPDATE_MODE_2_OTP  0xff
 // --- Active display update sequence
 #define SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ  0x20
 // ---
@@ -129,6 +129,27 @@ esp_err_t epaper_panel_register_event_callbacks(esp_lcd_panel_t *panel, epaper_p
  */
 esp_err_t epaper_panel_set_custom_lut(esp_lcd_panel_t *panel, uint8_t *lut, size_t size);
 
+/**
+ * @brief Enable or disable the partial refresh mode
+ *
+ * @note In partial refresh mode, `draw_bitmap()` only sends the rows and columns which differ from the last drawn frame,
+ *       and `epaper_panel_refresh_screen()` only drives the pixels changed since the last refresh.
+ *       The first refresh after enabling is a full one, draw the whole screen before it.
+ * @note Bitmaps must be black ones with x aligned to 8, mirror must be the same for both axes.
+ * @note Partial refreshes leave some ghosting, a full refresh is done every `full_refresh_period` refreshes to clear it.
+ *
+ * @param[in] panel LCD panel handle
+ * @param[in] enable true to enable the partial refresh mode, false to disable it
+ * @param[in] lut custom partial refresh waveform lut, NULL to use the built-in one
+ * @param[in] size size of your lut array, make sure it is SSD1681_LUT_SIZE bytes
+ * @param[in] full_refresh_period partial refreshes between two full refreshes, 0 to never refresh fully again
+ * @return  ESP_OK                on success
+ *          ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          ESP_ERR_NO_MEM        if out of memory
+ */
+esp_err_t epaper_panel_set_partial_refresh(esp_lcd_panel_t *panel, bool enable, const uint8_t *lut, size_t size,
+        uint32_t full_refresh_period);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,382 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_lcd_touch.h"
+#include "esp_lcd_touch_service.h"
+
+static const char *TAG = "TP";
+
+#define ESP_LCD_TOUCH_SERVICE_FRAMES    (8)             /* Power of two, frames buffered for the reader */
+#define ESP_LCD_TOUCH_MEDIAN_MAX        (5)
+#define ESP_LCD_TOUCH_IIR_FRAC          (4)             /* Fraction bits of the IIR state */
+#define ESP_LCD_TOUCH_PREDICT_MAX_DT_US (100 * 1000)    /* Older movement doesn't give a velocity */
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    uint16_t raw_x[ESP_LCD_TOUCH_MEDIAN_MAX];   /* Median window */
+    uint16_t raw_y[ESP_LCD_TOUCH_MEDIAN_MAX];
+    uint8_t raw_cnt;                            /* Samples in the median window */
+    uint8_t raw_pos;                            /* Next sample in the median window */
+    int32_t iir_x;                              /* IIR state, ESP_LCD_TOUCH_IIR_FRAC fraction bits */
+    int32_t iir_y;
+    uint16_t out_x;                             /* Point after the jitter threshold */
+    uint16_t out_y;
+    int64_t out_time_us;
+    uint16_t prev_x;                            /* Point before the last move, for the velocity */
+    uint16_t prev_y;
+    int64_t prev_time_us;
+} esp_lcd_touch_point_filter_t;
+
+struct esp_lcd_touch_service_s {
+    esp_lcd_touch_handle_t tp;                  /* Touch handler */
+    esp_lcd_touch_service_config_t config;      /* Service configuration */
+    TaskHandle_t task;                          /* Service task */
+    SemaphoreHandle_t task_exit;                /* Given by the service task when it exits */
+    volatile bool running;                      /* Service task runs until cleared */
+
+    portMUX_TYPE irq_lock;                      /* Lock for the interrupt timestamp */
+    int64_t irq_time_us;                        /* Time of the last touch interrupt */
+    bool irq_pending;                           /* Touch interrupt not read yet */
+
+    /* Service task only */
+    esp_lcd_touch_point_filter_t filters[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint8_t filter_points;                      /* Points of the last sample, the next ones start a new filter */
+    esp_lcd_touch_frame_t last;                 /* Last published frame */
+    esp_lcd_touch_frame_t pending;              /* Frame not published, the buffer was full */
+    bool has_pending;
+    uint32_t seq;
+
+    /* Lock-free single producer (service task), single consumer (reader) buffer */
+    esp_lcd_touch_frame_t frames[ESP_LCD_TOUCH_SERVICE_FRAMES];
+    atomic_uint head;                           /* Next frame written, only the service task changes it */
+    atomic_uint tail;                           /* Next frame read, only the reader changes it */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void esp_lcd_touch_service_task(void *arg);
+static void esp_lcd_touch_service_interrupt_callback(esp_lcd_touch_handle_t tp);
+static void esp_lcd_touch_service_sample(esp_lcd_touch_service_t *service, int64_t time_us);
+static void esp_lcd_touch_service_filter(esp_lcd_touch_service_t *service, uint8_t n, uint16_t *x, uint16_t *y, int64_t time_us);
+static bool esp_lcd_touch_service_publish(esp_lcd_touch_service_t *service, const esp_lcd_touch_frame_t *frame);
+static uint16_t esp_lcd_touch_median(const uint16_t *values, uint8_t cnt);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_lcd_touch_service_create(esp_lcd_touch_handle_t tp, const esp_lcd_touch_service_config_t *config, esp_lcd_touch_service_handle_t *ret_service)
+{
+    esp_err_t ret = ESP_OK;
+    esp_lcd_touch_service_t *service = NULL;
+    ESP_RETURN_ON_FALSE(tp && config && ret_service, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(config->filter.median_len <= ESP_LCD_TOUCH_MEDIAN_MAX, ESP_ERR_INVALID_ARG, TAG, "Median window is up to %d samples", ESP_LCD_TOUCH_MEDIAN_MAX);
+    ESP_RETURN_ON_FALSE(config->filter.iir_weight <= 256, ESP_ERR_INVALID_ARG, TAG, "IIR weight is up to 256");
+    ESP_RETURN_ON_FALSE(config->poll_period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid poll period");
+
+    service = calloc(1, sizeof(esp_lcd_touch_service_t));
+    ESP_RETURN_ON_FALSE(service, ESP_ERR_NO_MEM, TAG, "Not enough memory for touch service allocation!");
+    service->tp = tp;
+    memcpy(&service->config, config, sizeof(esp_lcd_touch_service_config_t));
+    portMUX_INITIALIZE(&service->irq_lock);
+    atomic_init(&service->head, 0);
+    atomic_init(&service->tail, 0);
+    service->running = true;
+
+    service->task_exit = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(service->task_exit, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for touch service semaphore!");
+
+    const BaseType_t core = (config->task_affinity < 0) ? tskNO_AFFINITY : config->task_affinity;
+    BaseType_t res = xTaskCreatePinnedToCore(esp_lcd_touch_service_task, "taskTouch", config->task_stack, service, config->task_priority, &service->task, core);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create touch service task fail!");
+
+    if (tp->config.int_gpio_num != GPIO_NUM_NC) {
+        /* The touch interrupt wakes the service task */
+        ret = esp_lcd_touch_register_interrupt_callback_with_data(tp, esp_lcd_touch_service_interrupt_callback, service);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Error in register touch interrupt.");
+            esp_lcd_touch_service_del(service);
+            return ret;
+        }
+    }
+
+    *ret_service = service;
+    return ESP_OK;
+
+err:
+    if (service->task_exit) {
+        vSemaphoreDelete(service->task_exit);
+    }
+    free(service);
+    return ret;
+}
+
+esp_err_t esp_lcd_touch_service_del(esp_lcd_touch_service_handle_t service)
+{
+    assert(service != NULL);
+
+    if (service->tp->config.int_gpio_num != GPIO_NUM_NC) {
+        esp_lcd_touch_register_interrupt_callback(service->tp, NULL);
+    }
+
+    /* Stop the service task, it may be reading the touch controller */
+    service->running = false;
+    xTaskNotifyGive(service->task);
+    xSemaphoreTake(service->task_exit, portMAX_DELAY);
+
+    vSemaphoreDelete(service->task_exit);
+    free(service);
+
+    return ESP_OK;
+}
+
+bool esp_lcd_touch_service_read_frame(esp_lcd_touch_service_handle_t service, esp_lcd_touch_frame_t *frame)
+{
+    assert(service != NULL);
+    assert(frame != NULL);
+
+    const unsigned int tail = atomic_load_explicit(&service->tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&service->head, memory_order_acquire)) {
+        return false;
+    }
+    memcpy(frame, &service->frames[tail % ESP_LCD_TOUCH_SERVICE_FRAMES], sizeof(esp_lcd_touch_frame_t));
+    /* The frame is copied before the service task can overwrite it */
+    atomic_store_explicit(&service->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool esp_lcd_touch_service_has_frame(esp_lcd_touch_service_handle_t service)
+{
+    assert(service != NULL);
+
+    return atomic_load_explicit(&service->tail, memory_order_relaxed) != atomic_load_explicit(&service->head, memory_order_acquire);
+}
+
+esp_lcd_touch_handle_t esp_lcd_touch_service_get_touch(esp_lcd_touch_service_handle_t service)
+{
+    assert(service != NULL);
+
+    return service->tp;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_lcd_touch_service_task(void *arg)
+{
+    esp_lcd_touch_service_t *service = (esp_lcd_touch_service_t *)arg;
+    const bool use_interrupt = (service->tp->config.int_gpio_num != GPIO_NUM_NC);
+
+    /* Released state before the first touch */
+    esp_lcd_touch_service_sample(service, esp_timer_get_time());
+
+    while (service->running) {
+        /* Poll while touched, the release doesn't always raise the touch interrupt */
+        const bool poll = (!use_interrupt || service->last.points > 0 || service->has_pending);
+        ulTaskNotifyTake(pdTRUE, poll ? pdMS_TO_TICKS(service->config.poll_period_ms) : portMAX_DELAY);
+        if (!service->running) {
+            break;
+        }
+
+        int64_t time_us = esp_timer_get_time();
+        portENTER_CRITICAL(&service->irq_lock);
+        if (service->irq_pending) {
+            time_us = service->irq_time_us;
+            service->irq_pending = false;
+        }
+        portEXIT_CRITICAL(&service->irq_lock);
+
+        /* Publish a frame dropped on a full buffer, before the new one */
+        if (service->has_pending && esp_lcd_touch_service_publish(service, &service->pending)) {
+            service->has_pending = false;
+        }
+
+        esp_lcd_touch_service_sample(service, time_us);
+    }
+
+    xSemaphoreGive(service->task_exit);
+    vTaskDelete(NULL);
+}
+
+static void IRAM_ATTR esp_lcd_touch_service_interrupt_callback(esp_lcd_touch_handle_t tp)
+{
+    esp_lcd_touch_service_t *service = (esp_lcd_touch_service_t *)tp->config.user_data;
+    BaseType_t need_yield = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&service->irq_lock);
+    service->irq_time_us = esp_timer_get_time();
+    service->irq_pending = true;
+    portEXIT_CRITICAL_ISR(&service->irq_lock);
+
+    vTaskNotifyGiveFromISR(service->task, &need_yield);
+    if (need_yield) {
+        portYIELD_FROM_ISR( );
+    }
+}
+
+static void esp_lcd_touch_service_sample(esp_lcd_touch_service_t *service, int64_t time_us)
+{
+    uint16_t x[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint16_t y[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint16_t strength[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint8_t points = 0;
+    esp_lcd_touch_frame_t frame = {
+        .timestamp_us = time_us,
+    };
+
+    esp_err_t ret = esp_lcd_touch_read_data(service->tp);
+    if (ret != ESP_OK) {
+        ESP_LOGD(TAG, "Touch read failed (%s)", esp_err_to_name(ret));
+        return;
+    }
+    if (!esp_lcd_touch_get_coordinates(service->tp, x, y, strength, &points, CONFIG_ESP_LCD_TOUCH_MAX_POINTS)) {
+        points = 0;
+    }
+
+    frame.points = points;
+    for (uint8_t i = 0; i < points; i++) {
+        /* Points not in the last sample start with a new filter */
+        if (i >= service->filter_points) {
+            memset(&service->filters[i], 0, sizeof(esp_lcd_touch_point_filter_t));
+        }
+        esp_lcd_touch_service_filter(service, i, &x[i], &y[i], time_us);
+        frame.coords[i].x = x[i];
+        frame.coords[i].y = y[i];
+        frame.coords[i].strength = strength[i];
+    }
+    service->filter_points = points;
+
+    /* Only changes are published, a held point makes no frames */
+    if (frame.points == service->last.points &&
+            memcmp(frame.coords, service->last.coords, frame.points * sizeof(frame.coords[0])) == 0) {
+        return;
+    }
+
+    frame.seq = service->seq++;
+    memcpy(&service->last, &frame, sizeof(esp_lcd_touch_frame_t));
+    if (service->has_pending || !esp_lcd_touch_service_publish(service, &frame)) {
+        /* The reader is behind, keep the newest frame for the next period */
+        memcpy(&service->pending, &frame, sizeof(esp_lcd_touch_frame_t));
+        service->has_pending = true;
+    }
+}
+
+static void esp_lcd_touch_service_filter(esp_lcd_touch_service_t *service, uint8_t n, uint16_t *x, uint16_t *y, int64_t time_us)
+{
+    const esp_lcd_touch_filter_config_t *cfg = &service->config.filter;
+    esp_lcd_touch_point_filter_t *filter = &service->filters[n];
+    const bool first = (filter->raw_cnt == 0);
+    int32_t fx = *x;
+    int32_t fy = *y;
+
+    /* Median, removes single sample spikes */
+    if (cfg->median_len > 1) {
+        filter->raw_x[filter->raw_pos] = *x;
+        filter->raw_y[filter->raw_pos] = *y;
+        filter->raw_pos = (filter->raw_pos + 1) % cfg->median_len;
+        if (filter->raw_cnt < cfg->median_len) {
+            filter->raw_cnt++;
+        }
+        fx = esp_lcd_touch_median(filter->raw_x, filter->raw_cnt);
+        fy = esp_lcd_touch_median(filter->raw_y, filter->raw_cnt);
+    } else {
+        filter->raw_cnt = 1;
+    }
+
+    /* IIR low-pass, starts at the first sample */
+    if (cfg->iir_weight > 0) {
+        if (first) {
+            filter->iir_x = fx << ESP_LCD_TOUCH_IIR_FRAC;
+            filter->iir_y = fy << ESP_LCD_TOUCH_IIR_FRAC;
+        } else {
+            filter->iir_x += (((fx << ESP_LCD_TOUCH_IIR_FRAC) - filter->iir_x) * cfg->iir_weight) / 256;
+            filter->iir_y += (((fy << ESP_LCD_TOUCH_IIR_FRAC) - filter->iir_y) * cfg->iir_weight) / 256;
+        }
+        fx = (filter->iir_x + (1 << (ESP_LCD_TOUCH_IIR_FRAC - 1))) >> ESP_LCD_TOUCH_IIR_FRAC;
+        fy = (filter->iir_y + (1 << (ESP_LCD_TOUCH_IIR_FRAC - 1))) >> ESP_LCD_TOUCH_IIR_FRAC;
+    }
+
+    /* Jitter threshold, small movements of a held point are dropped */
+    if (first || abs(fx - filter->out_x) >= cfg->jitter_threshold || abs(fy - filter->out_y) >= cfg->jitter_threshold) {
+        filter->prev_x = first ? fx : filter->out_x;
+        filter->prev_y = first ? fy : filter->out_y;
+        filter->prev_time_us = first ? time_us : filter->out_time_us;
+        filter->out_x = fx;
+        filter->out_y = fy;
+        filter->out_time_us = time_us;
+    } else {
+        fx = filter->out_x;
+        fy = filter->out_y;
+    }
+
+    /* Velocity prediction of the moving point, a held point stays */
+    const int64_t dt_us = filter->out_time_us - filter->prev_time_us;
+    if (cfg->predict_ms > 0 && filter->out_time_us == time_us && dt_us > 0 && dt_us <= ESP_LCD_TOUCH_PREDICT_MAX_DT_US) {
+        const int64_t predict_us = (int64_t)cfg->predict_ms * 1000;
+        fx += (int32_t)(((int64_t)filter->out_x - filter->prev_x) * predict_us / dt_us);
+        fy += (int32_t)(((int64_t)filter->out_y - filter->prev_y) * predict_us / dt_us);
+
+        /* Coordinates are mirrored from x_max / y_max before they are swapped */
+        const int32_t x_max = service->tp->config.flags.swap_xy ? service->tp->config.y_max : service->tp->config.x_max;
+        const int32_t y_max = service->tp->config.flags.swap_xy ? service->tp->config.x_max : service->tp->config.y_max;
+        fx = (fx < 0) ? 0 : (fx > x_max) ? x_max : fx;
+        fy = (fy < 0) ? 0 : (fy > y_max) ? y_max : fy;
+    }
+
+    *x = (uint16_t)fx;
+    *y = (uint16_t)fy;
+}
+
+static bool esp_lcd_touch_service_publish(esp_lcd_touch_service_t *service, const esp_lcd_touch_frame_t *frame)
+{
+    const unsigned int head = atomic_load_explicit(&service->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&service->tail, memory_order_acquire) >= ESP_LCD_TOUCH_SERVICE_FRAMES) {
+        return false;
+    }
+    memcpy(&service->frames[head % ESP_LCD_TOUCH_SERVICE_FRAMES], frame, sizeof(esp_lcd_touch_frame_t));
+    /* The frame is written before the reader can see it */
+    atomic_store_explicit(&service->head, head + 1, memory_order_release);
+
+    if (service->config.frame_callback) {
+        service->config.frame_callback(service, service->config.user_data);
+    }
+
+    return true;
+}
+
+static uint16_t esp_lcd_touch_median(const uint16_t *values, uint8_t cnt)
+{
+    uint16_t sorted[ESP_LCD_TOUCH_MEDIAN_MAX];
+
+    /* Insertion sort, up to 5 values */
+    for (uint8_t i = 0; i < cnt; i++) {
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > values[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = values[i];
+    }
+
+    return sorted[cnt / 2];
+}
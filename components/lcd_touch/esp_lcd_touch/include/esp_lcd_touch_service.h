@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LCD touch service
+ *
+ * The service reads the touch controller in its own task, woken by the touch interrupt (or polled without it).
+ * Samples are timestamped, filtered and published as multi-point frames into a lock-free buffer,
+ * so the reader (e.g. the LVGL task) never waits for the touch controller bus.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_lcd_touch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Touch service type
+ *
+ */
+typedef struct esp_lcd_touch_service_s esp_lcd_touch_service_t;
+typedef esp_lcd_touch_service_t *esp_lcd_touch_service_handle_t;
+
+/**
+ * @brief Touch service frame callback type, called from the service task after a frame is published
+ *
+ */
+typedef void (*esp_lcd_touch_service_frame_callback_t)(esp_lcd_touch_service_handle_t service, void *user_data);
+
+/**
+ * @brief Touch coordinates filter configuration, each stage is skipped when set to 0
+ *
+ * Stages are applied per point in this order: median, IIR, jitter threshold, velocity prediction.
+ */
+typedef struct {
+    uint8_t median_len;         /*!< Median window of the raw coordinates, 3 or 5 samples (0 = off) */
+    uint16_t iir_weight;        /*!< Weight of the new sample in the IIR low-pass, in 1/256 (0 = off, 256 = no smoothing) */
+    uint16_t jitter_threshold;  /*!< Movement in pixels below which the point stays where it is (0 = off) */
+    uint16_t predict_ms;        /*!< Point moved ahead by its velocity over this time, hides the filter latency (0 = off) */
+} esp_lcd_touch_filter_config_t;
+
+/**
+ * @brief Touch service configuration
+ *
+ */
+typedef struct {
+    esp_lcd_touch_filter_config_t filter;   /*!< Coordinates filter */
+    uint32_t poll_period_ms;    /*!< Read period while touched, or always without interrupt pin */
+    int task_priority;          /*!< Service task priority */
+    int task_stack;             /*!< Service task stack size */
+    int task_affinity;          /*!< Service task pinned to core (-1 is no affinity) */
+    esp_lcd_touch_service_frame_callback_t frame_callback; /*!< Called after a frame is published (can be NULL) */
+    void *user_data;            /*!< User data passed to frame callback */
+} esp_lcd_touch_service_config_t;
+
+/**
+ * @brief Touch service default configuration
+ *
+ */
+#define ESP_LCD_TOUCH_SERVICE_INIT_CONFIG()     \
+    {                                           \
+        .filter = {                             \
+            .median_len = 3,                    \
+            .iir_weight = 128,                  \
+            .jitter_threshold = 2,              \
+            .predict_ms = 0,                    \
+        },                                      \
+        .poll_period_ms = 10,                   \
+        .task_priority = 5,                     \
+        .task_stack = 4096,                     \
+        .task_affinity = -1,                    \
+        .frame_callback = NULL,                 \
+        .user_data = NULL,                      \
+    }
+
+/**
+ * @brief Touch frame, all points touched at one time
+ *
+ */
+typedef struct {
+    int64_t timestamp_us;   /*!< Time of the touch interrupt, or of the read without interrupt (esp_timer time) */
+    uint32_t seq;           /*!< Frame sequence number, a gap means frames were dropped */
+    uint8_t points;         /*!< Count of touch points, 0 when released */
+
+    struct {
+        uint16_t x; /*!< Filtered X coordinate */
+        uint16_t y; /*!< Filtered Y coordinate */
+        uint16_t strength; /*!< Strength */
+    } coords[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+} esp_lcd_touch_frame_t;
+
+/**
+ * @brief Create touch service and start its task
+ *
+ * @note The service registers the touch interrupt callback, it replaces any callback registered before.
+ *
+ * @param tp: Touch handler
+ * @param config: Service configuration
+ * @param ret_service: Returned service handle
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if parameter is invalid
+ *      - ESP_ERR_NO_MEM            if not enough memory
+ */
+esp_err_t esp_lcd_touch_service_create(esp_lcd_touch_handle_t tp, const esp_lcd_touch_service_config_t *config, esp_lcd_touch_service_handle_t *ret_service);
+
+/**
+ * @brief Stop the service task and delete the service
+ *
+ * @param service: Service handle
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_service_del(esp_lcd_touch_service_handle_t service);
+
+/**
+ * @brief Take the oldest frame not read yet
+ *
+ * @note Lock-free and non-blocking, one reader only.
+ *
+ * @param service: Service handle
+ * @param frame: Returned frame
+ *
+ * @return
+ *      - Returns true, when a frame was returned. Returns false, when all frames were read.
+ */
+bool esp_lcd_touch_service_read_frame(esp_lcd_touch_service_handle_t service, esp_lcd_touch_frame_t *frame);
+
+/**
+ * @brief Are there frames not read yet
+ *
+ * @param service: Service handle
+ *
+ * @return
+ *      - Returns true, when the next esp_lcd_touch_service_read_frame() returns a frame.
+ */
+bool esp_lcd_touch_service_has_frame(esp_lcd_touch_service_handle_t service);
+
+/**
+ * @brief Get touch handler of the service
+ *
+ * @param service: Service handle
+ *
+ * @return
+ *      - Touch handler
+ */
+esp_lcd_touch_handle_t esp_lcd_touch_service_get_touch(esp_lcd_touch_service_handle_t service);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file blend_fuzz.c
+ * @brief Host fuzz, golden output and benchmark harness for the esp_lvgl_port lv_blend reference functions
+ *
+ * Builds the ANSI hard copies of LVGL's blend functions from the SIMD test app
+ * (components/esp_lvgl_port/test_apps/simd/main/lv_blend) and drives them with the
+ * seeded cases of lv_blend_fuzz.c, the same generator the target test app uses.
+ * The CRC of every destination buffer of the golden sequence is checked in as
+ * lv_blend_golden.h, the target runs the assembly kernels on the same cases and
+ * compares against it. A kernel change can thus be regression checked here first,
+ * and on the device without a second ANSI run to trust.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <getopt.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lv_blend_fuzz.h"
+#include "lv_blend_golden.h"
+
+#define BENCH_DIM           128     // Same matrix as the target benchmarks
+#define BENCH_UNALIGN_BYTES 3       // UNALIGN_BYTES of the target benchmarks, rounded down to the pixel alignment
+
+typedef struct {
+    const char *name;
+    lv_opa_t opa;
+    bool use_mask;
+} bench_variant_t;
+
+static const bench_variant_t bench_variants[] = {
+    {"normal",       LV_OPA_COVER, false},
+    {"opa",          LV_OPA_50,    false},
+    {"mask",         LV_OPA_COVER, true},
+    {"mask_opa",     LV_OPA_50,    true},
+};
+
+static struct {
+    uint32_t seed;
+    uint32_t cases;
+    uint32_t iterations;
+    const char *write_path;
+    bool fuzz;
+    bool bench;
+    bool csv;
+    bool verbose;
+} opts = {
+    .seed = LV_BLEND_GOLDEN_SEED,
+    .cases = LV_BLEND_GOLDEN_CASES,
+    .iterations = 200,
+};
+
+
+static void print_case(const char *what, uint32_t index, const lv_blend_fuzz_case_t *c)
+{
+    fprintf(stderr, "%s case %u: %s %dx%d dest_stride %d src_stride %d mask %d/%d unalign %u/%u opa %u color %02x%02x%02x\n",
+            what, index, lv_blend_fuzz_op_name(c->op), c->dest_w, c->dest_h, c->dest_stride, c->src_stride,
+            c->use_mask, c->mask_stride, c->dest_unalign_byte, c->src_unalign_byte, c->opa,
+            c->color.red, c->color.green, c->color.blue);
+}
+
+/**
+ * Run cases 0..count-1 of seed on the reference, into crcs when not NULL.
+ * Returns the number of cases that wrote outside the destination area.
+ */
+static int run_cases(uint32_t seed, uint32_t count, uint32_t *crcs)
+{
+    int errors = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        lv_blend_fuzz_case_t c;
+        lv_blend_fuzz_result_t r;
+
+        lv_blend_fuzz_case_init(seed, i, &c);
+        if (!lv_blend_fuzz_run(&c, false, &r)) {
+            fprintf(stderr, "out of memory\n");
+            return errors + 1;
+        }
+        if (!r.canary_ok) {
+            print_case("CANARY", i, &c);
+            errors++;
+        } else if (opts.verbose) {
+            print_case("ok", i, &c);
+        }
+        if (crcs)
+            crcs[i] = r.crc;
+    }
+    return errors;
+}
+
+static int check_golden(void)
+{
+    uint32_t *crcs = calloc(LV_BLEND_GOLDEN_CASES, sizeof(uint32_t));
+    int errors, mismatches = 0;
+
+    if (!crcs)
+        return 1;
+
+    errors = run_cases(LV_BLEND_GOLDEN_SEED, LV_BLEND_GOLDEN_CASES, crcs);
+    for (uint32_t i = 0; i < LV_BLEND_GOLDEN_CASES; i++) {
+        if (crcs[i] != lv_blend_golden_crc[i]) {
+            lv_blend_fuzz_case_t c;
+            lv_blend_fuzz_case_init(LV_BLEND_GOLDEN_SEED, i, &c);
+            print_case("GOLDEN MISMATCH", i, &c);
+            mismatches++;
+        }
+    }
+    free(crcs);
+
+    printf("golden: %d cases, %d mismatch(es), %d canary error(s)\n", LV_BLEND_GOLDEN_CASES, mismatches, errors);
+    if (mismatches)
+        fprintf(stderr, "the reference changed, review it and regenerate lv_blend_golden.h with --write\n");
+    return errors + mismatches;
+}
+
+static int write_golden(const char *path)
+{
+    uint32_t *crcs = calloc(opts.cases, sizeof(uint32_t));
+    FILE *f;
+    int errors;
+
+    if (!crcs)
+        return 1;
+
+    errors = run_cases(opts.seed, opts.cases, crcs);
+    if (errors) {
+        fprintf(stderr, "not writing %s, the reference wrote outside the destination\n", path);
+        free(crcs);
+        return errors;
+    }
+
+    f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path);
+        free(crcs);
+        return 1;
+    }
+    fprintf(f, "/*\n"
+               " * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD\n"
+               " *\n"
+               " * SPDX-License-Identifier: Apache-2.0\n"
+               " */\n\n"
+               "// Generated by host/blend_fuzz --write, do not edit\n"
+               "// CRC-32 of the destination buffers (Canary bytes included) of the lv_blend ANSI reference,\n"
+               "// for cases 0 .. LV_BLEND_GOLDEN_CASES - 1 of lv_blend_fuzz_case_init(LV_BLEND_GOLDEN_SEED, index)\n\n"
+               "#pragma once\n\n"
+               "#include <stdint.h>\n\n"
+               "#define LV_BLEND_GOLDEN_SEED    0x%08XU\n"
+               "#define LV_BLEND_GOLDEN_CASES   %u\n\n"
+               "static const uint32_t lv_blend_golden_crc[LV_BLEND_GOLDEN_CASES] = {\n",
+            opts.seed, opts.cases);
+    for (uint32_t i = 0; i < opts.cases; i++) {
+        fprintf(f, "%s0x%08X,%s", (i % 8) ? " " : "    ", crcs[i], (i % 8 == 7 || i + 1 == opts.cases) ? "\n" : "");
+    }
+    fprintf(f, "};\n");
+    fclose(f);
+    free(crcs);
+
+    printf("wrote %u cases of seed 0x%08X to %s\n", opts.cases, opts.seed, path);
+    return 0;
+}
+
+static int fuzz(void)
+{
+    int errors = run_cases(opts.seed, opts.cases, NULL);
+
+    printf("fuzz: %u cases of seed 0x%08X, %d canary error(s)\n", opts.cases, opts.seed, errors);
+    return errors;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double bench_one(lv_blend_fuzz_op_t op, const bench_variant_t *v, bool corner)
+{
+    const uint32_t dest_px_size = lv_blend_fuzz_dest_px_size(op);
+    const uint32_t src_px_size = lv_blend_fuzz_src_px_size(op);
+    const uint32_t dest_unalign = corner ? BENCH_UNALIGN_BYTES & ~((dest_px_size == 3 ? 1 : dest_px_size) - 1) : 0;
+    const uint32_t src_unalign = corner ? BENCH_UNALIGN_BYTES & ~((src_px_size == 3 || !src_px_size ? 1 : src_px_size) - 1) : 0;
+    const int32_t w = corner ? BENCH_DIM - 1 : BENCH_DIM;
+    const int32_t h = corner ? BENCH_DIM - 1 : BENCH_DIM;
+    const size_t px = BENCH_DIM * BENCH_DIM;
+    uint8_t *dest_mem = memalign(16, px * 4 + 16);
+    uint8_t *src_mem = memalign(16, px * 4 + 16);
+    uint8_t *mask_mem = memalign(16, px + 16);
+    uint32_t state = 0x1234567;
+    double start, elapsed;
+
+    if (!dest_mem || !src_mem || !mask_mem) {
+        free(dest_mem);
+        free(src_mem);
+        free(mask_mem);
+        return 0;
+    }
+    for (size_t i = 0; i < px * 4 + 16; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        dest_mem[i] = state;
+        src_mem[i] = state >> 8;
+        if (i < px + 16)
+            mask_mem[i] = (i % 4 == 0) ? LV_OPA_TRANSP : (i % 4 == 1) ? LV_OPA_COVER : (uint8_t)(state >> 16);
+    }
+
+    _lv_draw_sw_blend_fill_dsc_t fill_dsc = {
+        .dest_buf = dest_mem + dest_unalign,
+        .dest_w = w,
+        .dest_h = h,
+        .dest_stride = BENCH_DIM * dest_px_size,
+        .mask_buf = v->use_mask ? mask_mem + src_unalign : NULL,
+        .mask_stride = BENCH_DIM,
+        .color = {.blue = 0x56, .green = 0x34, .red = 0x12},
+        .opa = v->opa,
+    };
+    _lv_draw_sw_blend_image_dsc_t image_dsc = {
+        .dest_buf = fill_dsc.dest_buf,
+        .dest_w = w,
+        .dest_h = h,
+        .dest_stride = fill_dsc.dest_stride,
+        .mask_buf = fill_dsc.mask_buf,
+        .mask_stride = BENCH_DIM,
+        .src_buf = src_mem + src_unalign,
+        .src_stride = BENCH_DIM * src_px_size,
+        .opa = v->opa,
+        .blend_mode = LV_BLEND_MODE_NORMAL,
+    };
+
+    lv_blend_fuzz_call(op, &fill_dsc, &image_dsc);  // Warm up the caches
+    start = now_ns();
+    for (uint32_t i = 0; i < opts.iterations; i++) {
+        lv_blend_fuzz_call(op, &fill_dsc, &image_dsc);
+    }
+    elapsed = now_ns() - start;
+
+    free(dest_mem);
+    free(src_mem);
+    free(mask_mem);
+    return elapsed / opts.iterations / (w * h);
+}
+
+static int bench(void)
+{
+    if (opts.csv) {
+        printf("# op,variant,ideal_ns_per_px,corner_ns_per_px\n");
+    } else {
+        printf("ANSI reference, %dx%d ideal / %dx%d corner (%d unaligned bytes), %u iterations\n\n",
+               BENCH_DIM, BENCH_DIM, BENCH_DIM - 1, BENCH_DIM - 1, BENCH_UNALIGN_BYTES, opts.iterations);
+        printf("%-20s %-10s %12s %12s\n", "op", "variant", "ideal_ns/px", "corner_ns/px");
+    }
+
+    for (int op = 0; op < LV_BLEND_FUZZ_OP_COUNT; op++) {
+        for (size_t v = 0; v < sizeof(bench_variants) / sizeof(bench_variants[0]); v++) {
+            double ideal = bench_one(op, &bench_variants[v], false);
+            double corner = bench_one(op, &bench_variants[v], true);
+            printf(opts.csv ? "%s,%s,%.3f,%.3f\n" : "%-20s %-10s %12.3f %12.3f\n",
+                   lv_blend_fuzz_op_name(op), bench_variants[v].name, ideal, corner);
+        }
+    }
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [options]\n\n"
+           "Without options, checks the reference against lv_blend_golden.h.\n\n"
+           "  -w, --write FILE        Regenerate the golden header (use with --seed/--cases to change the sequence)\n"
+           "  -f, --fuzz              Run --cases cases of --seed, only checking for writes outside the destination\n"
+           "  -s, --seed N            Seed for --fuzz and --write (default 0x%08X)\n"
+           "  -n, --cases N           Case count for --fuzz and --write (default %u)\n"
+           "  -b, --bench             Time every blend entry, normal, with opa, mask and both\n"
+           "  -i, --iterations N      Benchmark iterations (default %u)\n"
+           "  -v, --verbose           Print every case\n"
+           "      --csv               Machine-readable benchmark output\n",
+           prog, opts.seed, opts.cases, opts.iterations);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        {"write",      required_argument, NULL, 'w'},
+        {"fuzz",       no_argument,       NULL, 'f'},
+        {"seed",       required_argument, NULL, 's'},
+        {"cases",      required_argument, NULL, 'n'},
+        {"bench",      no_argument,       NULL, 'b'},
+        {"iterations", required_argument, NULL, 'i'},
+        {"verbose",    no_argument,       NULL, 'v'},
+        {"csv",        no_argument,       NULL, 'x'},
+        {"help",       no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "w:fs:n:bi:vh", long_opts, NULL)) != -1) {
+        switch (opt) {
+            case 'w': opts.write_path = optarg; break;
+            case 'f': opts.fuzz = true; break;
+            case 's': opts.seed = strtoul(optarg, NULL, 0); break;
+            case 'n': opts.cases = strtoul(optarg, NULL, 0); break;
+            case 'b': opts.bench = true; break;
+            case 'i': opts.iterations = strtoul(optarg, NULL, 0); break;
+            case 'v': opts.verbose = true; break;
+            case 'x': opts.csv = true; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (opts.write_path)
+        return write_golden(opts.write_path) ? 1 : 0;
+    if (opts.fuzz)
+        return fuzz() ? 1 : 0;
+    if (opts.bench)
+        return bench();
+    return check_golden() ? 1 : 0;
+}
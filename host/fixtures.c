@@ -0,0 +1,119 @@
+/**
+ * @file fixtures.c
+ * @brief Synthetic .fw files and a factory-fresh flash image for the host tools
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_flash_partitions.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+#include <rom/crc.h>
+
+#include "firmware.h"
+#include "fixtures.h"
+#include "flash_emu.h"
+
+static uint32_t prng(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+void fixture_make_fw(const char *dir, const char *name, const char *description, const fixture_part_t *parts, size_t count, uint32_t seed)
+{
+    char path[512];
+    odroid_header_t header;
+    uint32_t crc = 0;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.version, HEADER_V00_01, HEADER_LENGTH);
+    strncpy(header.description, description, sizeof(header.description) - 1);
+    for (size_t i = 0; i < FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT; i++)
+        header.tile[i] = (uint16_t)(seed + i);
+
+    fwrite(&header, sizeof(header), 1, f);
+    crc = crc32_le(crc, (const uint8_t *)&header, sizeof(header));
+
+    for (size_t p = 0; p < count; p++) {
+        odroid_partition_t part = {
+            .type = parts[p].type,
+            .subtype = parts[p].subtype,
+            .length = parts[p].length,
+            .dataLength = parts[p].dataLength,
+            .digest = parts[p].digest,
+        };
+        mbedtls_sha256_context sha;
+        uint8_t digest[PART_DIGEST_SHA256_SIZE];
+        strncpy(part.label, parts[p].label, sizeof(part.label));
+        fwrite(&part, sizeof(part), 1, f);
+        crc = crc32_le(crc, (const uint8_t *)&part, sizeof(part));
+
+        uint8_t chunk[4096];
+        uint32_t state = seed * 31 + p + 1;
+        mbedtls_sha256_init(&sha);
+        mbedtls_sha256_starts(&sha, 0);
+        for (uint32_t done = 0; done < part.dataLength; done += sizeof(chunk)) {
+            uint32_t n = part.dataLength - done < sizeof(chunk) ? part.dataLength - done : sizeof(chunk);
+            for (uint32_t i = 0; i < n; i += 4) {
+                uint32_t v = prng(&state);
+                memcpy(chunk + i, &v, n - i < 4 ? n - i : 4);
+            }
+            fwrite(chunk, 1, n, f);
+            crc = crc32_le(crc, chunk, n);
+            mbedtls_sha256_update(&sha, chunk, n);
+        }
+
+        mbedtls_sha256_finish(&sha, digest);
+        if (part.digest == PART_DIGEST_SHA256) {
+            fwrite(digest, sizeof(digest), 1, f);
+            crc = crc32_le(crc, digest, sizeof(digest));
+        }
+    }
+
+    fwrite(&crc, sizeof(crc), 1, f);
+    fclose(f);
+}
+
+void fixture_make_app_fw(const char *dir, const char *name, const char *description, uint32_t size, uint32_t seed)
+{
+    fixture_part_t part = {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, "app", size, size - 0x10000};
+    fixture_make_fw(dir, name, description, &part, 1, seed);
+}
+
+
+void fixture_factory_flash(void)
+{
+    static const struct { const char *label; uint8_t type, subtype; uint32_t offset, size; } table[] = {
+        {"mfw_nvs",  ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS,    0x9000,  0x4000},
+        {"otadata",  ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_OTA,    0xD000,  0x2000},
+        {"phy_init", ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_PHY,    0xF000,  0x1000},
+        {"mfw_app",  ESP_PARTITION_TYPE_APP,  ESP_PARTITION_SUBTYPE_APP_FACTORY, 0x10000, 0xD0000},
+        {"mfw_data", ESP_PARTITION_TYPE_DATA, 0xFE,                              0xE0000, 0x20000},
+    };
+    esp_partition_info_t *info = (esp_partition_info_t *)(flash_emu_data() + ESP_PARTITION_TABLE_OFFSET);
+
+    memset(flash_emu_data(), 0xFF, flash_emu_size());
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        info[i].magic = ESP_PARTITION_MAGIC;
+        info[i].type = table[i].type;
+        info[i].subtype = table[i].subtype;
+        info[i].pos.offset = table[i].offset;
+        info[i].pos.size = table[i].size;
+        strncpy((char *)info[i].label, table[i].label, sizeof(info[i].label));
+        info[i].flags = 0;
+    }
+    flash_emu_reload_partitions();
+}
@@ -0,0 +1,33 @@
+/**
+ * @file fixtures.h
+ * @brief Synthetic .fw files and a factory-fresh flash image for the host tools
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint8_t type;
+    uint8_t subtype;
+    const char *label;
+    uint32_t length;
+    uint32_t dataLength;
+    uint8_t digest; // PART_DIGEST_*
+} fixture_part_t;
+
+/**
+ * Write dir/name in the tools/mkfw.py format, data and tile are seeded noise.
+ */
+void fixture_make_fw(const char *dir, const char *name, const char *description, const fixture_part_t *parts, size_t count, uint32_t seed);
+
+/**
+ * A single app partition of `size` bytes (64KB multiple) with enough slack that
+ * firmware_get_info carves the NVS partition out of it, so flashSize == size.
+ */
+void fixture_make_app_fw(const char *dir, const char *name, const char *description, uint32_t size, uint32_t seed);
+
+/**
+ * Flash a blank device the way idf.py would: partition table from partitions.csv, erased app table.
+ */
+void fixture_factory_flash(void);
@@ -0,0 +1,291 @@
+/**
+ * @file flash_emu.c
+ * @brief File-backed SPI flash and directory-backed SD card for host builds
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <esp_err.h>
+#include <esp_flash.h>
+#include <esp_flash_partitions.h>
+#include <esp_partition.h>
+#include <esp_timer.h>
+#include <rom/crc.h>
+
+#include "flash_emu.h"
+
+#define FLASH_EMU_MAX_PARTITIONS ESP_PARTITION_TABLE_MAX_ENTRIES
+
+flash_emu_stats_t flash_emu_stats;
+int host_log_level = 0;
+
+static uint8_t *flash;
+static uint32_t flash_size;
+static int flash_fd = -1;
+static uint32_t *wear;
+static esp_partition_t partitions[FLASH_EMU_MAX_PARTITIONS];
+static size_t partitions_count;
+
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_FAIL:              return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        default:                    return "UNKNOWN ERROR";
+    }
+}
+
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+    }
+    return ~crc;
+}
+
+
+int flash_emu_open(const char *path, uint32_t size)
+{
+    struct stat st;
+    bool created;
+
+    flash_fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (flash_fd < 0 || fstat(flash_fd, &st) != 0) {
+        perror(path);
+        return -1;
+    }
+
+    created = st.st_size == 0;
+    if (!created && st.st_size != size) {
+        fprintf(stderr, "%s: size is %ld, expected %u\n", path, (long)st.st_size, size);
+        return -1;
+    }
+    if (created && ftruncate(flash_fd, size) != 0) {
+        perror(path);
+        return -1;
+    }
+
+    flash = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, flash_fd, 0);
+    if (flash == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+    if (created) {
+        memset(flash, 0xFF, size);
+    }
+
+    flash_size = size;
+    wear = calloc(size / FLASH_EMU_SECTOR_SIZE, sizeof(uint32_t));
+    memset(&flash_emu_stats, 0, sizeof(flash_emu_stats));
+
+    return flash_emu_reload_partitions();
+}
+
+void flash_emu_close(void)
+{
+    if (flash) {
+        munmap(flash, flash_size);
+        flash = NULL;
+    }
+    if (flash_fd >= 0) {
+        close(flash_fd);
+        flash_fd = -1;
+    }
+    free(wear);
+    wear = NULL;
+    partitions_count = 0;
+}
+
+int flash_emu_reload_partitions(void)
+{
+    const esp_partition_info_t *table = (const esp_partition_info_t *)(flash + ESP_PARTITION_TABLE_OFFSET);
+
+    partitions_count = 0;
+
+    for (size_t i = 0; i < ESP_PARTITION_TABLE_MAX_ENTRIES; i++) {
+        const esp_partition_info_t *info = &table[i];
+        if (info->magic != ESP_PARTITION_MAGIC)
+            break;
+        if (info->pos.offset + info->pos.size > flash_size)
+            continue;
+
+        esp_partition_t *part = &partitions[partitions_count++];
+        memset(part, 0, sizeof(*part));
+        part->type = info->type;
+        part->subtype = info->subtype;
+        part->address = info->pos.offset;
+        part->size = info->pos.size;
+        part->erase_size = FLASH_EMU_SECTOR_SIZE;
+        memcpy(part->label, info->label, sizeof(info->label));
+    }
+
+    return 0;
+}
+
+uint8_t *flash_emu_data(void)
+{
+    return flash;
+}
+
+uint32_t flash_emu_size(void)
+{
+    return flash_size;
+}
+
+const uint32_t *flash_emu_wear(size_t *count)
+{
+    *count = flash_size / FLASH_EMU_SECTOR_SIZE;
+    return wear;
+}
+
+
+esp_err_t esp_flash_get_size(esp_flash_t *chip, uint32_t *out_size)
+{
+    *out_size = flash_size;
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length)
+{
+    if (!flash || (uint64_t)address + length > flash_size)
+        return ESP_ERR_INVALID_ARG;
+
+    memcpy(buffer, flash + address, length);
+
+    flash_emu_stats.reads++;
+    flash_emu_stats.read_bytes += length;
+    flash_emu_stats.sim_us += FLASH_EMU_READ_OP_US + length * FLASH_EMU_READ_BYTE_NS / 1000.0;
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length)
+{
+    const uint8_t *src = buffer;
+
+    if (!flash || (uint64_t)address + length > flash_size)
+        return ESP_ERR_INVALID_ARG;
+
+    // NOR flash can only clear bits, an erase is needed to set them again
+    for (uint32_t i = 0; i < length; i++) {
+        if (src[i] & ~flash[address + i])
+            flash_emu_stats.prog_violations++;
+        flash[address + i] &= src[i];
+    }
+
+    flash_emu_stats.progs++;
+    flash_emu_stats.prog_bytes += length;
+    flash_emu_stats.sim_us += FLASH_EMU_PROG_OP_US + length * FLASH_EMU_PROG_BYTE_NS / 1000.0;
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len)
+{
+    if (!flash || (uint64_t)start + len > flash_size)
+        return ESP_ERR_INVALID_ARG;
+    if (start % FLASH_EMU_SECTOR_SIZE || len % FLASH_EMU_SECTOR_SIZE)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(flash + start, 0xFF, len);
+
+    for (uint32_t i = start / FLASH_EMU_SECTOR_SIZE; i < (start + len) / FLASH_EMU_SECTOR_SIZE; i++)
+        wear[i]++;
+
+    // Same strategy as spi_flash: 64KB block erase whenever alignment and length allow it
+    while (len > 0) {
+        if (start % FLASH_EMU_BLOCK_SIZE == 0 && len >= FLASH_EMU_BLOCK_SIZE) {
+            flash_emu_stats.sim_us += FLASH_EMU_BLOCK_ERASE_US;
+            start += FLASH_EMU_BLOCK_SIZE;
+            len -= FLASH_EMU_BLOCK_SIZE;
+            flash_emu_stats.erase_bytes += FLASH_EMU_BLOCK_SIZE;
+        } else {
+            flash_emu_stats.sim_us += FLASH_EMU_SECTOR_ERASE_US;
+            start += FLASH_EMU_SECTOR_SIZE;
+            len -= FLASH_EMU_SECTOR_SIZE;
+            flash_emu_stats.erase_bytes += FLASH_EMU_SECTOR_SIZE;
+        }
+        flash_emu_stats.erases++;
+    }
+
+    return ESP_OK;
+}
+
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label)
+{
+    for (size_t i = 0; i < partitions_count; i++) {
+        const esp_partition_t *part = &partitions[i];
+        if (type != ESP_PARTITION_TYPE_ANY && part->type != type)
+            continue;
+        if (subtype != ESP_PARTITION_SUBTYPE_ANY && part->subtype != subtype)
+            continue;
+        if (label && strncmp(part->label, label, 16) != 0)
+            continue;
+        return part;
+    }
+    return NULL;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    if (src_offset + size > partition->size)
+        return ESP_ERR_INVALID_SIZE;
+    return esp_flash_read(NULL, dst, partition->address + src_offset, size);
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size)
+{
+    if (dst_offset + size > partition->size)
+        return ESP_ERR_INVALID_SIZE;
+    return esp_flash_write(NULL, src, partition->address + dst_offset, size);
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    if (offset + size > partition->size)
+        return ESP_ERR_INVALID_SIZE;
+    return esp_flash_erase_region(NULL, partition->address + offset, size);
+}
+
+
+/**
+ * The SD card is a plain directory, firmware.c reads it through stdio. The
+ * host build links with -Wl,--wrap=fread so reads are counted like flash reads.
+ */
+size_t __real_fread(void *ptr, size_t size, size_t nmemb, FILE *stream);
+
+size_t __wrap_fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
+{
+    size_t ret = __real_fread(ptr, size, nmemb, stream);
+
+    flash_emu_stats.sd_reads++;
+    flash_emu_stats.sd_read_bytes += ret * size;
+    flash_emu_stats.sim_us += FLASH_EMU_SD_READ_OP_US + ret * size * FLASH_EMU_SD_READ_BYTE_NS / 1000.0;
+    return ret;
+}
+
+/**
+ * Virtual clock for main/perf.c: only the modelled storage time advances it.
+ * ui_sim.c overrides it to also count FreeRTOS ticks spent waiting for input.
+ */
+__attribute__((weak)) int64_t esp_timer_get_time(void)
+{
+    return flash_emu_stats.sim_us;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file flash_emu.h
+ * @brief File-backed SPI flash and directory-backed SD card for host builds
+ *
+ * Implements the esp_flash_* and esp_partition_* calls used by main/firmware.c
+ * on top of a regular file, and counts every operation so the cost of an
+ * install/defrag/boot sequence can be measured without hardware.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLASH_EMU_SECTOR_SIZE   0x1000
+#define FLASH_EMU_BLOCK_SIZE    0x10000
+
+/**
+ * Latency model, typical datasheet values for the 40MHz QIO parts on ESP32 boards
+ * and for an SD card on a 20MHz SPI bus (command overhead dominates small reads).
+ */
+#define FLASH_EMU_READ_OP_US        5.0
+#define FLASH_EMU_READ_BYTE_NS      50.0
+#define FLASH_EMU_PROG_OP_US        10.0
+#define FLASH_EMU_PROG_BYTE_NS      2750.0
+#define FLASH_EMU_SECTOR_ERASE_US   45000.0
+#define FLASH_EMU_BLOCK_ERASE_US    150000.0
+#define FLASH_EMU_SD_READ_OP_US     200.0
+#define FLASH_EMU_SD_READ_BYTE_NS   400.0
+
+typedef struct {
+    uint64_t reads, progs, erases;
+    uint64_t read_bytes, prog_bytes, erase_bytes;
+    uint64_t sd_reads, sd_read_bytes;
+    uint64_t prog_violations;   // Bytes where a program tried to set a 0 bit back to 1
+    double sim_us;
+} flash_emu_stats_t;
+
+extern flash_emu_stats_t flash_emu_stats;
+
+/**
+ * Open (or create, filled with 0xFF) the backing file and parse the partition table.
+ */
+int flash_emu_open(const char *path, uint32_t size);
+void flash_emu_close(void);
+
+/**
+ * Re-read the partition table, what the device does when it reboots.
+ */
+int flash_emu_reload_partitions(void);
+
+/**
+ * Direct access to the flash contents, bypasses the counters.
+ */
+uint8_t *flash_emu_data(void);
+uint32_t flash_emu_size(void);
+
+/**
+ * Erase count of every 4KB sector.
+ */
+const uint32_t *flash_emu_wear(size_t *count);
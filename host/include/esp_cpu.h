@@ -0,0 +1,9 @@
+// Host shim, there is no cycle counter to read
+#pragma once
+
+#include <stdint.h>
+
+static inline uint32_t esp_cpu_get_cycle_count(void)
+{
+    return 0;
+}
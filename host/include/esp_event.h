@@ -0,0 +1,2 @@
+// Host shim, nothing needed
+#pragma once
@@ -0,0 +1,26 @@
+// Host shim, only what the multi-firmware core needs.
+#pragma once
+
+#include <stdio.h>
+
+extern int host_log_level; // 0 = errors only, 1 = info, 2 = debug
+
+#define ESP_LOG_HOST(level, letter, tag, format, ...) \
+    do { if (host_log_level >= (level)) fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__); } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_HOST(0, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_HOST(0, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_HOST(1, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_HOST(2, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_HOST(3, "V", tag, format, ##__VA_ARGS__)
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+#define esp_log_level_set(tag, level) ((void)(tag), (void)(level))
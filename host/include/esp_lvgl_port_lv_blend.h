@@ -0,0 +1,2 @@
+// Host shim, there are no assembly blends on the host, the blend sources keep LVGL's default hooks
+#pragma once
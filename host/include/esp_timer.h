@@ -0,0 +1,6 @@
+// Host shim, microseconds since the simulator started
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
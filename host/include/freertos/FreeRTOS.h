@@ -0,0 +1,14 @@
+// Host shim, a single thread on a virtual clock. vTaskDelay only advances the clock.
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#define configTICK_RATE_HZ      100
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFF)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)((uint64_t)(ms) * configTICK_RATE_HZ / 1000))
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
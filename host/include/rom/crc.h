@@ -0,0 +1,6 @@
+// Host shim, same semantics as the ROM: crc32_le(0, buf, len) == zlib crc32(buf, len)
+#pragma once
+
+#include <stdint.h>
+
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
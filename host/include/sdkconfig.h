@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in for the generated sdkconfig.h, nothing is configured.
+// The lv_blend reference sources (blend_fuzz) include it; without CONFIG_LV_DRAW_SW_ASM_CUSTOM their assembly hooks stay LV_RESULT_INVALID.
@@ -0,0 +1,733 @@
+/**
+ * @file mfw_bench.c
+ * @brief Host benchmark of the multi-firmware install/update/delete/defrag paths
+ *
+ * Links main/firmware.c against flash_emu.c, generates synthetic .fw files in a
+ * directory standing in for the SD card and runs a fixed sequence of scenarios,
+ * each driven exactly like the boot menu drives it. Every scenario reports the
+ * flash and SD traffic it caused and a simulated wall time from the latency model
+ * in flash_emu.h. Everything is seeded, results can be compared against a baseline.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <esp_flash_partitions.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+
+#include "firmware.h"
+#include "fixtures.h"
+#include "flash_emu.h"
+
+#define BENCH_MAX_ROWS      32
+
+typedef struct {
+    const char *name;
+    uint32_t ops;
+    flash_emu_stats_t stats;
+} bench_result_t;
+
+static struct {
+    uint32_t flash_size;
+    const char *workdir;
+    const char *baseline;
+    double tolerance;
+    bool check;
+    bool csv;
+} opts = {
+    .flash_size = 16 * 1024 * 1024,
+    .workdir = "mfw_bench_data",
+    .tolerance = 5.0,
+};
+
+static bench_result_t results[BENCH_MAX_ROWS];
+static size_t results_count;
+static uint32_t ui_updates;
+static char sd_path[256];
+
+
+void firmware_ui_panic(const char *reason)
+{
+    fprintf(stderr, "PANIC: %s\n", reason);
+    exit(2);
+}
+
+void firmware_ui_page(const char *title, const char *header, const char *footer)
+{
+    ui_updates++;
+}
+
+void firmware_ui_progress(const char *message, int percent)
+{
+    if (message)
+        ui_updates++;
+}
+
+void firmware_ui_led(bool on)
+{
+}
+
+
+/**
+ * What flash_firmware() in main.c does once the user pressed START.
+ */
+static odroid_app_t *install(const char *name)
+{
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/%s", sd_path, name);
+
+    odroid_fw_t *fw = firmware_get_info(path);
+    if (!fw)
+        firmware_ui_panic("INVALID FIRMWARE FILE");
+
+    int address = find_free_block(fw->flashSize, true);
+    if (address < 0)
+        firmware_ui_panic("NOT ENOUGH FREE SPACE");
+
+    if (!firmware_verify(path, fw))
+        firmware_ui_panic("CHECKSUM MISMATCH ERROR");
+
+    odroid_app_t *app = firmware_install(path, fw, address);
+    free(fw);
+    return app;
+}
+
+/**
+ * What flash_firmware_batch() in main.c does once the user pressed START.
+ */
+static void install_batch(const char **names, int count)
+{
+    const char *paths[FIRMWARE_BATCH_MAX];
+    odroid_fw_t *fws[FIRMWARE_BATCH_MAX];
+    int addresses[FIRMWARE_BATCH_MAX];
+
+    for (int i = 0; i < count; i++) {
+        char *path = safe_alloc(512);
+        snprintf(path, 512, "%s/%s", sd_path, names[i]);
+        if (!(fws[i] = firmware_get_info(path)))
+            firmware_ui_panic("INVALID FIRMWARE FILE");
+        paths[i] = path;
+    }
+
+    if (!firmware_plan_batch(fws, count, addresses))
+        firmware_ui_panic("NOT ENOUGH FREE SPACE");
+
+    for (int i = 0; i < count; i++)
+        if (!firmware_verify_crc(paths[i], fws[i]))
+            firmware_ui_panic("CHECKSUM MISMATCH ERROR");
+
+    firmware_install_batch(paths, fws, addresses, count);
+
+    for (int i = 0; i < count; i++) {
+        free((void *)paths[i]);
+        free(fws[i]);
+    }
+}
+
+static int find_app(const char *name)
+{
+    for (int i = 0; i < apps_count; i++)
+        if (strcmp(apps[i].filename + 1, name) == 0)
+            return i;
+    return -1;
+}
+
+
+/**
+ * Every installed app must match its .fw byte for byte and no two apps may overlap.
+ */
+static int check_flash(const char *scenario)
+{
+    const uint8_t *flash = flash_emu_data();
+    int errors = 0;
+
+    if (flash_emu_stats.prog_violations) {
+        fprintf(stderr, "CHECK %s: %llu bytes programmed without erase\n", scenario,
+                (unsigned long long)flash_emu_stats.prog_violations);
+        errors++;
+    }
+
+    sort_app_table(LIST_SORT_OFFSET);
+
+    for (int i = 0; i < apps_count; i++) {
+        const odroid_app_t *app = &apps[i];
+        char path[512];
+
+        if (app->startOffset < firstAppOffset || app->endOffset >= flash_emu_size()
+            || (i > 0 && app->startOffset <= apps[i - 1].endOffset)) {
+            fprintf(stderr, "CHECK %s: '%s' bad placement 0x%x-0x%x\n", scenario, app->description,
+                    app->startOffset, app->endOffset);
+            errors++;
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s%s", sd_path, app->filename);
+        FILE *f = fopen(path, "rb");
+        if (!f) {
+            perror(path);
+            errors++;
+            continue;
+        }
+
+        uint32_t offset = app->startOffset;
+        fseek(f, sizeof(odroid_header_t), SEEK_SET);
+        for (int p = 0; p < app->parts_count; p++) {
+            const odroid_partition_t *part = &app->parts[p];
+            if (part->dataLength > 0) {
+                uint8_t *data = safe_alloc(part->dataLength);
+                fseek(f, sizeof(odroid_partition_t), SEEK_CUR);
+                if (fread(data, 1, part->dataLength, f) != part->dataLength
+                    || memcmp(data, flash + offset, part->dataLength) != 0) {
+                    fprintf(stderr, "CHECK %s: '%s' partition %d differs\n", scenario, app->description, p);
+                    errors++;
+                }
+                if (part->digest == PART_DIGEST_SHA256)
+                    fseek(f, PART_DIGEST_SHA256_SIZE, SEEK_CUR);
+                free(data);
+            }
+            offset += part->length;
+        }
+        fclose(f);
+    }
+
+    return errors;
+}
+
+static int check_boot(const odroid_app_t *app)
+{
+    const uint32_t *otadata = (const uint32_t *)(flash_emu_data() + 0xD000);
+    int errors = 0;
+
+    // What the bootloader sees after the restart
+    flash_emu_reload_partitions();
+
+    if (otadata[0] != 1 || otadata[7] != 0x4743989A) {
+        fprintf(stderr, "CHECK boot: otadata not set\n");
+        errors++;
+    }
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, NULL);
+    if (!part || part->address != app->startOffset) {
+        fprintf(stderr, "CHECK boot: ota_0 is not at 0x%x\n", app->startOffset);
+        errors++;
+    }
+
+    if (!esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "mfw_data")) {
+        fprintf(stderr, "CHECK boot: system partitions were lost\n");
+        errors++;
+    }
+
+    return errors;
+}
+
+
+/**
+ * What tools/pack.py builds: the current system block followed by a new factory app, stored at
+ * offset the way the installer .fw leaves its payload partition.
+ */
+static uint8_t *make_install_image(uint32_t offset, uint32_t size)
+{
+    uint8_t *image = safe_alloc(size);
+    uint32_t state = 0x1207;
+
+    memcpy(image, flash_emu_data(), FLASH_BLOCK_SIZE);
+    for (uint32_t i = FLASH_BLOCK_SIZE; i < size; i++) {
+        state = state * 1103515245 + 12345;
+        image[i] = state >> 16;
+    }
+
+    memcpy(flash_emu_data() + offset, image, size);
+    return image;
+}
+
+static int check_install_image(const uint8_t *image, uint32_t size, bool rerun)
+{
+    int errors = 0;
+
+    if (memcmp(flash_emu_data(), image, size) != 0) {
+        fprintf(stderr, "CHECK self_install: flash differs from the image\n");
+        errors++;
+    }
+    if (rerun && results[results_count - 1].stats.erase_bytes != 0) {
+        fprintf(stderr, "CHECK self_install: rerun erased blocks that were already in place\n");
+        errors++;
+    }
+
+    return errors;
+}
+
+
+static void record(const char *name, uint32_t ops, const flash_emu_stats_t *before)
+{
+    const flash_emu_stats_t *after = &flash_emu_stats;
+
+    if (results_count >= BENCH_MAX_ROWS)
+        return;
+
+    bench_result_t *r = &results[results_count++];
+    r->name = name;
+    r->ops = ops;
+    r->stats = (flash_emu_stats_t){
+        .reads = after->reads - before->reads,
+        .progs = after->progs - before->progs,
+        .erases = after->erases - before->erases,
+        .read_bytes = after->read_bytes - before->read_bytes,
+        .prog_bytes = after->prog_bytes - before->prog_bytes,
+        .erase_bytes = after->erase_bytes - before->erase_bytes,
+        .sd_reads = after->sd_reads - before->sd_reads,
+        .sd_read_bytes = after->sd_read_bytes - before->sd_read_bytes,
+        .prog_violations = after->prog_violations - before->prog_violations,
+        .sim_us = after->sim_us - before->sim_us,
+    };
+
+    if (opts.csv) {
+        printf("%s,%u,%.0f,%llu,%llu,%llu,%llu\n", r->name, r->ops, r->stats.sim_us,
+               (unsigned long long)r->stats.sd_read_bytes, (unsigned long long)r->stats.read_bytes,
+               (unsigned long long)r->stats.prog_bytes, (unsigned long long)r->stats.erase_bytes);
+        return;
+    }
+    printf("%-16s %4u %10.1f %10llu %10llu %10llu %10llu %7llu %7llu %6llu\n", r->name, r->ops,
+           r->stats.sim_us / 1000.0, (unsigned long long)r->stats.sd_read_bytes,
+           (unsigned long long)r->stats.read_bytes, (unsigned long long)r->stats.prog_bytes,
+           (unsigned long long)r->stats.erase_bytes, (unsigned long long)r->stats.reads,
+           (unsigned long long)r->stats.progs, (unsigned long long)r->stats.erases);
+}
+
+static void print_wear(void)
+{
+    size_t count;
+    const uint32_t *wear = flash_emu_wear(&count);
+    size_t first = firstAppOffset / FLASH_EMU_SECTOR_SIZE;
+    uint32_t max = 0, touched = 0;
+    double sum = 0;
+
+    for (size_t i = first; i < count; i++) {
+        touched += wear[i] > 0;
+        max = wear[i] > max ? wear[i] : max;
+        sum += wear[i];
+    }
+
+    if (opts.csv)
+        return;
+
+    printf("\nwear (app area): %u/%u sectors erased, avg %.2f, max %u; app table %u, partition table %u, otadata %u\n",
+           touched, (unsigned)(count - first), sum / (count - first), max,
+           wear[0xE0000 / FLASH_EMU_SECTOR_SIZE], wear[ESP_PARTITION_TABLE_OFFSET / FLASH_EMU_SECTOR_SIZE],
+           wear[0xD000 / FLASH_EMU_SECTOR_SIZE]);
+}
+
+
+static double mb_per_s(const struct timespec *start, size_t bytes)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return bytes / ((end.tv_sec - start->tv_sec) * 1e6 + (end.tv_nsec - start->tv_nsec) / 1e3);
+}
+
+/**
+ * Host CPU throughput of the integrity checks. The device reports its own in the perf console
+ * line of every verify/install (crc and sha256 stages, MBps and cpB).
+ */
+static void print_hash_throughput(void)
+{
+    const size_t size = 16 * 1024 * 1024;
+    uint8_t *data = safe_alloc(size);
+    uint32_t table[256], crc = 0, state = 1;
+    mbedtls_sha256_context sha;
+    uint8_t digest[32];
+    struct timespec start;
+
+    if (opts.csv) {
+        free(data);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++)
+        data[i] = state = state * 1103515245 + 12345;
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c >> 1) ^ (0xEDB88320U & -(c & 1));
+        table[i] = c;
+    }
+
+    // What the ROM's crc32_le() does
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    crc = ~crc;
+    double bytewise = mb_per_s(&start, size);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint32_t sliced = firmware_crc32(0, data, size);
+    double slicedRate = mb_per_s(&start, size);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    mbedtls_sha256_update(&sha, data, size);
+    mbedtls_sha256_finish(&sha, digest);
+    double shaRate = mb_per_s(&start, size);
+
+    printf("host cpu: crc32 bytewise %.0f MB/s, sliced %.0f MB/s%s, sha256 (software) %.0f MB/s\n",
+           bytewise, slicedRate, crc == sliced ? "" : " (MISMATCH)", shaRate);
+    free(data);
+}
+
+
+/**
+ * Writes a pattern to the app's NVS partition, or checks that it is there.
+ */
+static int fill_nvs(const odroid_app_t *app, bool write)
+{
+    uint8_t *flash = flash_emu_data();
+    uint32_t offset = app->startOffset;
+
+    for (int p = 0; p < app->parts_count; offset += app->parts[p++].length) {
+        if (app->parts[p].subtype != ESP_PARTITION_SUBTYPE_DATA_NVS || app->parts[p].type != ESP_PARTITION_TYPE_DATA)
+            continue;
+        // Two used pages, the rest erased, about what an app's settings look like
+        for (uint32_t i = 0; i < 2 * FLASH_EMU_SECTOR_SIZE; i++) {
+            if (write) {
+                flash[offset + i] = (uint8_t)(i * 13 + 0x5A);
+            } else if (flash[offset + i] != (uint8_t)(i * 13 + 0x5A)) {
+                fprintf(stderr, "CHECK nvs_restore: NVS differs at 0x%x\n", offset + i);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    fprintf(stderr, "CHECK nvs: '%s' has no NVS partition\n", app->description);
+    return 1;
+}
+
+
+static int run(void)
+{
+    static const struct { const char *name; uint32_t size; } initial[] = {
+        {"nes.fw", 0x100000}, {"gb.fw", 0x180000}, {"sms.fw", 0x0C0000},
+        {"doom.fw", 0x200000}, {"spectrum.fw", 0x0E0000}, {"chip8.fw", 0x040000},
+    };
+    flash_emu_stats_t before;
+    odroid_app_t *app;
+    int errors = 0;
+    uint32_t ops;
+
+#define SCENARIO(name, ops, body) do { before = flash_emu_stats; body; record(name, ops, &before); \
+        if (opts.check) errors += check_flash(name); } while (0)
+
+    fixture_factory_flash();
+    read_app_table();
+
+    for (size_t i = 0; i < sizeof(initial) / sizeof(initial[0]); i++)
+        fixture_make_app_fw(sd_path, initial[i].name, initial[i].name, initial[i].size, i + 1);
+    fixture_make_app_fw(sd_path, "gb_v2.fw", "gb.fw v2", 0x1C0000, 100);
+    {
+        fixture_part_t parts[] = {
+            {ESP_PARTITION_TYPE_APP,  ESP_PARTITION_SUBTYPE_APP_OTA_0,  "app",  0x100000, 0xC8000},
+            {ESP_PARTITION_TYPE_DATA, 0x40,                             "data", 0x080000, 0x7F000},
+        };
+        fixture_make_fw(sd_path, "multi.fw", "multi partition", parts, 2, 200);
+    }
+    {
+        fixture_part_t part = {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, "app", 0x100000, 0xF0000};
+        fixture_make_fw(sd_path, "crc.fw", "crc", &part, 1, 500);
+        part.digest = PART_DIGEST_SHA256;
+        fixture_make_fw(sd_path, "sha256.fw", "sha256", &part, 1, 500);
+    }
+
+    SCENARIO("install", sizeof(initial) / sizeof(initial[0]),
+        for (size_t i = 0; i < sizeof(initial) / sizeof(initial[0]); i++) install(initial[i].name));
+
+    SCENARIO("install_multi", 1, install("multi.fw"));
+
+    // The same app with and without partition digests, the SHA-256 is checked while writing so the
+    // CRC pass over the file goes away. Both are removed again, the layout below doesn't change.
+    SCENARIO("install_crc", 1, install("crc.fw"));
+    remove_app(find_app("crc.fw"));
+    SCENARIO("install_sha256", 1, install("sha256.fw"));
+    remove_app(find_app("sha256.fw"));
+
+    SCENARIO("boot", 1, write_boot_partition(&apps[find_app("sms.fw")]));
+    if (opts.check)
+        errors += check_boot(&apps[find_app("sms.fw")]);
+
+    // Booting the app that is already configured must not erase anything
+    SCENARIO("relaunch", 1, write_boot_partition(&apps[find_app("sms.fw")]));
+    if (opts.check)
+        errors += check_boot(&apps[find_app("sms.fw")]);
+
+    // An update is a remove followed by an install, the new build is bigger than the hole it leaves
+    SCENARIO("update", 1, remove_app(find_app("gb.fw")); install("gb_v2.fw"));
+
+    SCENARIO("delete", 1, remove_app(find_app("doom.fw")));
+
+    SCENARIO("defrag", 1, defrag_flash());
+
+    SCENARIO("read_table", 1, read_app_table());
+
+    // Fill the flash, punch two holes, then install something that only fits after a defrag
+    ops = 0;
+    SCENARIO("fill", ops,
+        for (uint32_t seed = 300; find_free_block(0x200000, false) >= 0; seed++) {
+            char name[32];
+            snprintf(name, sizeof(name), "fill%u.fw", seed);
+            fixture_make_app_fw(sd_path, name, name, 0x200000, seed);
+            install(name);
+            ops++;
+        });
+    results[results_count - 1].ops = ops;
+
+    remove_app(find_app("fill301.fw"));
+    remove_app(find_app("fill303.fw"));
+    {
+        odroid_flash_block_t *blocks;
+        size_t count, total, largest = 0;
+        find_free_blocks(&blocks, &count, &total);
+        for (size_t i = 0; i < count; i++)
+            largest = blocks[i].size > largest ? blocks[i].size : largest;
+        free(blocks);
+        largest += FLASH_BLOCK_SIZE;
+        fixture_make_app_fw(sd_path, "big.fw", "big", largest, 400);
+    }
+    SCENARIO("install_defrag", 1, app = install("big.fw"));
+
+    SCENARIO("boot_defragged", 1, write_boot_partition(app));
+    if (opts.check)
+        errors += check_boot(app);
+
+    // The self-installer streams a bootloader + factory app image over 0x0. Running it again, which
+    // is what happens after an interrupted install, must find every block in place.
+    remove_app(find_app("big.fw"));
+    {
+        const uint32_t imageSize = 0xD8A40;
+        int imageOffset = find_free_block(imageSize, false);
+        uint8_t *image = make_install_image(imageOffset, imageSize);
+
+        SCENARIO("self_install", 1, firmware_install_image(imageOffset, imageSize));
+        if (opts.check)
+            errors += check_install_image(image, imageSize, false);
+
+        SCENARIO("self_resume", 1, firmware_install_image(imageOffset, imageSize));
+        if (opts.check)
+            errors += check_install_image(image, imageSize, true);
+
+        free(image);
+    }
+
+    // Three files picked at once: placed together, one defrag because the big one fits no hole,
+    // one app table write
+    sort_app_table(LIST_SORT_OFFSET);
+    remove_app(3);
+    remove_app(1);
+    {
+        static const char *batch[] = {"batch_a.fw", "batch_b.fw", "batch_c.fw"};
+        odroid_flash_block_t *blocks;
+        size_t count, total, largest = 0;
+        find_free_blocks(&blocks, &count, &total);
+        for (size_t i = 0; i < count; i++)
+            largest = blocks[i].size > largest ? blocks[i].size : largest;
+        free(blocks);
+        fixture_make_app_fw(sd_path, batch[0], "batch a", 0x040000, 600);
+        fixture_make_app_fw(sd_path, batch[1], "batch b", largest + FLASH_BLOCK_SIZE, 601);
+        fixture_make_app_fw(sd_path, batch[2], "batch c", 0x040000, 602);
+
+        SCENARIO("install_batch", 3, install_batch(batch, 3));
+    }
+
+    // An update keeps the app's settings: they go to the SD card when it is deleted and come back
+    // after the new build is installed, wherever that lands
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/batch_a.fw.data", sd_path);
+        app = &apps[find_app("batch_a.fw")];
+        errors += fill_nvs(app, true);
+
+        SCENARIO("nvs_backup", 1, firmware_backup_data(app, path, true); remove_app(find_app("batch_a.fw")));
+        SCENARIO("nvs_restore", 1, app = install("batch_a.fw"); firmware_restore_data(app, path, false));
+        errors += fill_nvs(&apps[find_app("batch_a.fw")], false); // --check sorts the table
+
+        // A truncated backup is refused before anything is erased
+        struct stat st;
+        if (stat(path, &st) != 0 || truncate(path, st.st_size - 100) != 0
+            || firmware_restore_data(&apps[find_app("batch_a.fw")], path, false)) {
+            fprintf(stderr, "CHECK nvs_restore: truncated backup was restored\n");
+            errors++;
+        }
+        errors += fill_nvs(&apps[find_app("batch_a.fw")], false);
+    }
+
+    // More partitions than an app can have are refused while reading the records, not after
+    {
+        fixture_part_t parts[FIRMWARE_PARTS_MAX + 4];
+        for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+            parts[i] = (fixture_part_t){ESP_PARTITION_TYPE_DATA, 0x99, "data", 0x1000, 0x100, PART_DIGEST_SHA256};
+        fixture_make_fw(sd_path, "too_many_parts.fw", "too many parts", parts, sizeof(parts) / sizeof(parts[0]), 700);
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/too_many_parts.fw", sd_path);
+        odroid_fw_t *fw = firmware_get_info(path);
+        if (fw) {
+            fprintf(stderr, "CHECK get_info: %d partitions accepted\n", fw->parts_count);
+            free(fw);
+            errors++;
+        }
+    }
+
+    // The batch pre-pass reads files with digests too, a corrupt one is refused before any write
+    {
+        fixture_part_t part = {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, "app", 0x040000, 0x030000, PART_DIGEST_SHA256};
+        fixture_make_fw(sd_path, "corrupt_sha256.fw", "corrupt", &part, 1, 701);
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/corrupt_sha256.fw", sd_path);
+        odroid_fw_t *fw = firmware_get_info(path);
+        FILE *f = fopen(path, "r+b");
+        if (f) {
+            long offset = fw ? (long)(fw->dataOffset + sizeof(odroid_partition_t) + 0x100) : 0;
+            fseek(f, offset, SEEK_SET);
+            int c = fgetc(f);
+            fseek(f, offset, SEEK_SET);
+            fputc(c ^ 0xFF, f);
+            fclose(f);
+        }
+        if (!fw || !fw->digestsComplete || firmware_verify_crc(path, fw)) {
+            fprintf(stderr, "CHECK verify_crc: corrupt file with digests passed\n");
+            errors++;
+        }
+        free(fw);
+    }
+
+#undef SCENARIO
+
+    print_wear();
+    print_hash_throughput();
+
+    if (errors)
+        fprintf(stderr, "%d check error(s)\n", errors);
+    return errors;
+}
+
+static int compare_baseline(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256], name[32];
+    unsigned ops;
+    double sim_us;
+    unsigned long long sd_bytes, read_bytes, prog_bytes, erase_bytes;
+    int regressions = 0;
+
+    if (!f) {
+        fprintf(stderr, "cannot open baseline %s\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || sscanf(line, "%31[^,],%u,%lf,%llu,%llu,%llu,%llu", name, &ops, &sim_us,
+                                     &sd_bytes, &read_bytes, &prog_bytes, &erase_bytes) != 7) {
+            continue;
+        }
+        for (size_t i = 0; i < results_count; i++) {
+            const bench_result_t *r = &results[i];
+            double limit = 1.0 + opts.tolerance / 100.0;
+            if (strcmp(r->name, name))
+                continue;
+            if (r->stats.sim_us > sim_us * limit || r->stats.prog_bytes > prog_bytes * limit
+                || r->stats.erase_bytes > erase_bytes * limit) {
+                fprintf(stderr, "REGRESSION %s: time %.0f -> %.0f us, prog %llu -> %llu, erase %llu -> %llu\n",
+                        name, sim_us, r->stats.sim_us, prog_bytes, (unsigned long long)r->stats.prog_bytes,
+                        erase_bytes, (unsigned long long)r->stats.erase_bytes);
+                regressions++;
+            }
+        }
+    }
+
+    fclose(f);
+    if (!opts.csv)
+        printf("Baseline %s: %d regression(s) above %.1f%%\n", path, regressions, opts.tolerance);
+    return regressions ? 1 : 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [options]\n\n"
+           "  -s, --flash-size MB     Emulated flash size (default %u)\n"
+           "  -d, --dir PATH          Work directory for flash.bin and the sdcard folder (default %s)\n"
+           "  -k, --check             Verify flash contents against the .fw files after every scenario\n"
+           "  -b, --baseline FILE     Fail if time/prog/erase exceed FILE by more than the tolerance\n"
+           "  -t, --tolerance PCT     Baseline tolerance in percent (default %.1f)\n"
+           "  -v, --verbose           Show the firmware core's log output\n"
+           "      --csv               Machine-readable output, same format as the baseline\n",
+           prog, (unsigned)(opts.flash_size >> 20), opts.workdir, opts.tolerance);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        {"flash-size", required_argument, NULL, 's'},
+        {"dir",        required_argument, NULL, 'd'},
+        {"check",      no_argument,       NULL, 'k'},
+        {"baseline",   required_argument, NULL, 'b'},
+        {"tolerance",  required_argument, NULL, 't'},
+        {"verbose",    no_argument,       NULL, 'v'},
+        {"csv",        no_argument,       NULL, 'x'},
+        {"help",       no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    char flash_path[256];
+    int opt, err;
+
+    while ((opt = getopt_long(argc, argv, "s:d:kb:t:vh", long_opts, NULL)) != -1) {
+        switch (opt) {
+            case 's': opts.flash_size = strtoul(optarg, NULL, 0) << 20; break;
+            case 'd': opts.workdir = optarg; break;
+            case 'k': opts.check = true; break;
+            case 'b': opts.baseline = optarg; break;
+            case 't': opts.tolerance = strtod(optarg, NULL); break;
+            case 'v': host_log_level++; break;
+            case 'x': opts.csv = true; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    snprintf(sd_path, sizeof(sd_path), "%s/sdcard", opts.workdir);
+    snprintf(flash_path, sizeof(flash_path), "%s/flash.bin", opts.workdir);
+    mkdir(opts.workdir, 0755);
+    mkdir(sd_path, 0755);
+    remove(flash_path);
+
+    if (flash_emu_open(flash_path, opts.flash_size) != 0)
+        return 1;
+
+    if (opts.csv) {
+        printf("# scenario,ops,sim_us,sd_read_bytes,read_bytes,prog_bytes,erase_bytes\n");
+    } else {
+        printf("flash %u MB, app table %d slots\n\n", (unsigned)(opts.flash_size >> 20),
+               (int)(0x20000 / sizeof(odroid_app_t)));
+        printf("%-16s %4s %10s %10s %10s %10s %10s %7s %7s %6s\n", "scenario", "ops", "sim_ms",
+               "sd_read_B", "read_B", "prog_B", "erase_B", "reads", "progs", "erases");
+    }
+
+    err = run();
+
+    if (!err && opts.baseline)
+        err = compare_baseline(opts.baseline);
+
+    flash_emu_close();
+    return err ? 1 : 0;
+}
@@ -0,0 +1,810 @@
+/**
+ * @file ui_sim.c
+ * @brief Headless host simulator of the boot menu
+ *
+ * Builds main/main.c unchanged for Linux and runs app_main() against the flash
+ * emulator, a directory standing in for the SD card and scripted button input.
+ * Every LCD flush is diffed against the previous one and can be dumped as a PPM
+ * file. For every interaction (the work done between two input reads) it reports
+ * frames flushed, pixels drawn through uGUI, pixels that actually changed, bytes
+ * that would have gone over the LCD SPI bus, and the flash/SD traffic it caused.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <ctype.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_system.h>
+#include <esp_ota_ops.h>
+#include <esp_log.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <driver/gpio.h>
+
+#include "battery.h"
+#include "display.h"
+#include "input.h"
+#include "sdcard.h"
+#include "ugui/ugui.h"
+
+#include "firmware.h"
+#include "fixtures.h"
+#include "flash_emu.h"
+
+#define SIM_MAX_ROWS            256
+#define SIM_MAX_SCRIPT          1024
+#define SIM_STUCK_TICKS         pdMS_TO_TICKS(60 * 1000)
+#define SIM_NVS_MAX_KEYS        16
+
+// display.c sends the frame as 4-row esp_lcd_panel_draw_bitmap() calls, each is CASET + RASET + RAMWR
+#define SIM_LCD_CHUNK_HEIGHT    4
+#define SIM_LCD_CMD_BYTES       (1 + 4 + 1 + 4 + 1)
+#define SIM_LCD_SPI_HZ          40000000.0
+
+#define SIM_TOKEN_IDLE          (-2)
+
+typedef struct {
+    char label[16];
+    uint32_t flushes;
+    uint64_t pixels_drawn;
+    uint64_t pixels_changed;
+    uint64_t spi_bytes;
+    uint64_t cpu_us;
+    flash_emu_stats_t storage;
+} sim_row_t;
+
+static const char *button_names[ODROID_INPUT_MAX] = {
+    "UP", "RIGHT", "DOWN", "LEFT", "SELECT", "START", "A", "B", "MENU", "VOLUME",
+};
+
+static struct {
+    const char *workdir;
+    const char *script;
+    const char *dump_dir;
+    const char *baseline;
+    double tolerance;
+    int battery_mv;
+    bool csv;
+} opts = {
+    .workdir = "ui_sim_data",
+    .script = "idle DOWN DOWN DOWN DOWN RIGHT LEFT UP SELECT idle MENU DOWN DOWN DOWN DOWN B B idle "
+              "MENU A DOWN*4 A START B A",
+    .tolerance = 5.0,
+    .battery_mv = 3900,
+};
+
+static int script[SIM_MAX_SCRIPT];
+static int script_repeats[SIM_MAX_SCRIPT]; // BUTTON+N: held long enough that N auto-repeats were merged
+static size_t script_count, script_pos;
+
+static sim_row_t rows[SIM_MAX_ROWS];
+static size_t rows_count;
+static sim_row_t current;
+static flash_emu_stats_t current_storage;
+static struct timespec current_cpu;
+
+static uint16_t last_frame[SCREEN_WIDTH * SCREEN_HEIGHT];
+static uint32_t frames_total;
+static TickType_t ticks_now, ticks_last_input;
+static jmp_buf sim_exit;
+static const char *exit_reason;
+
+static void (*ugui_pset)(UG_S16, UG_S16, UG_COLOR);
+static bool setting_up;
+
+void app_main(void);
+
+
+static uint64_t cpu_us_since(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (now.tv_sec - start->tv_sec) * 1000000ULL + (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void row_begin(const char *label)
+{
+    memset(&current, 0, sizeof(current));
+    snprintf(current.label, sizeof(current.label), "%s", label);
+    current_storage = flash_emu_stats;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &current_cpu);
+}
+
+static void row_end(void)
+{
+    if (rows_count >= SIM_MAX_ROWS)
+        return;
+
+    current.cpu_us = cpu_us_since(&current_cpu);
+    current.storage.sd_read_bytes = flash_emu_stats.sd_read_bytes - current_storage.sd_read_bytes;
+    current.storage.read_bytes = flash_emu_stats.read_bytes - current_storage.read_bytes;
+    current.storage.prog_bytes = flash_emu_stats.prog_bytes - current_storage.prog_bytes;
+    current.storage.erase_bytes = flash_emu_stats.erase_bytes - current_storage.erase_bytes;
+    current.storage.sim_us = flash_emu_stats.sim_us - current_storage.sim_us;
+    rows[rows_count++] = current;
+}
+
+static void sim_finish(const char *reason) __attribute__((noreturn));
+static void sim_finish(const char *reason)
+{
+    row_end();
+    exit_reason = reason;
+    longjmp(sim_exit, 1);
+}
+
+
+/* uGUI: main.c is compiled with -DUG_Init=ui_sim_UG_Init so every pixel write is counted */
+
+static void discard_pset(UG_S16 x, UG_S16 y, UG_COLOR color)
+{
+}
+
+static void counting_pset(UG_S16 x, UG_S16 y, UG_COLOR color)
+{
+    current.pixels_drawn++;
+    ugui_pset(x, y, color);
+}
+
+UG_S16 ui_sim_UG_Init(UG_GUI *g, void (*p)(UG_S16, UG_S16, UG_COLOR), UG_S16 x, UG_S16 y)
+{
+    ugui_pset = p;
+    return UG_Init(g, counting_pset, x, y);
+}
+
+
+/* display.h */
+
+static void dump_frame(const uint16_t *buffer)
+{
+    char path[512];
+
+    snprintf(path, sizeof(path), "%s/frame_%04u.ppm", opts.dump_dir, frames_total);
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+        uint16_t c = buffer[i];
+        uint8_t rgb[3] = {(c >> 11) << 3, ((c >> 5) & 0x3F) << 2, (c & 0x1F) << 3};
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+void ili9341_init(void)
+{
+    memset(last_frame, 0, sizeof(last_frame));
+}
+
+void ili9341_deinit(void)
+{
+}
+
+void ili9341_writeLE(const uint16_t *buffer)
+{
+    const int chunks = (SCREEN_HEIGHT + SIM_LCD_CHUNK_HEIGHT - 1) / SIM_LCD_CHUNK_HEIGHT;
+
+    if (setting_up)
+        return;
+
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+        if (buffer[i] != last_frame[i])
+            current.pixels_changed++;
+    }
+    memcpy(last_frame, buffer, sizeof(last_frame));
+
+    current.flushes++;
+    current.spi_bytes += SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t) + chunks * SIM_LCD_CMD_BYTES;
+
+    if (opts.dump_dir)
+        dump_frame(buffer);
+    frames_total++;
+}
+
+void ili9341_writeBE(const uint16_t *buffer)
+{
+    ili9341_writeLE(buffer);
+}
+
+
+/* input.h */
+
+void input_init(void)
+{
+}
+
+uint32_t input_read_raw(void)
+{
+    return 0;
+}
+
+int input_wait_for_button_repeat(int ticks, input_event_t *event)
+{
+    while (script_pos < script_count) {
+        int repeats = script_repeats[script_pos];
+        int token = script[script_pos++];
+
+        if (token == SIM_TOKEN_IDLE && ticks < 0)
+            continue; // Nothing times out on an infinite wait
+
+        row_end();
+        ticks_last_input = ticks_now;
+
+        if (token == SIM_TOKEN_IDLE) {
+            ticks_now += ticks;
+            row_begin("(idle)");
+            return -1;
+        }
+
+        char label[16];
+        snprintf(label, sizeof(label), repeats ? "%s+%d" : "%s", button_names[token], repeats);
+        row_begin(label);
+        *event = (input_event_t){
+            .button = token,
+            .pressed = true,
+            .repeat = repeats > 0,
+            .count = 1 + repeats,
+        };
+        return token;
+    }
+
+    sim_finish("end of script");
+}
+
+void input_flush(void)
+{
+    // Every scripted press answers the prompt that reads it, nothing is stale
+}
+
+int input_wait_for_button_press(int ticks)
+{
+    input_event_t event;
+    return input_wait_for_button_repeat(ticks, &event);
+}
+
+void input_set_repeat(int delay_ms, int rate_ms, int min_rate_ms)
+{
+}
+
+
+/* sdcard.h, a directory relative to the work directory */
+
+esp_err_t odroid_sdcard_open(void)
+{
+    struct stat st;
+    return stat(SDCARD_BASE_PATH, &st) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+void odroid_sdcard_mount_async(void)
+{
+}
+
+esp_err_t odroid_sdcard_wait(void)
+{
+    return odroid_sdcard_open();
+}
+
+esp_err_t odroid_sdcard_close(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t odroid_sdcard_format(int fs_type)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static int sdcard_compare(const void *a, const void *b)
+{
+    return strcasecmp(*(char * const *)a, *(char * const *)b);
+}
+
+int odroid_sdcard_files_get(const char *path, const char *extension, char ***filesOut)
+{
+    size_t extensionLength = strlen(extension);
+    char **result = malloc(1024 * sizeof(char *));
+    int count = 0;
+
+    DIR *dir = opendir(path);
+    if (!dir)
+        return 0;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) && count < 1024) {
+        size_t len = strlen(entry->d_name);
+        if (len < extensionLength || entry->d_name[0] == '.')
+            continue;
+        if (strcasecmp(extension, &entry->d_name[len - extensionLength]) != 0)
+            continue;
+        result[count++] = strdup(entry->d_name);
+    }
+    closedir(dir);
+
+    qsort(result, count, sizeof(char *), sdcard_compare);
+    *filesOut = result;
+    return count;
+}
+
+void odroid_sdcard_files_free(char **files, int count)
+{
+    for (int i = 0; i < count; i++)
+        free(files[i]);
+    free(files);
+}
+
+
+/* FreeRTOS, esp_system, esp_ota_ops */
+
+void vTaskDelay(TickType_t ticks)
+{
+    ticks_now += ticks;
+    if (ticks_now - ticks_last_input > SIM_STUCK_TICKS)
+        sim_finish("stuck without reading input (panic?)");
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return ticks_now;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)ticks_now * portTICK_PERIOD_MS * 1000 + (int64_t)flash_emu_stats.sim_us;
+}
+
+struct host_semaphore {
+    int count;
+};
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    task(arg);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return calloc(1, sizeof(struct host_semaphore));
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    sem->count = 1;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    if (sem->count == 0)
+        sim_finish("xSemaphoreTake would block forever");
+    sem->count = 0;
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    free(sem);
+}
+
+void esp_restart(void)
+{
+    sim_finish("esp_restart");
+}
+
+const esp_partition_t *esp_ota_get_running_partition(void)
+{
+    return esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_FACTORY, NULL);
+}
+
+
+/* nvs, gpio, battery */
+
+static struct {
+    char key[16];
+    int32_t value;
+    uint8_t blob[64];
+    size_t blob_size;
+} nvs_keys[SIM_NVS_MAX_KEYS];
+static size_t nvs_keys_count;
+
+esp_err_t nvs_flash_init_partition(const char *partition_label) { return ESP_OK; }
+esp_err_t nvs_flash_deinit_partition(const char *partition_label) { return ESP_OK; }
+esp_err_t nvs_flash_erase(void) { nvs_keys_count = 0; return ESP_OK; }
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) { *out_handle = 1; return ESP_OK; }
+void nvs_close(nvs_handle_t handle) { }
+esp_err_t nvs_commit(nvs_handle_t handle) { return ESP_OK; }
+
+esp_err_t nvs_get_i32(nvs_handle_t handle, const char *key, int32_t *out_value)
+{
+    for (size_t i = 0; i < nvs_keys_count; i++) {
+        if (strcmp(nvs_keys[i].key, key) == 0) {
+            *out_value = nvs_keys[i].value;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t handle, const char *key, int32_t value)
+{
+    for (size_t i = 0; i < nvs_keys_count; i++) {
+        if (strcmp(nvs_keys[i].key, key) == 0) {
+            nvs_keys[i].value = value;
+            return ESP_OK;
+        }
+    }
+    if (nvs_keys_count >= SIM_NVS_MAX_KEYS)
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    snprintf(nvs_keys[nvs_keys_count].key, sizeof(nvs_keys[0].key), "%s", key);
+    nvs_keys[nvs_keys_count++].value = value;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    for (size_t i = 0; i < nvs_keys_count; i++) {
+        if (strcmp(nvs_keys[i].key, key) == 0) {
+            if (*length < nvs_keys[i].blob_size)
+                return ESP_ERR_NVS_INVALID_LENGTH;
+            memcpy(out_value, nvs_keys[i].blob, nvs_keys[i].blob_size);
+            *length = nvs_keys[i].blob_size;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    size_t i = 0;
+    if (length > sizeof(nvs_keys[0].blob))
+        return ESP_ERR_NVS_VALUE_TOO_LONG;
+    while (i < nvs_keys_count && strcmp(nvs_keys[i].key, key) != 0)
+        i++;
+    if (i == nvs_keys_count) {
+        if (nvs_keys_count >= SIM_NVS_MAX_KEYS)
+            return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        snprintf(nvs_keys[nvs_keys_count++].key, sizeof(nvs_keys[0].key), "%s", key);
+    }
+    memcpy(nvs_keys[i].blob, value, length);
+    nvs_keys[i].blob_size = length;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) { return ESP_OK; }
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) { return ESP_OK; }
+
+void battery_init(void)
+{
+}
+
+battery_state_t battery_get_state(void)
+{
+    float voltage = opts.battery_mv / 1000.f;
+    int percent = (voltage - BATTERY_VMIN) / (BATTERY_VMAX - BATTERY_VMIN) * 100.f;
+
+    return (battery_state_t){
+        .voltage = voltage,
+        .percent = percent < 0 ? 0 : percent > 100 ? 100 : percent,
+    };
+}
+
+void battery_set_callback(battery_callback_t callback)
+{
+}
+
+
+/* Simulator */
+
+static int parse_script(const char *text)
+{
+    char *copy = strdup(text), *save = NULL;
+
+    script_count = 0;
+    for (char *tok = strtok_r(copy, " \t\r\n,", &save); tok; tok = strtok_r(NULL, " \t\r\n,", &save)) {
+        char *star = strchr(tok, '*');
+        char *plus = strchr(tok, '+');
+        int repeat = star ? atoi(star + 1) : 1;
+        int held = plus ? atoi(plus + 1) : 0;
+        int token = -1;
+
+        if (tok[0] == '#') {
+            strtok_r(NULL, "\n", &save); // Comment until end of line
+            continue;
+        }
+        if (star)
+            *star = 0;
+        if (plus)
+            *plus = 0;
+
+        if (strcasecmp(tok, "idle") == 0)
+            token = SIM_TOKEN_IDLE;
+        for (int i = 0; i < ODROID_INPUT_MAX && token == -1; i++) {
+            if (strcasecmp(tok, button_names[i]) == 0)
+                token = i;
+        }
+        if (token == -1) {
+            fprintf(stderr, "unknown script token '%s'\n", tok);
+            free(copy);
+            return -1;
+        }
+        while (repeat-- > 0 && script_count < SIM_MAX_SCRIPT) {
+            script_repeats[script_count] = held;
+            script[script_count++] = token;
+        }
+    }
+
+    free(copy);
+    return 0;
+}
+
+static char *read_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *text = calloc(1, size + 1);
+    if (fread(text, 1, size, f) != (size_t)size) {
+        free(text);
+        text = NULL;
+    }
+    fclose(f);
+    return text;
+}
+
+/**
+ * A device with a few apps installed and a few more .fw files waiting on the SD card.
+ */
+static void make_device(void)
+{
+    static const struct { const char *name, *description; uint32_t size; } files[] = {
+        {"nes.fw", "Nintendo Entertainment System", 0x100000},
+        {"gb.fw", "Game Boy", 0x180000},
+        {"sms.fw", "Master System / Game Gear", 0x0C0000},
+        {"doom.fw", "Doom", 0x200000},
+        {"spectrum.fw", "ZX Spectrum", 0x0E0000},
+        {"chip8.fw", "Chip-8", 0x040000},
+    };
+    const char *path = SDCARD_BASE_PATH "/odroid/firmware";
+    char fullpath[256];
+    UG_GUI gui;
+
+    // The firmware_ui_* hooks in main.c draw through uGUI, app_main() initializes it again later
+    setting_up = true;
+    UG_Init(&gui, discard_pset, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    mkdir(SDCARD_BASE_PATH, 0755);
+    mkdir(SDCARD_BASE_PATH "/odroid", 0755);
+    mkdir(path, 0755);
+
+    fixture_factory_flash();
+    read_app_table();
+
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        fixture_make_app_fw(path, files[i].name, files[i].description, files[i].size, i + 1);
+        if (i == 2)
+            continue; // Left on the SD card for the install path
+        snprintf(fullpath, sizeof(fullpath), "%s/%s", path, files[i].name);
+        odroid_fw_t *fw = firmware_get_info(fullpath);
+        firmware_install(fullpath, fw, find_free_block(fw->flashSize, true));
+        free(fw);
+    }
+
+    setting_up = false;
+}
+
+static void print_rows(void)
+{
+    sim_row_t total = {.label = "total"};
+    uint32_t presses = 0;
+
+    if (opts.csv)
+        printf("# row,label,flushes,pixels_drawn,pixels_changed,spi_bytes,sd_read_bytes,flash_prog_bytes\n");
+    else
+        printf("%-4s %-8s %7s %10s %10s %10s %8s %10s %10s %9s\n", "row", "input", "flushes", "drawn_px",
+               "changed_px", "spi_B", "spi_ms", "sd_read_B", "prog_B", "cpu_us");
+
+    for (size_t i = 0; i < rows_count; i++) {
+        const sim_row_t *r = &rows[i];
+
+        total.flushes += r->flushes;
+        total.pixels_drawn += r->pixels_drawn;
+        total.pixels_changed += r->pixels_changed;
+        total.spi_bytes += r->spi_bytes;
+        total.cpu_us += r->cpu_us;
+        total.storage.sd_read_bytes += r->storage.sd_read_bytes;
+        total.storage.prog_bytes += r->storage.prog_bytes;
+        presses += i > 0;
+
+        if (opts.csv) {
+            printf("%zu,%s,%u,%llu,%llu,%llu,%llu,%llu\n", i, r->label, r->flushes,
+                   (unsigned long long)r->pixels_drawn, (unsigned long long)r->pixels_changed,
+                   (unsigned long long)r->spi_bytes, (unsigned long long)r->storage.sd_read_bytes,
+                   (unsigned long long)r->storage.prog_bytes);
+            continue;
+        }
+        printf("%-4zu %-8s %7u %10llu %10llu %10llu %8.1f %10llu %10llu %9llu\n", i, r->label, r->flushes,
+               (unsigned long long)r->pixels_drawn, (unsigned long long)r->pixels_changed,
+               (unsigned long long)r->spi_bytes, r->spi_bytes * 8 * 1000.0 / SIM_LCD_SPI_HZ,
+               (unsigned long long)r->storage.sd_read_bytes, (unsigned long long)r->storage.prog_bytes,
+               (unsigned long long)r->cpu_us);
+    }
+
+    if (opts.csv || !presses)
+        return;
+
+    printf("\n%u inputs, %u frames: per input %.1f flushes, %.0f px drawn, %.0f px changed (%.1f%% of the SPI traffic), %.1f ms SPI\n",
+           presses, total.flushes, (double)total.flushes / presses, (double)total.pixels_drawn / presses,
+           (double)total.pixels_changed / presses,
+           total.spi_bytes ? 100.0 * total.pixels_changed * 2 / total.spi_bytes : 0.0,
+           total.spi_bytes * 8 * 1000.0 / SIM_LCD_SPI_HZ / presses);
+}
+
+static int compare_baseline(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256], label[16];
+    unsigned row, flushes;
+    unsigned long long drawn, changed, spi, sd, prog;
+    int regressions = 0;
+
+    if (!f) {
+        fprintf(stderr, "cannot open baseline %s\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || sscanf(line, "%u,%15[^,],%u,%llu,%llu,%llu,%llu,%llu", &row, label, &flushes,
+                                     &drawn, &changed, &spi, &sd, &prog) != 8) {
+            continue;
+        }
+        if (row >= rows_count || strcmp(rows[row].label, label)) {
+            fprintf(stderr, "REGRESSION row %u: expected input %s, the UI flow changed\n", row, label);
+            regressions++;
+            continue;
+        }
+
+        const sim_row_t *r = &rows[row];
+        double limit = 1.0 + opts.tolerance / 100.0;
+        if (r->flushes > flushes * limit || r->pixels_drawn > drawn * limit || r->spi_bytes > spi * limit
+            || r->storage.sd_read_bytes > sd * limit) {
+            fprintf(stderr, "REGRESSION row %u (%s): flushes %u -> %u, drawn %llu -> %llu, spi %llu -> %llu, sd %llu -> %llu\n",
+                    row, label, flushes, r->flushes, drawn, (unsigned long long)r->pixels_drawn, spi,
+                    (unsigned long long)r->spi_bytes, sd, (unsigned long long)r->storage.sd_read_bytes);
+            regressions++;
+        }
+    }
+
+    fclose(f);
+    if (!opts.csv)
+        printf("Baseline %s: %d regression(s) above %.1f%%\n", path, regressions, opts.tolerance);
+    return regressions ? 1 : 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [options]\n\n"
+           "  -s, --script TEXT       Buttons to press: UP RIGHT DOWN LEFT SELECT START A B MENU VOLUME,\n"
+           "                          'idle' lets a timed wait expire, TOKEN*N repeats (default: a menu tour)\n"
+           "                          BUTTON+N holds it until N auto-repeats are merged into one step\n"
+           "  -f, --script-file FILE  Read the script from FILE, '#' starts a comment\n"
+           "  -d, --dir PATH          Work directory for flash.bin and the sdcard folder (default %s)\n"
+           "  -o, --dump DIR          Write every flushed frame to DIR/frame_NNNN.ppm\n"
+           "  -B, --battery MV        Battery voltage reported by the ADC (default %d)\n"
+           "  -b, --baseline FILE     Fail if a row draws/flushes/reads more than FILE plus the tolerance\n"
+           "  -t, --tolerance PCT     Baseline tolerance in percent (default %.1f)\n"
+           "  -v, --verbose           Show the firmware's log output\n"
+           "      --csv               Machine-readable output, same format as the baseline\n",
+           prog, opts.workdir, opts.battery_mv, opts.tolerance);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        {"script",      required_argument, NULL, 's'},
+        {"script-file", required_argument, NULL, 'f'},
+        {"dir",         required_argument, NULL, 'd'},
+        {"dump",        required_argument, NULL, 'o'},
+        {"battery",     required_argument, NULL, 'B'},
+        {"baseline",    required_argument, NULL, 'b'},
+        {"tolerance",   required_argument, NULL, 't'},
+        {"verbose",     no_argument,       NULL, 'v'},
+        {"csv",         no_argument,       NULL, 'x'},
+        {"help",        no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    char *script_text = NULL;
+    char *baseline = NULL, *dump_dir = NULL;
+    int opt, err = 0;
+
+    while ((opt = getopt_long(argc, argv, "s:f:d:o:B:b:t:vh", long_opts, NULL)) != -1) {
+        switch (opt) {
+            case 's': opts.script = optarg; break;
+            case 'f':
+                if (!(script_text = read_file(optarg)))
+                    return 1;
+                opts.script = script_text;
+                break;
+            case 'd': opts.workdir = optarg; break;
+            case 'o': opts.dump_dir = optarg; break;
+            case 'B': opts.battery_mv = atoi(optarg); break;
+            case 'b': opts.baseline = optarg; break;
+            case 't': opts.tolerance = strtod(optarg, NULL); break;
+            case 'v': host_log_level++; break;
+            case 'x': opts.csv = true; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (parse_script(opts.script) != 0)
+        return 1;
+    free(script_text);
+
+    // Paths are resolved before we move into the work directory
+    if (opts.baseline)
+        opts.baseline = baseline = realpath(opts.baseline, NULL);
+    if (opts.dump_dir) {
+        mkdir(opts.dump_dir, 0755);
+        opts.dump_dir = dump_dir = realpath(opts.dump_dir, NULL);
+    }
+
+    mkdir(opts.workdir, 0755);
+    if (chdir(opts.workdir) != 0) {
+        perror(opts.workdir);
+        return 1;
+    }
+    remove("flash.bin");
+    if (flash_emu_open("flash.bin", 16 * 1024 * 1024) != 0)
+        return 1;
+
+    make_device();
+    memset(&flash_emu_stats, 0, sizeof(flash_emu_stats));
+
+    row_begin("(boot)");
+    if (setjmp(sim_exit) == 0) {
+        app_main();
+        row_end();
+        exit_reason = "app_main returned";
+    }
+
+    print_rows();
+    if (!opts.csv)
+        printf("Stopped: %s after %zu of %zu inputs, %u frames\n", exit_reason, script_pos, script_count, frames_total);
+
+    if (opts.baseline)
+        err = compare_baseline(opts.baseline);
+
+    flash_emu_close();
+    free(baseline);
+    free(dump_dir);
+    return err;
+}
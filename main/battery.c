@@ -0,0 +1,160 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_adc/adc_oneshot.h>
+#include <esp_adc/adc_cali.h>
+#include <esp_adc/adc_cali_scheme.h>
+#include <esp_log.h>
+
+#include "battery.h"
+#include "input.h"
+
+#define BATTERY_ADC_CHANNEL     ADC_CHANNEL_0
+#define BATTERY_OVERSAMPLE      16
+#define BATTERY_PERIOD_MS       2000
+#define BATTERY_FILTER          (0.25f) // IIR weight of a new oversampled reading
+
+static volatile float battery_voltage = BATTERY_VMAX;
+static volatile int battery_percent = 100;
+static volatile uint32_t battery_seq;
+static battery_callback_t battery_callback;
+
+#if CONFIG_HW_ODROID_GO
+extern adc_oneshot_unit_handle_t adc_handle; // Owned by input.c, ADC1 can only be claimed once, read with input_adc_read()
+
+static adc_cali_handle_t cali_handle;
+static bool calibrated;
+
+static const adc_oneshot_chan_cfg_t battery_adc_config = {
+    .atten = ADC_ATTEN_DB_12,
+    .bitwidth = ADC_BITWIDTH_12,
+};
+
+static bool battery_calibration_init(adc_unit_t unit, adc_channel_t channel, adc_atten_t atten, adc_bitwidth_t bitwidth, adc_cali_handle_t *out_handle)
+{
+    esp_err_t ret = ESP_FAIL;
+    adc_cali_handle_t handle = NULL;
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    ESP_LOGI(__func__, "calibration scheme version is %s", "Curve Fitting");
+    adc_cali_curve_fitting_config_t cali_config = {
+        .unit_id = unit,
+        .chan = channel,
+        .atten = atten,
+        .bitwidth = bitwidth,
+    };
+    ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
+
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    ESP_LOGI(__func__, "calibration scheme version is %s", "Line Fitting");
+    adc_cali_line_fitting_config_t cali_config = {
+        .unit_id = unit,
+        .atten = atten,
+        .bitwidth = bitwidth,
+    };
+    ret = adc_cali_create_scheme_line_fitting(&cali_config, &handle);
+#endif
+
+    if (ret == ESP_ERR_NOT_SUPPORTED) {
+        ESP_LOGW(__func__, "calibration fail due to lack of eFuse bits");
+    } else if (ret != ESP_OK) {
+        ESP_LOGE(__func__, "Invalid arg or no memory");
+    }
+
+    *out_handle = handle;
+
+    return ret == ESP_OK;
+}
+
+static bool battery_sample(float *voltage)
+{
+    int raw = 0, sum = 0, voltage_mv = 0;
+
+    for (int i = 0; i < BATTERY_OVERSAMPLE; ++i)
+    {
+        if (!input_adc_read(BATTERY_ADC_CHANNEL, &raw))
+            return false;
+        sum += raw;
+    }
+    raw = sum / BATTERY_OVERSAMPLE;
+
+    if (calibrated)
+        adc_cali_raw_to_voltage(cali_handle, raw, &voltage_mv);
+    else
+        voltage_mv = raw * 3100 / 4095; // Nominal full scale at 12dB
+
+    *voltage = voltage_mv / 1000.f;
+    return true;
+}
+#endif
+
+static void battery_publish(float voltage)
+{
+    int percent = (voltage - BATTERY_VMIN) / (BATTERY_VMAX - BATTERY_VMIN) * 100.f;
+
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+
+    battery_voltage = voltage;
+
+    if (percent != battery_percent)
+    {
+        battery_percent = percent;
+        battery_seq++;
+
+        if (battery_callback)
+        {
+            battery_state_t state = battery_get_state();
+            battery_callback(&state);
+        }
+    }
+}
+
+#if CONFIG_HW_ODROID_GO
+static void battery_task(void *arg)
+{
+    float voltage;
+
+    while (1)
+    {
+        vTaskDelay(pdMS_TO_TICKS(BATTERY_PERIOD_MS));
+
+        if (battery_sample(&voltage))
+            battery_publish(battery_voltage + (voltage - battery_voltage) * BATTERY_FILTER);
+    }
+
+    vTaskDelete(NULL);
+}
+#endif
+
+battery_state_t battery_get_state(void)
+{
+    return (battery_state_t){
+        .voltage = battery_voltage,
+        .percent = battery_percent,
+        .seq = battery_seq,
+    };
+}
+
+void battery_set_callback(battery_callback_t callback)
+{
+    battery_callback = callback;
+}
+
+void battery_init(void)
+{
+#if CONFIG_HW_ODROID_GO
+    float voltage;
+
+    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc_handle, BATTERY_ADC_CHANNEL, &battery_adc_config));
+    calibrated = battery_calibration_init(ADC_UNIT_1, BATTERY_ADC_CHANNEL, battery_adc_config.atten,
+                                          battery_adc_config.bitwidth, &cali_handle);
+
+    // Seed the filter so the first page doesn't show the battery charging up from BATTERY_VMAX
+    if (battery_sample(&voltage))
+        battery_publish(voltage);
+
+    xTaskCreatePinnedToCore(&battery_task, "battery_task", 1024 * 2, NULL, 1, NULL, 0);
+#endif
+
+    ESP_LOGI(__func__, "done (%.2fV, %d%%).", battery_voltage, battery_percent);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BATTERY_VMAX                (4.20f)
+#define BATTERY_VMIN                (3.30f)
+
+typedef struct
+{
+    float voltage;  // Oversampled and low-pass filtered
+    int percent;    // 0-100, between BATTERY_VMIN and BATTERY_VMAX
+    uint32_t seq;   // Incremented every time percent changes
+} battery_state_t;
+
+typedef void (*battery_callback_t)(const battery_state_t *state);
+
+void battery_init(void); // Must run after input_init(), it shares its ADC unit
+battery_state_t battery_get_state(void); // Cached, never touches the ADC
+void battery_set_callback(battery_callback_t callback); // Runs on the battery task when percent changes
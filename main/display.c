@@ -64,6 +64,13 @@ void ili9341_writeLE(const uint16_t *buffer)
     }
 }
 
+void ili9341_attach(void)
+{
+#if !defined(CONFIG_IDF_TARGET_ESP32P4) && !CONFIG_BSP_DISPLAY_DRIVER_QEMU
+    esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &(esp_lcd_panel_io_callbacks_t){ .on_color_trans_done = lcd_event_callback }, NULL);
+#endif
+}
+
 void ili9341_deinit()
 {
     // Delete the semaphore
@@ -161,9 +168,7 @@ void ili9341_init()
     };
     esp_lcd_dpi_panel_register_event_callbacks(panel_handle, &callback, NULL);
 #else
-#if !CONFIG_BSP_DISPLAY_DRIVER_QEMU
-    esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &(esp_lcd_panel_io_callbacks_t){ .on_color_trans_done = lcd_event_callback }, NULL);
-#endif
+    ili9341_attach();
 #endif
 
     ESP_LOGI(__func__, "LCD Buffer and event callbacks created.");
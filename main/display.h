@@ -47,5 +47,6 @@
 
 void ili9341_init(void);
 void ili9341_deinit(void);
+void ili9341_attach(void); // Takes the panel IO's transfer done callback back, after LVGL used the panel
 void ili9341_writeLE(const uint16_t *buffer);
 void ili9341_writeBE(const uint16_t *buffer);
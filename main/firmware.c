@@ -0,0 +1,1223 @@
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/param.h>
+
+#include <esp_flash.h>
+#include <esp_partition.h>
+#include <esp_flash_partitions.h>
+#include <esp_log.h>
+
+
+// mbedtls runs SHA-256 on the accelerator with this option, without it the digests are ignored
+// and firmware_verify() falls back to the CRC over the whole file.
+#if CONFIG_MBEDTLS_HARDWARE_SHA
+#include <mbedtls/sha256.h>
+#define FIRMWARE_USE_SHA256 1
+#else
+#define FIRMWARE_USE_SHA256 0
+#endif
+
+#include "firmware.h"
+#include "perf.h"
+
+#define MFW_DATA_PARTITION "mfw_data"
+
+odroid_app_t *apps;
+int apps_count = -1;
+int apps_max = 4;
+int apps_seq = 0;
+int firstAppOffset = 0x100000; // We scan the table to find the real value but this is a reasonable default
+
+
+void *safe_alloc(size_t size)
+{
+    void *ptr = malloc(size);
+    if (!ptr)
+        firmware_ui_panic("MEMORY ALLOCATION ERROR");
+    return ptr;
+}
+
+static uint32_t crc32_table[4][256];
+
+// Slice-by-4: one table lookup per byte but a single load and shift chain per word, the ROM
+// crc32_le() walks the buffer byte by byte.
+uint32_t firmware_crc32(uint32_t crc, const void *buf, size_t len)
+{
+    const uint8_t *data = buf;
+
+    if (crc32_table[0][1] == 0)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c >> 1) ^ (0xEDB88320 & -(c & 1));
+            crc32_table[0][i] = c;
+        }
+        for (int i = 0; i < 256; i++)
+            for (int t = 1; t < 4; t++)
+                crc32_table[t][i] = (crc32_table[t - 1][i] >> 8) ^ crc32_table[0][crc32_table[t - 1][i] & 0xFF];
+    }
+
+    crc = ~crc;
+
+    for (; len > 0 && ((uintptr_t)data & 3); len--)
+        crc = crc32_table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+    for (; len >= 4; len -= 4, data += 4)
+    {
+        crc ^= *(const uint32_t *)data; // Little endian
+        crc = crc32_table[3][crc & 0xFF] ^ crc32_table[2][(crc >> 8) & 0xFF]
+            ^ crc32_table[1][(crc >> 16) & 0xFF] ^ crc32_table[0][crc >> 24];
+    }
+
+    for (; len > 0; len--)
+        crc = crc32_table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+
+static int sort_app_table_by_offset(const void * a, const void * b)
+{
+    if ( (*(odroid_app_t*)a).startOffset < (*(odroid_app_t*)b).startOffset ) return -1;
+    if ( (*(odroid_app_t*)a).startOffset > (*(odroid_app_t*)b).startOffset ) return 1;
+    return 0;
+}
+
+static int sort_app_table_by_sequence(const void * a, const void * b)
+{
+    return (*(odroid_app_t*)a).installSeq - (*(odroid_app_t*)b).installSeq;
+}
+
+static int sort_app_table_by_alphabet(const void * a, const void * b)
+{
+    return strcasecmp((*(odroid_app_t*)a).description, (*(odroid_app_t*)b).description);
+}
+
+void sort_app_table(int newMode)
+{
+    switch(newMode & ~1) {
+        case LIST_SORT_SEQUENCE:
+            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_sequence);
+            break;
+        case LIST_SORT_DESCRIPTION:
+            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_alphabet);
+            break;
+        case LIST_SORT_OFFSET:
+        default:
+            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_offset);
+            break;
+    }
+
+    if (newMode & 1) { // Reverse array. Very inefficient.
+        odroid_app_t *tmp = safe_alloc(sizeof(odroid_app_t));
+        int i = apps_count - 1, j = 0;
+        while (i > j)
+        {
+            memcpy(tmp, &apps[i], sizeof(odroid_app_t));
+            memcpy(&apps[i], &apps[j], sizeof(odroid_app_t));
+            memcpy(&apps[j], tmp, sizeof(odroid_app_t));
+            i--;
+            j++;
+        }
+        free(tmp);
+    }
+}
+
+
+void read_app_table(void)
+{
+    const esp_partition_t *app_table_part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, MFW_DATA_PARTITION);
+
+    if (!app_table_part)
+    {
+        firmware_ui_panic("NO APP TABLE ERROR");
+    }
+    else if (!apps)
+    {
+        apps = safe_alloc(app_table_part->size);
+    }
+
+    apps_max = (app_table_part->size / sizeof(odroid_app_t));
+    apps_count = 0;
+    apps_seq = 0;
+
+    if (esp_partition_read(app_table_part, 0, apps, app_table_part->size) != ESP_OK)
+    {
+        firmware_ui_panic("APP TABLE READ ERROR");
+    }
+
+    for (int i = 0; i < apps_max; i++)
+    {
+        if (apps[i].magic != APP_TABLE_MAGIC)
+            break;
+        if (apps[i].installSeq >= apps_seq)
+            apps_seq = apps[i].installSeq + 1;
+        apps_count++;
+    }
+
+    //64K align the address (https://docs.espressif.com/projects/esp-idf/en/latest/api-guides/partition-tables.html#offset-size)
+    firstAppOffset = app_table_part->address + app_table_part->size;
+    firstAppOffset = ALIGN_ADDRESS(firstAppOffset, FLASH_BLOCK_SIZE);
+
+    ESP_LOGI(__func__, "Read app table (%d apps)", apps_count);
+}
+
+
+void write_app_table(void)
+{
+    const esp_partition_t *app_table_part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, MFW_DATA_PARTITION);
+
+    if (!apps || !app_table_part)
+    {
+        firmware_ui_panic("NO APP TABLE ERROR");
+    }
+
+    for (int i = apps_count; i < apps_max; ++i)
+    {
+        memset(&apps[i], 0xff, sizeof(odroid_app_t));
+    }
+
+    if (esp_partition_erase_range(app_table_part, 0, app_table_part->size) != ESP_OK)
+    {
+        firmware_ui_panic("APP TABLE ERASE ERROR");
+    }
+
+    if (esp_partition_write(app_table_part, 0, apps, app_table_part->size) != ESP_OK)
+    {
+        firmware_ui_panic("APP TABLE WRITE ERROR");
+    }
+
+    ESP_LOGI(__func__, "Written app table (%d apps)", apps_count);
+}
+
+
+void remove_app(int index)
+{
+    memmove(&apps[index], &apps[index + 1], (apps_count - index - 1) * sizeof(odroid_app_t));
+    apps_count--;
+    write_app_table();
+}
+
+
+void write_partition_table(const odroid_app_t *app)
+{
+    static esp_partition_info_t currentTable[ESP_PARTITION_TABLE_MAX_ENTRIES];
+    esp_partition_info_t partitionTable[ESP_PARTITION_TABLE_MAX_ENTRIES];
+    size_t nextPart = 0;
+
+    if (esp_flash_read(NULL, &currentTable, ESP_PARTITION_TABLE_OFFSET, sizeof(currentTable)) != ESP_OK)
+    {
+        firmware_ui_panic("PART TABLE READ ERROR");
+    }
+    memcpy(partitionTable, currentTable, sizeof(partitionTable));
+
+    // Keep only the valid system partitions
+    for (int i = 0; i < ESP_PARTITION_TABLE_MAX_ENTRIES; ++i)
+    {
+        esp_partition_info_t *part = &partitionTable[i];
+        if (part->magic == 0xFFFF)
+            break;
+        if (part->magic != ESP_PARTITION_MAGIC)
+            continue;
+        if (part->pos.offset >= firstAppOffset)
+            continue;
+        partitionTable[nextPart++] = *part;
+        ESP_LOGI(__func__, "Keeping partition #%d '%s'", nextPart - 1, part->label);
+    }
+
+    // Append app's partitions, if any
+    if (app)
+    {
+        size_t flashOffset = app->startOffset;
+
+        for (int i = 0; i < app->parts_count && i < ESP_PARTITION_TABLE_MAX_ENTRIES; ++i)
+        {
+            esp_partition_info_t* part = &partitionTable[nextPart++];
+            part->magic = ESP_PARTITION_MAGIC;
+            part->type = app->parts[i].type;
+            part->subtype = app->parts[i].subtype;
+            part->pos.offset = flashOffset;
+            part->pos.size = app->parts[i].length;
+            memcpy(&part->label, app->parts[i].label, 16);
+            part->flags = app->parts[i].flags;
+
+            flashOffset += app->parts[i].length;
+
+            ESP_LOGI(__func__, "Added partition #%d '%s'", nextPart - 1, part->label);
+        }
+    }
+
+    // We must fill the rest with 0xFF, the boot loader checks magic = 0xFFFF, type = 0xFF, subtype = 0xFF
+    while (nextPart < ESP_PARTITION_TABLE_MAX_ENTRIES)
+    {
+        memset(&partitionTable[nextPart++], 0xFF, sizeof(esp_partition_info_t));
+    }
+
+    // Relaunching the app that is already configured: leave the sector alone
+    if (memcmp(partitionTable, currentTable, sizeof(partitionTable)) == 0)
+    {
+        ESP_LOGI(__func__, "Partition table unchanged, not writing it.");
+        return;
+    }
+
+    if (esp_flash_erase_region(NULL, ESP_PARTITION_TABLE_OFFSET, ERASE_BLOCK_SIZE) != ESP_OK)
+    {
+        firmware_ui_panic("PART TABLE ERASE ERROR");
+    }
+
+    if (esp_flash_write(NULL, partitionTable, ESP_PARTITION_TABLE_OFFSET, sizeof(partitionTable)) != ESP_OK)
+    {
+        firmware_ui_panic("PART TABLE WRITE ERROR");
+    }
+
+    // esp_partition_reload_table();
+}
+
+
+void write_boot_partition(const odroid_app_t *app)
+{
+    if (app)
+    {
+        firmware_ui_progress("Updating partitions ...", -1);
+        write_partition_table(app);
+    }
+
+    firmware_ui_progress("Setting boot partition ...", -1);
+
+// This is the correct way of doing things, but we must patch esp-idf to allow us to reload the partition table
+// So, now, instead we just write the OTA partition ourselves. It is always the same (boot app OTA+0).
+#if 0
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, NULL);
+
+    if (!partition)
+    {
+        firmware_ui_panic("NO BOOT PART ERROR");
+    }
+
+    if (esp_ota_set_boot_partition(partition) != ESP_OK)
+    {
+        firmware_ui_panic("BOOT SET ERROR");
+    }
+#else
+    uint32_t ota_data[8] = {1, 0, 0, 0, 0, 0, 0xFFFFFFFFU, 0x4743989A};
+    uint32_t current[8];
+
+    if (esp_flash_read(NULL, &current, 0xD000, sizeof(current)) == ESP_OK
+        && memcmp(current, ota_data, sizeof(ota_data)) == 0)
+    {
+        ESP_LOGI(__func__, "OTA data unchanged, not writing it.");
+        return;
+    }
+
+    if (esp_flash_erase_region(NULL, 0xD000, 0x1000) != ESP_OK
+        || esp_flash_write(NULL, &ota_data, 0xD000, sizeof(ota_data)) != ESP_OK)
+    {
+        firmware_ui_panic("BOOT SET ERROR");
+    }
+#endif
+}
+
+
+void defrag_flash(void)
+{
+    size_t nextStartOffset = firstAppOffset;
+    size_t totalBytesToMove = 0;
+    size_t totalBytesMoved = 0;
+    char tempstring[128];
+
+    sort_app_table(LIST_SORT_OFFSET);
+
+    // First loop to get total for the progress bar
+    for (int i = 0; i < apps_count; i++)
+    {
+        if (apps[i].startOffset > nextStartOffset)
+        {
+            totalBytesToMove += (apps[i].endOffset - apps[i].startOffset);
+        } else {
+            nextStartOffset = apps[i].endOffset + 1;
+        }
+    }
+
+    snprintf(tempstring, sizeof(tempstring), "Moving: %.2f MB", (float)totalBytesToMove / 1024 / 1024);
+    firmware_ui_page("Defragmenting flash", "Making some space...", tempstring);
+
+    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
+    perf_timer_t timer;
+
+    perf_operation_begin("defrag");
+
+    for (int i = 0; i < apps_count; i++)
+    {
+        if (apps[i].startOffset > nextStartOffset)
+        {
+            firmware_ui_led(1);
+
+            size_t app_size = apps[i].endOffset - apps[i].startOffset;
+            size_t newOffset = nextStartOffset, oldOffset = apps[i].startOffset;
+            // move
+            for (size_t i = 0; i < app_size; i += FLASH_BLOCK_SIZE)
+            {
+                ESP_LOGI(__func__, "Moving 0x%x to 0x%x", oldOffset + i, newOffset + i);
+
+                firmware_ui_progress("Defragmenting ... (E)", -1);
+                timer = perf_start();
+                esp_flash_erase_region(NULL, newOffset + i, FLASH_BLOCK_SIZE);
+                perf_stop(PERF_FLASH_ERASE, timer, FLASH_BLOCK_SIZE);
+
+                firmware_ui_progress("Defragmenting ... (R)", -1);
+                timer = perf_start();
+                esp_flash_read(NULL, dataBuffer, oldOffset + i, FLASH_BLOCK_SIZE);
+                perf_stop(PERF_FLASH_READ, timer, FLASH_BLOCK_SIZE);
+
+                firmware_ui_progress("Defragmenting ... (W)", -1);
+                timer = perf_start();
+                esp_flash_write(NULL, dataBuffer, newOffset + i, FLASH_BLOCK_SIZE);
+                perf_stop(PERF_FLASH_WRITE, timer, FLASH_BLOCK_SIZE);
+
+                totalBytesMoved += FLASH_BLOCK_SIZE;
+
+                firmware_ui_progress(NULL, (float) totalBytesMoved / totalBytesToMove  * 100.0);
+            }
+
+            apps[i].startOffset = newOffset;
+            apps[i].endOffset = newOffset + app_size;
+
+            firmware_ui_led(0);
+        }
+
+        nextStartOffset = apps[i].endOffset + 1;
+    }
+
+    free(dataBuffer);
+
+    write_app_table();
+
+    perf_operation_end();
+}
+
+
+void find_free_blocks(odroid_flash_block_t **blocks, size_t *count, size_t *totalFreeSpace)
+{
+    uint32_t flashSize = 0;
+    size_t previousBlockEnd = firstAppOffset;
+
+    esp_flash_get_size(NULL, &flashSize);
+
+    *blocks = safe_alloc(sizeof(odroid_flash_block_t) * 32);
+    *totalFreeSpace = 0;
+    *count = 0;
+
+    sort_app_table(LIST_SORT_OFFSET);
+
+    for (int i = 0; i < apps_count; i++)
+    {
+        size_t free_space = apps[i].startOffset - previousBlockEnd;
+
+        if (free_space > 0) {
+            odroid_flash_block_t *block = &(*blocks)[(*count)++];
+            block->offset = previousBlockEnd;
+            block->size = free_space;
+            *totalFreeSpace += block->size;
+            ESP_LOGI(__func__, "Found free block: %d 0x%x %d", i, block->offset, free_space / 1024);
+        }
+
+        previousBlockEnd = apps[i].endOffset + 1;
+    }
+
+    if (((int)flashSize - previousBlockEnd) > 0) {
+        odroid_flash_block_t *block = &(*blocks)[(*count)++];
+        block->offset = previousBlockEnd;
+        block->size = (flashSize - previousBlockEnd);
+        *totalFreeSpace += block->size;
+        ESP_LOGI(__func__, "Found free block: end 0x%x %d", block->offset, block->size / 1024);
+    }
+}
+
+int find_free_block(size_t size, bool defragIfNeeded)
+{
+    odroid_flash_block_t *blocks;
+    size_t count, totalFreeSpace;
+
+    find_free_blocks(&blocks, &count, &totalFreeSpace);
+
+    int result = -1;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (blocks[i].size >= size) {
+            result = blocks[i].offset;
+            break;
+        }
+    }
+
+    if (result < 0 && totalFreeSpace >= size && defragIfNeeded) {
+        defrag_flash();
+        result = find_free_block(size, false);
+    }
+
+    free(blocks);
+    return result;
+}
+
+
+odroid_fw_t *firmware_get_info(const char *filename)
+{
+    odroid_fw_t *outData = safe_alloc(sizeof(odroid_fw_t));
+
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        goto firmware_get_info_err;
+
+    size_t file_size;
+
+    fseek(file, 0, SEEK_END);
+    file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (!fread(&outData->header, sizeof(outData->header), 1, file))
+    {
+        goto firmware_get_info_err;
+    }
+
+    if (memcmp(HEADER_V00_01, outData->header.version, HEADER_LENGTH) != 0)
+    {
+        goto firmware_get_info_err;
+    }
+
+    outData->header.description[sizeof(outData->header.description) - 1] = 0;
+    outData->parts_count = 0;
+    outData->flashSize = 0;
+    outData->dataOffset = ftell(file);
+    outData->fileSize = file_size;
+    outData->digestsComplete = FIRMWARE_USE_SHA256;
+
+    while (ftell(file) < (file_size - 4))
+    {
+        // The last slot is for the NVS partition added below
+        if (outData->parts_count >= FIRMWARE_PARTS_MAX - 1)
+            goto firmware_get_info_err;
+
+        // Partition information
+        odroid_partition_t *part = &outData->parts[outData->parts_count];
+
+        if (fread(part, sizeof(odroid_partition_t), 1, file) != 1)
+            goto firmware_get_info_err;
+
+        size_t digestLength = part->digest == PART_DIGEST_SHA256 ? PART_DIGEST_SHA256_SIZE : 0;
+
+        // Check if dataLength is valid
+        if (ftell(file) + part->dataLength + digestLength > file_size || part->dataLength > part->length)
+            goto firmware_get_info_err;
+
+        // Check partition subtype and digest type
+        if (part->type == 0xff || part->digest > PART_DIGEST_SHA256)
+            goto firmware_get_info_err;
+
+        if (part->dataLength > 0 && !digestLength)
+            outData->digestsComplete = false;
+
+        // 4KB align the partition length, this is needed for erasing
+        part->length = ALIGN_ADDRESS(part->length, ERASE_BLOCK_SIZE);
+
+        fseek(file, part->dataLength, SEEK_CUR);
+
+        if (digestLength && fread(outData->sha256[outData->parts_count], digestLength, 1, file) != 1)
+            goto firmware_get_info_err;
+
+        outData->flashSize += part->length;
+        outData->parts_count++;
+    }
+
+    fseek(file, file_size - sizeof(outData->checksum), SEEK_SET);
+    fread(&outData->checksum, sizeof(outData->checksum), 1, file);
+
+    // We try to steal some unused space if possible, otherwise we might waste up to 48K
+    odroid_partition_t *part = &outData->parts[outData->parts_count - 1];
+    if (part->type == ESP_PARTITION_TYPE_APP && (part->length - part->dataLength) >= APP_NVS_SIZE) {
+        ESP_LOGI(__func__, "Found room for NVS partition, reducing last partition size by %d", APP_NVS_SIZE);
+        part->length -= APP_NVS_SIZE;
+        outData->flashSize -= APP_NVS_SIZE;
+    }
+    // Add an application-specific NVS partition.
+    odroid_partition_t *nvs_part = &outData->parts[outData->parts_count];
+    strcpy(nvs_part->label, "nvs");
+    nvs_part->digest = PART_DIGEST_NONE;
+    nvs_part->dataLength = 0;
+    nvs_part->length = APP_NVS_SIZE;
+    nvs_part->type = ESP_PARTITION_TYPE_DATA;
+    nvs_part->subtype = ESP_PARTITION_SUBTYPE_DATA_NVS;
+    outData->flashSize += nvs_part->length;
+    outData->parts_count++;
+
+    fclose(file);
+    return outData;
+
+firmware_get_info_err:
+    free(outData);
+    if (file)
+        fclose(file);
+    return NULL;
+}
+
+
+bool firmware_verify(const char *filename, const odroid_fw_t *fw)
+{
+    // The digests and the CRC over the whole file are checked by firmware_install() on the data it reads,
+    // no need to read the file twice
+    if (fw->digestsComplete)
+    {
+        ESP_LOGI(__func__, "SHA-256 on every partition and CRC, verified while installing");
+        return true;
+    }
+
+    return firmware_verify_crc(filename, fw);
+}
+
+
+bool firmware_verify_crc(const char *filename, const odroid_fw_t *fw)
+{
+    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
+
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        firmware_ui_panic("FILE OPEN ERROR");
+    }
+
+    uint32_t checksum = 0;
+    perf_timer_t timer;
+
+    perf_operation_begin("verify");
+
+    while (true)
+    {
+        timer = perf_start();
+        size_t count = fread(dataBuffer, 1, FLASH_BLOCK_SIZE, file);
+        perf_stop(PERF_SD_READ, timer, count);
+
+        if (ftell(file) == fw->fileSize)
+        {
+            count -= 4;
+        }
+
+        timer = perf_start();
+        checksum = firmware_crc32(checksum, dataBuffer, count);
+        perf_stop(PERF_CRC, timer, count);
+
+        if (count < FLASH_BLOCK_SIZE) break;
+    }
+
+    fclose(file);
+    free(dataBuffer);
+
+    perf_operation_end();
+
+    if (checksum != fw->checksum)
+    {
+        ESP_LOGE(__func__, "Checksum mismatch: expected: %#010x, computed:%#010x", fw->checksum, checksum);
+        return false;
+    }
+    ESP_LOGI(__func__, "Checksum OK: %#010x", checksum);
+
+    return true;
+}
+
+
+// Reads length bytes into buffer (FLASH_BLOCK_SIZE) and adds them to the CRC, for what install_app() doesn't flash
+static uint32_t crc_file_range(FILE *file, size_t length, void *buffer, uint32_t checksum)
+{
+    while (length > 0)
+    {
+        size_t count = fread(buffer, 1, MIN(length, FLASH_BLOCK_SIZE), file);
+        if (count <= 0)
+        {
+            firmware_ui_panic("DATA READ ERROR");
+        }
+        checksum = firmware_crc32(checksum, buffer, count);
+        length -= count;
+    }
+    return checksum;
+}
+
+// Writes the app and adds it to the in-memory table, the caller commits the table
+static odroid_app_t *install_app(const char *filename, const odroid_fw_t *fw, int flashAddress)
+{
+    odroid_app_t *app = memset(&apps[apps_count], 0x00, sizeof(*app));
+    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
+    int currentFlashAddress = flashAddress;
+    char tempstring[128];
+    perf_timer_t timer;
+    // With digests firmware_verify() didn't read the file, the CRC is computed here instead. The digests
+    // only cover the partition data, the CRC also covers the header and the partition records.
+    bool crcWhileInstalling = fw->digestsComplete;
+    uint32_t checksum = 0;
+#if FIRMWARE_USE_SHA256
+    mbedtls_sha256_context sha;
+    uint8_t digest[PART_DIGEST_SHA256_SIZE];
+#endif
+
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        firmware_ui_panic("FILE OPEN ERROR");
+    }
+
+    strncpy(app->description, fw->header.description, sizeof(app->description)-1);
+    strncpy(app->filename, strrchr(filename, '/'), sizeof(app->filename)-1);
+    memcpy(app->tile, fw->header.tile, sizeof(app->tile));
+    memcpy(app->parts, fw->parts, sizeof(app->parts));
+    app->parts_count = fw->parts_count;
+
+    // restore location to end of description
+    if (crcWhileInstalling)
+        checksum = crc_file_range(file, fw->dataOffset, dataBuffer, checksum);
+    else
+        fseek(file, fw->dataOffset, SEEK_SET);
+
+    app->magic = APP_TABLE_MAGIC;
+    app->startOffset = currentFlashAddress;
+
+    perf_operation_begin("install");
+
+    // Copy the firmware
+    for (int i = 0; i < app->parts_count; i++)
+    {
+        odroid_partition_t *slot = &app->parts[i];
+
+        // Skip header, firmware_get_info prepared everything for us. The NVS partition it added isn't in the file.
+        if (crcWhileInstalling && ftell(file) < fw->fileSize - sizeof(fw->checksum))
+            checksum = crc_file_range(file, sizeof(odroid_partition_t), dataBuffer, checksum);
+        else
+            fseek(file, sizeof(odroid_partition_t), SEEK_CUR);
+
+        size_t dataEnd = ftell(file) + slot->dataLength;
+        size_t nextEntry = dataEnd;
+        if (slot->digest == PART_DIGEST_SHA256)
+            nextEntry += PART_DIGEST_SHA256_SIZE;
+
+        firmware_ui_led(0);
+
+        // Erase target partition space
+        snprintf(tempstring, sizeof(tempstring), "Erasing ... (%d/%d)", i+1, app->parts_count);
+        ESP_LOGI(__func__, "%s", tempstring);
+
+        firmware_ui_progress(tempstring, 0);
+
+        int eraseBlocks = slot->length / ERASE_BLOCK_SIZE;
+        if (eraseBlocks * ERASE_BLOCK_SIZE < slot->length) ++eraseBlocks;
+
+        timer = perf_start();
+        if (esp_flash_erase_region(NULL, currentFlashAddress, eraseBlocks * ERASE_BLOCK_SIZE) != ESP_OK)
+        {
+            ESP_LOGE(__func__, "esp_flash_erase_region failed. eraseBlocks=%d", eraseBlocks);
+            firmware_ui_panic("ERASE ERROR");
+        }
+        perf_stop(PERF_FLASH_ERASE, timer, eraseBlocks * ERASE_BLOCK_SIZE);
+
+        if (slot->dataLength > 0)
+        {
+            firmware_ui_led(1);
+
+#if FIRMWARE_USE_SHA256
+            if (slot->digest == PART_DIGEST_SHA256)
+            {
+                mbedtls_sha256_init(&sha);
+                mbedtls_sha256_starts(&sha, 0);
+            }
+#endif
+
+            // Write data
+            int totalCount = 0;
+            for (int offset = 0; offset < slot->dataLength; offset += FLASH_BLOCK_SIZE)
+            {
+                snprintf(tempstring, sizeof(tempstring), "Writing (%d/%d)", i+1, app->parts_count);
+                ESP_LOGI(__func__, "%s", tempstring);
+                firmware_ui_progress(tempstring, (float)offset / (float)(slot->dataLength - FLASH_BLOCK_SIZE) * 100.0f);
+
+                // read
+                timer = perf_start();
+                size_t count = fread(dataBuffer, 1, FLASH_BLOCK_SIZE, file);
+                perf_stop(PERF_SD_READ, timer, count);
+                if (count <= 0)
+                {
+                    firmware_ui_panic("DATA READ ERROR");
+                }
+
+                if (offset + count >= slot->dataLength)
+                {
+                    count = slot->dataLength - offset;
+                }
+
+#if FIRMWARE_USE_SHA256
+                // Hash the buffer we are about to write, this is what was read from the SD card
+                if (slot->digest == PART_DIGEST_SHA256)
+                {
+                    timer = perf_start();
+                    mbedtls_sha256_update(&sha, dataBuffer, count);
+                    perf_stop(PERF_SHA256, timer, count);
+                }
+#endif
+
+                if (crcWhileInstalling)
+                {
+                    timer = perf_start();
+                    checksum = firmware_crc32(checksum, dataBuffer, count);
+                    perf_stop(PERF_CRC, timer, count);
+                }
+
+                // flash
+                timer = perf_start();
+                if (esp_flash_write(NULL, dataBuffer, currentFlashAddress + offset, count) != ESP_OK)
+                {
+                    ESP_LOGE(__func__, "esp_flash_write failed. address=%#08x", currentFlashAddress + offset);
+                    firmware_ui_panic("WRITE ERROR");
+                }
+                perf_stop(PERF_FLASH_WRITE, timer, count);
+
+                totalCount += count;
+            }
+
+            firmware_ui_led(0);
+
+            if (totalCount != slot->dataLength)
+            {
+                ESP_LOGE(__func__, "Size mismatch: length=%#08x, totalCount=%#08x", slot->dataLength, totalCount);
+                firmware_ui_panic("DATA SIZE ERROR");
+            }
+
+#if FIRMWARE_USE_SHA256
+            if (slot->digest == PART_DIGEST_SHA256)
+            {
+                mbedtls_sha256_finish(&sha, digest);
+                mbedtls_sha256_free(&sha);
+
+                // The app isn't in the table yet, whatever was written is still free space
+                if (memcmp(digest, fw->sha256[i], sizeof(digest)) != 0)
+                {
+                    ESP_LOGE(__func__, "SHA-256 mismatch on partition %d", i);
+                    firmware_ui_panic("CHECKSUM MISMATCH ERROR");
+                }
+            }
+#endif
+        }
+
+        fseek(file, dataEnd, SEEK_SET);
+        if (crcWhileInstalling)
+            checksum = crc_file_range(file, nextEntry - dataEnd, dataBuffer, checksum);
+        else
+            fseek(file, nextEntry, SEEK_SET);
+
+        // Notify OK
+        ESP_LOGI(__func__, "Partition(%d): OK. Length=%#08x", i, slot->length);
+        currentFlashAddress += slot->length;
+    }
+
+    fclose(file);
+    free(dataBuffer);
+
+    // Like a digest mismatch: the app isn't in the table yet, whatever was written is still free space
+    if (crcWhileInstalling && checksum != fw->checksum)
+    {
+        ESP_LOGE(__func__, "Checksum mismatch: expected: %#010x, computed:%#010x", fw->checksum, checksum);
+        firmware_ui_panic("CHECKSUM MISMATCH ERROR");
+    }
+
+    // 64K align our endOffset
+    app->endOffset = ALIGN_ADDRESS(currentFlashAddress, FLASH_BLOCK_SIZE) - 1;
+
+    // Remember the install order, for display sorting
+    app->installSeq = apps_seq++;
+
+    apps_count++; // Everything went well, acknowledge the new app
+
+    perf_operation_end();
+
+    return app;
+}
+
+
+odroid_app_t *firmware_install(const char *filename, const odroid_fw_t *fw, int flashAddress)
+{
+    odroid_app_t *app = install_app(filename, fw, flashAddress);
+    write_app_table();
+    return app;
+}
+
+
+bool firmware_plan_batch(odroid_fw_t **fws, int count, int *addresses)
+{
+    int order[FIRMWARE_BATCH_MAX];
+    size_t totalSize = 0;
+
+    if (count > FIRMWARE_BATCH_MAX || apps_count + count > apps_max)
+        return false;
+
+    // Biggest first, they have the fewest holes to choose from
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        for (; j > 0 && fws[order[j - 1]]->flashSize < fws[i]->flashSize; j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+        totalSize += ALIGN_ADDRESS(fws[i]->flashSize, FLASH_BLOCK_SIZE);
+    }
+
+    for (bool defragged = false; true; defragged = true)
+    {
+        odroid_flash_block_t *blocks;
+        size_t blocksCount, totalFreeSpace;
+        int placed = 0;
+
+        find_free_blocks(&blocks, &blocksCount, &totalFreeSpace);
+
+        // Best fit, apps stay 64K aligned like firmware_install() leaves them
+        for (; placed < count; placed++)
+        {
+            size_t size = ALIGN_ADDRESS(fws[order[placed]]->flashSize, FLASH_BLOCK_SIZE);
+            odroid_flash_block_t *best = NULL;
+
+            for (int b = 0; b < blocksCount; b++)
+            {
+                if (blocks[b].size >= size && (!best || blocks[b].size < best->size))
+                    best = &blocks[b];
+            }
+
+            if (!best)
+                break;
+
+            addresses[order[placed]] = best->offset;
+            best->offset += size;
+            best->size -= size;
+        }
+
+        free(blocks);
+
+        ESP_LOGI(__func__, "Placed %d of %d apps (%d KB), %d KB free%s", placed, count, totalSize / 1024,
+                 totalFreeSpace / 1024, defragged ? " after defrag" : "");
+
+        if (placed == count)
+            return true;
+
+        if (defragged || totalFreeSpace < totalSize)
+            return false;
+
+        defrag_flash();
+    }
+}
+
+
+void firmware_install_batch(const char **filenames, odroid_fw_t **fws, const int *addresses, int count)
+{
+    char tempstring[128];
+
+    for (int i = 0; i < count; i++)
+    {
+        snprintf(tempstring, sizeof(tempstring), "Installing %d/%d", i + 1, count);
+        firmware_ui_page("Install Applications", fws[i]->header.description, tempstring);
+
+        install_app(filenames[i], fws[i], addresses[i]);
+    }
+
+    // Apps written so far are lost if we don't get here, their space is simply free again
+    write_app_table();
+}
+
+
+static bool is_backup_partition(const odroid_partition_t *part, bool allData)
+{
+    if (part->type != ESP_PARTITION_TYPE_DATA)
+        return false;
+    return allData || part->subtype == ESP_PARTITION_SUBTYPE_DATA_NVS;
+}
+
+
+bool firmware_backup_data(const odroid_app_t *app, const char *filename, bool allData)
+{
+    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
+    size_t offset = app->startOffset;
+    perf_timer_t timer;
+    bool success = true;
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        ESP_LOGE(__func__, "Unable to create '%s'", filename);
+        free(dataBuffer);
+        return false;
+    }
+
+    perf_operation_begin("backup");
+
+    fwrite(APP_DATA_MAGIC, 1, APP_DATA_MAGIC_LENGTH, file);
+
+    for (int i = 0; i < app->parts_count && success; i++)
+    {
+        const odroid_partition_t *part = &app->parts[i];
+
+        if (is_backup_partition(part, allData))
+        {
+            odroid_partition_t header = *part;
+            header.dataLength = part->length;
+            success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+            for (size_t pos = 0; pos < part->length && success; pos += FLASH_BLOCK_SIZE)
+            {
+                size_t count = MIN(part->length - pos, FLASH_BLOCK_SIZE);
+
+                timer = perf_start();
+                success = esp_flash_read(NULL, dataBuffer, offset + pos, count) == ESP_OK
+                          && fwrite(dataBuffer, 1, count, file) == count;
+                perf_stop(PERF_FLASH_READ, timer, count);
+            }
+
+            ESP_LOGI(__func__, "Partition '%s' (%d KB) saved", part->label, part->length / 1024);
+        }
+
+        offset += part->length;
+    }
+
+    success = (fclose(file) == 0) && success;
+    free(dataBuffer);
+
+    perf_operation_end();
+
+    if (!success)
+    {
+        ESP_LOGE(__func__, "Writing '%s' failed", filename);
+        remove(filename);
+    }
+
+    return success;
+}
+
+
+bool firmware_restore_data(const odroid_app_t *app, const char *filename, bool allData)
+{
+    uint8_t *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
+    char magic[APP_DATA_MAGIC_LENGTH];
+    odroid_partition_t header;
+    perf_timer_t timer;
+    int restored = 0;
+
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        free(dataBuffer);
+        return false;
+    }
+
+    if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, APP_DATA_MAGIC, sizeof(magic)) != 0)
+    {
+        ESP_LOGE(__func__, "'%s' isn't an app data backup", filename);
+        goto firmware_restore_data_done;
+    }
+
+    // Walk the records first: a truncated backup is skipped before anything is erased
+    long dataStart = ftell(file);
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, dataStart, SEEK_SET);
+
+    for (long pos = dataStart; pos < fileSize; pos += sizeof(header) + header.dataLength)
+    {
+        if (fread(&header, sizeof(header), 1, file) != 1 || header.dataLength > fileSize - pos - sizeof(header))
+        {
+            ESP_LOGE(__func__, "'%s' is truncated at %ld, not restored", filename, pos);
+            goto firmware_restore_data_done;
+        }
+        fseek(file, header.dataLength, SEEK_CUR);
+    }
+    fseek(file, dataStart, SEEK_SET);
+
+    perf_operation_begin("restore");
+
+    while (fread(&header, sizeof(header), 1, file) == 1)
+    {
+        const odroid_partition_t *part = NULL;
+        size_t offset = app->startOffset;
+
+        // Partitions are matched by label and type, the app may have been rebuilt with another layout
+        for (int i = 0; i < app->parts_count; offset += app->parts[i++].length)
+        {
+            if (app->parts[i].type == header.type && app->parts[i].subtype == header.subtype
+                && strncmp(app->parts[i].label, header.label, sizeof(header.label)) == 0)
+            {
+                part = &app->parts[i];
+                break;
+            }
+        }
+
+        if (!part || !is_backup_partition(part, allData) || part->length < header.dataLength)
+        {
+            ESP_LOGI(__func__, "Skipping partition '%.16s'", header.label);
+            fseek(file, header.dataLength, SEEK_CUR);
+            continue;
+        }
+
+        timer = perf_start();
+        if (esp_flash_erase_region(NULL, offset, part->length) != ESP_OK)
+        {
+            firmware_ui_panic("ERASE ERROR");
+        }
+        perf_stop(PERF_FLASH_ERASE, timer, part->length);
+
+        for (size_t pos = 0; pos < header.dataLength; pos += FLASH_BLOCK_SIZE)
+        {
+            size_t count = MIN(header.dataLength - pos, FLASH_BLOCK_SIZE);
+
+            timer = perf_start();
+            if (fread(dataBuffer, 1, count, file) != count)
+            {
+                // The partition is left erased, the app starts with empty data rather than a corrupt one
+                ESP_LOGE(__func__, "Read error in '%s', partition '%s' left erased", filename, part->label);
+                perf_operation_end();
+                restored = 0;
+                goto firmware_restore_data_done;
+            }
+            perf_stop(PERF_SD_READ, timer, count);
+
+            // NVS pages are mostly erased, no need to program those
+            size_t first = 0, last = count;
+            while (first < last && dataBuffer[first] == 0xFF) first++;
+            while (last > first && dataBuffer[last - 1] == 0xFF) last--;
+
+            if (first < last)
+            {
+                timer = perf_start();
+                if (esp_flash_write(NULL, dataBuffer + first, offset + pos + first, last - first) != ESP_OK)
+                {
+                    firmware_ui_panic("WRITE ERROR");
+                }
+                perf_stop(PERF_FLASH_WRITE, timer, last - first);
+            }
+        }
+
+        ESP_LOGI(__func__, "Partition '%s' (%d KB) restored", part->label, header.dataLength / 1024);
+        restored++;
+    }
+
+    perf_operation_end();
+
+firmware_restore_data_done:
+    fclose(file);
+    free(dataBuffer);
+
+    return restored > 0;
+}
+
+
+// Copies one block of the image through the bounce buffer. Returns false when it was already in place.
+static bool install_image_block(size_t srcOffset, size_t dstOffset, size_t length, uint8_t *buffer, uint8_t *compare)
+{
+    perf_timer_t timer;
+    bool identical = true;
+
+    for (size_t offset = 0; offset < length && identical; offset += ERASE_BLOCK_SIZE)
+    {
+        size_t count = MIN(length - offset, ERASE_BLOCK_SIZE);
+
+        timer = perf_start();
+        if (esp_flash_read(NULL, buffer, srcOffset + offset, count) != ESP_OK
+            || esp_flash_read(NULL, compare, dstOffset + offset, count) != ESP_OK)
+        {
+            firmware_ui_panic("DATA READ ERROR");
+        }
+        perf_stop(PERF_FLASH_READ, timer, count * 2);
+        identical = memcmp(buffer, compare, count) == 0;
+    }
+
+    if (identical)
+        return false;
+
+    timer = perf_start();
+    if (esp_flash_erase_region(NULL, dstOffset, FLASH_BLOCK_SIZE) != ESP_OK)
+    {
+        ESP_LOGE(__func__, "esp_flash_erase_region failed. address=%#08x", dstOffset);
+        firmware_ui_panic("ERASE ERROR");
+    }
+    perf_stop(PERF_FLASH_ERASE, timer, FLASH_BLOCK_SIZE);
+
+    for (size_t offset = 0; offset < length; offset += ERASE_BLOCK_SIZE)
+    {
+        size_t count = MIN(length - offset, ERASE_BLOCK_SIZE);
+
+        timer = perf_start();
+        if (esp_flash_read(NULL, buffer, srcOffset + offset, count) != ESP_OK)
+        {
+            firmware_ui_panic("DATA READ ERROR");
+        }
+        perf_stop(PERF_FLASH_READ, timer, count);
+
+        timer = perf_start();
+        if (esp_flash_write(NULL, buffer, dstOffset + offset, count) != ESP_OK)
+        {
+            ESP_LOGE(__func__, "esp_flash_write failed. address=%#08x", dstOffset + offset);
+            firmware_ui_panic("WRITE ERROR");
+        }
+        perf_stop(PERF_FLASH_WRITE, timer, count);
+
+        if (esp_flash_read(NULL, compare, dstOffset + offset, count) != ESP_OK
+            || memcmp(buffer, compare, count) != 0)
+        {
+            ESP_LOGE(__func__, "Verify failed. address=%#08x", dstOffset + offset);
+            firmware_ui_panic("VERIFY ERROR");
+        }
+    }
+
+    return true;
+}
+
+void firmware_install_image(size_t srcOffset, size_t size)
+{
+    size_t blocks = ALIGN_ADDRESS(size, FLASH_BLOCK_SIZE) / FLASH_BLOCK_SIZE;
+    uint8_t *buffer = safe_alloc(ERASE_BLOCK_SIZE * 2);
+    uint8_t *compare = buffer + ERASE_BLOCK_SIZE;
+    char tempstring[128];
+    size_t written = 0;
+
+    // The image goes to 0x0 and we only ever copy downwards, so walking up never clobbers a source
+    // block we still need. When the image doesn't overlap its destination we can do better: the
+    // first block (bootloader, partition table, otadata) goes last, so an interrupted install
+    // reboots into this installer again and the blocks already in place are simply skipped.
+    bool overlaps = srcOffset < blocks * FLASH_BLOCK_SIZE;
+
+    // Erasing a destination block must not reach the source of the same block
+    if (srcOffset < FLASH_BLOCK_SIZE)
+    {
+        firmware_ui_panic("IMAGE LOCATION ERROR");
+    }
+
+    ESP_LOGI(__func__, "Installing %d bytes from %#08x, %s.", size, srcOffset,
+             overlaps ? "overlapping, in order" : "system block last");
+
+    perf_operation_begin("self_install");
+
+    for (size_t i = 0; i < blocks; i++)
+    {
+        size_t block = overlaps ? i : (i + 1) % blocks;
+        size_t offset = block * FLASH_BLOCK_SIZE;
+        size_t length = MIN(size - offset, FLASH_BLOCK_SIZE);
+
+        snprintf(tempstring, sizeof(tempstring), "Installing (%d/%d)", i + 1, blocks);
+        firmware_ui_progress(tempstring, i * 100 / blocks);
+        firmware_ui_led(i & 1);
+
+        if (install_image_block(srcOffset + offset, offset, length, buffer, compare))
+            written++;
+    }
+
+    firmware_ui_progress("Installed!", 100);
+    firmware_ui_led(0);
+
+    ESP_LOGI(__func__, "Done, %d of %d blocks written, %d already in place.", written, blocks, blocks - written);
+    perf_operation_end();
+
+    free(buffer);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define APP_TABLE_MAGIC             0x1207
+#define APP_NVS_SIZE                0x3000
+
+#define FLASH_BLOCK_SIZE            (64 * 1024)
+#define ERASE_BLOCK_SIZE            (4 * 1024)
+
+#define LIST_SORT_OFFSET            0b0000
+#define LIST_SORT_SEQUENCE          0b0010
+#define LIST_SORT_DESCRIPTION       0b0100
+#define LIST_SORT_MAX               0b0101
+#define LIST_SORT_DIR_ASC           0b0000
+#define LIST_SORT_DIR_DESC          0b0001
+
+#define PART_DIGEST_NONE            0
+#define PART_DIGEST_SHA256          1 // mkfw.py --sha256, the digest follows the partition data
+#define PART_DIGEST_SHA256_SIZE     32
+
+#define FIRMWARE_PARTS_MAX          (20)
+#define APP_DATA_MAGIC              "MFW_DATA"
+#define APP_DATA_MAGIC_LENGTH       8
+
+#define FIRMWARE_BATCH_MAX          (32)
+#define FIRMWARE_TILE_WIDTH         (86)
+#define FIRMWARE_TILE_HEIGHT        (48)
+
+#define ALIGN_ADDRESS(val, alignment) (((val & (alignment-1)) != 0) ? (val & ~(alignment-1)) + alignment : val)
+
+#ifdef TARGET_MRGC_G32
+#define HEADER_LENGTH 22
+#define HEADER_V00_01 "ESPLAY_FIRMWARE_V00_01"
+#else
+#define HEADER_LENGTH 24
+#define HEADER_V00_01 "ODROIDGO_FIRMWARE_V00_01"
+#endif
+
+typedef struct odroid_partition
+{
+    uint8_t type;
+    uint8_t subtype;
+    uint8_t digest; // PART_DIGEST_*
+    uint8_t _reserved1;
+    char     label[16];
+    uint32_t flags;
+    uint32_t length;
+    uint32_t dataLength;
+} odroid_partition_t; // __attribute__((packed))
+
+typedef struct odroid_app
+{
+    uint16_t magic;
+    uint16_t flags;
+    uint32_t startOffset;
+    uint32_t endOffset;
+    char     description[40];
+    char     filename[40];
+    uint16_t tile[FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT];
+    odroid_partition_t parts[FIRMWARE_PARTS_MAX];
+    uint8_t parts_count;
+    uint8_t _reserved0;
+    uint16_t installSeq;
+} odroid_app_t;
+
+typedef struct  __attribute__((packed)) odroid_header
+{
+    char version[HEADER_LENGTH];
+    char description[40];
+    uint16_t tile[FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT];
+} odroid_header_t;
+
+typedef struct odroid_fw
+{
+    odroid_header_t header;
+    odroid_partition_t parts[FIRMWARE_PARTS_MAX];
+    uint8_t parts_count;
+    size_t flashSize;
+    size_t fileSize;
+    size_t dataOffset;
+    uint32_t checksum;
+    uint8_t sha256[FIRMWARE_PARTS_MAX][PART_DIGEST_SHA256_SIZE];
+    bool digestsComplete; // Every partition with data has a SHA-256, firmware_install() checks them and the CRC
+} odroid_fw_t;
+
+typedef struct
+{
+    size_t offset;
+    size_t size;
+} odroid_flash_block_t;
+
+extern odroid_app_t *apps;
+extern int apps_count;
+extern int apps_max;
+extern int apps_seq;
+extern int firstAppOffset;
+
+// Front end hooks. main.c implements them with uGUI on the device, host/ implements them for Linux builds.
+void firmware_ui_panic(const char *reason); // Must not return
+void firmware_ui_page(const char *title, const char *header, const char *footer);
+void firmware_ui_progress(const char *message, int percent); // percent < 0 leaves the progress bar alone
+void firmware_ui_led(bool on);
+
+void *safe_alloc(size_t size);
+uint32_t firmware_crc32(uint32_t crc, const void *buf, size_t len); // Same result as the ROM's crc32_le()
+
+void read_app_table(void);
+void write_app_table(void);
+void sort_app_table(int newMode);
+void remove_app(int index);
+
+void write_partition_table(const odroid_app_t *app);
+void write_boot_partition(const odroid_app_t *app);
+
+void defrag_flash(void);
+void find_free_blocks(odroid_flash_block_t **blocks, size_t *count, size_t *totalFreeSpace);
+int find_free_block(size_t size, bool defragIfNeeded);
+
+odroid_fw_t *firmware_get_info(const char *filename);
+bool firmware_verify(const char *filename, const odroid_fw_t *fw);
+// Reads the whole file for the CRC, also when firmware_verify() leaves the check to firmware_install()
+bool firmware_verify_crc(const char *filename, const odroid_fw_t *fw);
+odroid_app_t *firmware_install(const char *filename, const odroid_fw_t *fw, int flashAddress);
+// Places all of them at once, defragmenting at most once. Returns false if they don't fit together.
+bool firmware_plan_batch(odroid_fw_t **fws, int count, int *addresses);
+// Installs back to back and writes the app table once at the end
+void firmware_install_batch(const char **filenames, odroid_fw_t **fws, const int *addresses, int count);
+// Backup file: APP_DATA_MAGIC, then for every saved partition its odroid_partition_t (dataLength =
+// bytes that follow) and the raw flash content. NVS partitions only, or every data partition with allData.
+bool firmware_backup_data(const odroid_app_t *app, const char *filename, bool allData);
+bool firmware_restore_data(const odroid_app_t *app, const char *filename, bool allData);
+void firmware_install_image(size_t srcOffset, size_t size); // Copies a full flash image stored at srcOffset to 0x0
@@ -1,12 +1,15 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <freertos/queue.h>
 #include <freertos/task.h>
 #include <driver/gpio.h>
+#include <esp_timer.h>
 #include <esp_adc/adc_oneshot.h>
 #include <esp_adc/adc_cali.h>
 #include <esp_adc/adc_cali_scheme.h>
 #include <driver/i2c.h>
 #include <esp_log.h>
+#include <stdatomic.h>
 
 #include "input.h"
 
@@ -40,6 +43,10 @@ fail:
 #if CONFIG_HW_ODROID_GO
 #define ODROID_GAMEPAD_IO_X ADC_CHANNEL_6
 #define ODROID_GAMEPAD_IO_Y ADC_CHANNEL_7
+#define ODROID_GAMEPAD_IO_UP GPIO_NUM_NC
+#define ODROID_GAMEPAD_IO_DOWN GPIO_NUM_NC
+#define ODROID_GAMEPAD_IO_LEFT GPIO_NUM_NC
+#define ODROID_GAMEPAD_IO_RIGHT GPIO_NUM_NC
 #define ODROID_GAMEPAD_IO_SELECT GPIO_NUM_27
 #define ODROID_GAMEPAD_IO_START GPIO_NUM_39
 #define ODROID_GAMEPAD_IO_A GPIO_NUM_32
@@ -69,9 +76,67 @@ adc_oneshot_chan_cfg_t config_adc = {
     .atten = ADC_ATTEN_DB_12,
     .bitwidth = ADC_BITWIDTH_12,
 };
+static SemaphoreHandle_t adc_lock; // adc_oneshot_read() fails instead of waiting when another task converts
 #endif
 
-static uint32_t gamepad_state = 0;
+#define INPUT_QUEUE_LENGTH      32
+#define INPUT_DEBOUNCE_US       (20 * 1000)
+#define INPUT_POLL_TICKS        pdMS_TO_TICKS(10)
+#define INPUT_ACTIVE_TICKS      pdMS_TO_TICKS(2000)
+
+// Held directions repeat after DELAY, every RATE at first, each repeat is 1/4 faster down to MIN
+#define INPUT_REPEAT_DELAY_MS   400
+#define INPUT_REPEAT_RATE_MS    150
+#define INPUT_REPEAT_MIN_MS     40
+#define INPUT_REPEAT_MASK       ((1 << ODROID_INPUT_UP) | (1 << ODROID_INPUT_RIGHT) | (1 << ODROID_INPUT_DOWN) | (1 << ODROID_INPUT_LEFT))
+
+#ifdef TARGET_MRGC_G32
+// Buttons sit behind an I2C expander without an interrupt line, they have to be polled
+#define INPUT_POLL_ALWAYS       1
+#elif CONFIG_HW_ODROID_GO
+// The D-pad is an analog joystick, it is sampled while someone waits for input or it is held
+#define INPUT_POLL_DPAD         1
+#define INPUT_DPAD_MASK         ((1 << ODROID_INPUT_UP) | (1 << ODROID_INPUT_RIGHT) | (1 << ODROID_INPUT_DOWN) | (1 << ODROID_INPUT_LEFT))
+#endif
+
+#ifndef INPUT_POLL_ALWAYS
+#define INPUT_POLL_ALWAYS       0
+#endif
+
+#ifndef TARGET_MRGC_G32
+static const gpio_num_t input_gpios[ODROID_INPUT_MAX] = {
+    [ODROID_INPUT_UP] = ODROID_GAMEPAD_IO_UP,
+    [ODROID_INPUT_RIGHT] = ODROID_GAMEPAD_IO_RIGHT,
+    [ODROID_INPUT_DOWN] = ODROID_GAMEPAD_IO_DOWN,
+    [ODROID_INPUT_LEFT] = ODROID_GAMEPAD_IO_LEFT,
+    [ODROID_INPUT_SELECT] = ODROID_GAMEPAD_IO_SELECT,
+    [ODROID_INPUT_START] = ODROID_GAMEPAD_IO_START,
+    [ODROID_INPUT_A] = ODROID_GAMEPAD_IO_A,
+    [ODROID_INPUT_B] = ODROID_GAMEPAD_IO_B,
+    [ODROID_INPUT_MENU] = ODROID_GAMEPAD_IO_MENU,
+    [ODROID_INPUT_VOLUME] = ODROID_GAMEPAD_IO_VOLUME,
+};
+#endif
+
+static volatile uint32_t gamepad_state = 0; // Debounced state, only written by input_task
+static QueueHandle_t input_queue;
+static TaskHandle_t input_task_handle;
+static volatile TickType_t input_active_until;
+static atomic_int input_waiters; // Readers blocked in input_get_event(), the D-pad is sampled while there are any
+static volatile int64_t repeat_delay_us = INPUT_REPEAT_DELAY_MS * 1000;
+static volatile int64_t repeat_rate_us = INPUT_REPEAT_RATE_MS * 1000;
+static volatile int64_t repeat_min_us = INPUT_REPEAT_MIN_MS * 1000;
+
+#if CONFIG_HW_ODROID_GO
+bool input_adc_read(int channel, int *raw)
+{
+    xSemaphoreTake(adc_lock, portMAX_DELAY);
+    esp_err_t ret = adc_oneshot_read(adc_handle, channel, raw);
+    xSemaphoreGive(adc_lock);
+
+    return ret == ESP_OK;
+}
+#endif
 
 uint32_t input_read_raw(void)
 {
@@ -96,11 +161,15 @@ uint32_t input_read_raw(void)
     }
 #else
 #if CONFIG_HW_ODROID_GO
-    int joyX = 0;
-    int joyY = 0;
+    // A failed conversion keeps the last good sample, so a held direction isn't released
+    static int joyX = 0;
+    static int joyY = 0;
+    int raw;
 
-    adc_oneshot_read(adc_handle, ODROID_GAMEPAD_IO_X, &joyX);
-    adc_oneshot_read(adc_handle, ODROID_GAMEPAD_IO_Y, &joyY);
+    if (input_adc_read(ODROID_GAMEPAD_IO_X, &raw))
+        joyX = raw;
+    if (input_adc_read(ODROID_GAMEPAD_IO_Y, &raw))
+        joyY = raw;
 
     if (joyX > 2048 + 1024)
         state |= (1 << ODROID_INPUT_LEFT);
@@ -147,70 +216,172 @@ uint32_t input_read_raw(void)
     return state;
 }
 
-int input_wait_for_button_press(int ticks)
+bool input_get_event(input_event_t *event, int ticks)
 {
-    uint32_t previousState = gamepad_state;
-    uint32_t timeout = xTaskGetTickCount() + ticks;
+#if INPUT_POLL_DPAD
+    // Make sure the joystick is being sampled while we wait, however long that is
+    atomic_fetch_add(&input_waiters, 1);
+    xTaskNotifyGive(input_task_handle);
+#endif
+
+    bool received = xQueueReceive(input_queue, event, ticks > 0 ? ticks : portMAX_DELAY) == pdTRUE;
+
+#if INPUT_POLL_DPAD
+    // Keep sampling a little longer, callers usually wait again right after handling the event
+    input_active_until = xTaskGetTickCount() + INPUT_ACTIVE_TICKS;
+    atomic_fetch_sub(&input_waiters, 1);
+#endif
+
+    return received;
+}
+
+void input_flush(void)
+{
+    xQueueReset(input_queue);
+}
+
+int input_wait_for_button_repeat(int ticks, input_event_t *event)
+{
+    TickType_t start = xTaskGetTickCount();
+    input_event_t next;
 
     while (true)
     {
-        uint32_t state = gamepad_state;
+        TickType_t elapsed = xTaskGetTickCount() - start;
 
-        for (int i = 0; i < ODROID_INPUT_MAX; i++)
-        {
-            if (!(previousState & (1 << i)) && (state & (1 << i))) {
-                return i;
-            }
+        if (ticks > 0 && elapsed >= ticks) {
+            break;
         }
 
-        if (ticks > 0 && timeout < xTaskGetTickCount()) {
+        if (!input_get_event(event, ticks > 0 ? ticks - elapsed : -1)) {
             break;
         }
 
-        previousState = state;
-        vTaskDelay(pdMS_TO_TICKS(10));
+        if (!event->pressed) {
+            continue;
+        }
+
+        // Repeats that piled up while the caller was drawing become a single multi-step event,
+        // so a slow screen jumps straight to the latest position instead of replaying each one.
+        while (xQueuePeek(input_queue, &next, 0) == pdTRUE && next.repeat && next.button == event->button)
+        {
+            xQueueReceive(input_queue, &next, 0);
+            event->count += next.count;
+            event->repeat = true;
+            event->timestamp = next.timestamp;
+        }
+
+        return event->button;
     }
 
     return -1;
 }
 
-static void input_task(void *arg)
+int input_wait_for_button_press(int ticks)
 {
-    uint8_t debounce[ODROID_INPUT_MAX];
+    input_event_t event;
+    return input_wait_for_button_repeat(ticks, &event);
+}
 
-    // Initialize state
-    for (int i = 0; i < ODROID_INPUT_MAX; ++i)
+void input_set_repeat(int delay_ms, int rate_ms, int min_rate_ms)
+{
+    if (rate_ms < 1) rate_ms = 1;
+    if (min_rate_ms < 1 || min_rate_ms > rate_ms) min_rate_ms = rate_ms;
+
+    repeat_delay_us = delay_ms > 0 ? (int64_t)delay_ms * 1000 : 0;
+    repeat_rate_us = (int64_t)rate_ms * 1000;
+    repeat_min_us = (int64_t)min_rate_ms * 1000;
+}
+
+static void IRAM_ATTR input_gpio_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+
+    // Bouncing and the ESP32 GPIO36/39 glitches only cause extra samples, input_task decides
+    vTaskNotifyGiveFromISR(input_task_handle, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void input_post_event(int button, bool pressed, bool repeat, int64_t timestamp)
+{
+    input_event_t event = {
+        .button = button,
+        .pressed = pressed,
+        .repeat = repeat,
+        .count = 1,
+        .timestamp = timestamp,
+    };
+
+    // When nobody reads the queue keep the most recent events
+    if (xQueueSend(input_queue, &event, 0) != pdTRUE)
     {
-        debounce[i] = 0xff;
+        input_event_t oldest;
+        xQueueReceive(input_queue, &oldest, 0);
+        xQueueSend(input_queue, &event, 0);
     }
+}
+
+static void input_task(void *arg)
+{
+    int64_t lockout[ODROID_INPUT_MAX] = {0};
+    int64_t next_repeat[ODROID_INPUT_MAX] = {0};
+    int64_t repeat_interval[ODROID_INPUT_MAX] = {0};
 
     while (1)
     {
         // Read hardware
         uint32_t state = input_read_raw();
+        int64_t now = esp_timer_get_time();
+        bool polling = INPUT_POLL_ALWAYS;
 
-        // Debounce
+        // Debounce: a change is reported on the first sample after the edge, then the
+        // button is ignored for INPUT_DEBOUNCE_US and sampled again once it settled.
         for (int i = 0; i < ODROID_INPUT_MAX; ++i)
         {
-            debounce[i] <<= 1;
-            debounce[i] |= (state >> i) & 1;
-            switch (debounce[i] & 0x03)
-            {
-                case 0x00:
-                    gamepad_state &= ~(1 << i);
-                    break;
+            uint32_t bit = 1 << i;
 
-                case 0x03:
-                    gamepad_state |= (1 << i);
-                    break;
+            if (now < lockout[i])
+            {
+                polling = true;
+                continue;
+            }
 
-                default:
-                    // ignore
-                    break;
+            if ((state ^ gamepad_state) & bit)
+            {
+                gamepad_state ^= bit;
+                lockout[i] = now + INPUT_DEBOUNCE_US;
+                input_post_event(i, (state & bit) != 0, false, now);
+                next_repeat[i] = now + repeat_delay_us;
+                repeat_interval[i] = repeat_rate_us;
+                polling = true;
+            }
+            else if ((gamepad_state & bit & INPUT_REPEAT_MASK) && repeat_delay_us > 0)
+            {
+                // Scheduled from now rather than from the previous deadline so a stall doesn't cause a burst
+                if (now >= next_repeat[i])
+                {
+                    input_post_event(i, true, true, now);
+                    next_repeat[i] = now + repeat_interval[i];
+                    repeat_interval[i] -= repeat_interval[i] / 4;
+                    if (repeat_interval[i] < repeat_min_us)
+                        repeat_interval[i] = repeat_min_us;
+                }
+                polling = true;
             }
         }
 
-        vTaskDelay(pdMS_TO_TICKS(10));
+#if INPUT_POLL_DPAD
+        if (state & INPUT_DPAD_MASK) {
+            input_active_until = xTaskGetTickCount() + INPUT_ACTIVE_TICKS;
+        }
+        polling |= atomic_load(&input_waiters) > 0;
+        polling |= (int32_t)(input_active_until - xTaskGetTickCount()) > 0;
+#endif
+
+        // Sleep until a GPIO edge, or until the next sample when something needs polling
+        ulTaskNotifyTake(pdTRUE, polling ? INPUT_POLL_TICKS : portMAX_DELAY);
     }
 
     vTaskDelete(NULL);
@@ -235,74 +406,46 @@ void input_init(void)
     fail:
 #else
 #if CONFIG_HW_ODROID_GO
+    adc_lock = xSemaphoreCreateMutex();
     ESP_ERROR_CHECK(adc_oneshot_new_unit(&init_config, &adc_handle));
     ESP_ERROR_CHECK(adc_oneshot_config_channel(adc_handle, ODROID_GAMEPAD_IO_X, &config_adc));
     ESP_ERROR_CHECK(adc_oneshot_config_channel(adc_handle, ODROID_GAMEPAD_IO_Y, &config_adc));
-#else
-    if (ODROID_GAMEPAD_IO_UP != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_UP, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_UP, GPIO_PULLUP_ONLY);
-    }
-
-    if (ODROID_GAMEPAD_IO_DOWN != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_DOWN, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_DOWN, GPIO_PULLUP_ONLY);
-    }
-
-    if (ODROID_GAMEPAD_IO_LEFT != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_LEFT, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_LEFT, GPIO_PULLUP_ONLY);
-    }
+#endif
 
-    if (ODROID_GAMEPAD_IO_RIGHT != -1)
+    for (int i = 0; i < ODROID_INPUT_MAX; ++i)
     {
-        gpio_set_direction(ODROID_GAMEPAD_IO_RIGHT, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_RIGHT, GPIO_PULLUP_ONLY);
+        if (input_gpios[i] != -1)
+        {
+            gpio_set_direction(input_gpios[i], GPIO_MODE_INPUT);
+            gpio_set_pull_mode(input_gpios[i], GPIO_PULLUP_ONLY);
+        }
     }
 #endif
 
-    if (ODROID_GAMEPAD_IO_SELECT != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_SELECT, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_SELECT, GPIO_PULLUP_ONLY);
-    }
+    input_queue = xQueueCreate(INPUT_QUEUE_LENGTH, sizeof(input_event_t));
 
-    if (ODROID_GAMEPAD_IO_START != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_START, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_START, GPIO_PULLUP_ONLY);
-    }
+    // Buttons held during boot are not presses
+    gamepad_state = input_read_raw();
 
-    if (ODROID_GAMEPAD_IO_A != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_A, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_A, GPIO_PULLUP_ONLY);
-    }
-
-    if (ODROID_GAMEPAD_IO_B != -1)
-    {
-        gpio_set_direction(ODROID_GAMEPAD_IO_B, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_B, GPIO_PULLUP_ONLY);
-    }
+    xTaskCreatePinnedToCore(&input_task, "input_task", 1024 * 2, NULL, 5, &input_task_handle, 1);
 
-    if (ODROID_GAMEPAD_IO_MENU != -1)
+#ifndef TARGET_MRGC_G32
+    // The ISR service may already be installed by another driver
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE)
     {
-        gpio_set_direction(ODROID_GAMEPAD_IO_MENU, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_MENU, GPIO_PULLUP_ONLY);
+        ESP_LOGE(__func__, "gpio_install_isr_service failed (0x%x), buttons will not wake up input_task", ret);
     }
 
-    if (ODROID_GAMEPAD_IO_VOLUME != -1)
+    for (int i = 0; i < ODROID_INPUT_MAX; ++i)
     {
-        gpio_set_direction(ODROID_GAMEPAD_IO_VOLUME, GPIO_MODE_INPUT);
-        gpio_set_pull_mode(ODROID_GAMEPAD_IO_VOLUME, GPIO_PULLUP_ONLY);
+        if (input_gpios[i] != -1)
+        {
+            gpio_set_intr_type(input_gpios[i], GPIO_INTR_ANYEDGE);
+            gpio_isr_handler_add(input_gpios[i], input_gpio_isr, NULL);
+        }
     }
 #endif
 
-    // Start background polling
-    xTaskCreatePinnedToCore(&input_task, "input_task", 1024 * 2, NULL, 5, NULL, 1);
-
     ESP_LOGI(__func__, "done.");
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 enum
@@ -18,6 +19,20 @@ enum
 	ODROID_INPUT_MAX
 };
 
+typedef struct
+{
+    uint8_t button;
+    bool pressed;
+    bool repeat;       // Generated while a direction is held, not by a new press
+    uint16_t count;    // Presses/repeats merged into this event, see input_wait_for_button_repeat()
+    int64_t timestamp; // esp_timer_get_time() when the change was sampled
+} input_event_t;
+
 void input_init(void);
 uint32_t input_read_raw();
-int input_wait_for_button_press(int ticks);
+bool input_get_event(input_event_t *event, int ticks); // Next press/release, false on timeout (ticks <= 0 waits forever)
+void input_flush(void); // Drops the pending events, before a confirmation they weren't meant for
+int input_wait_for_button_press(int ticks); // Presses and auto-repeats, -1 on timeout
+int input_wait_for_button_repeat(int ticks, input_event_t *event); // Same, with pending repeats merged into event->count
+void input_set_repeat(int delay_ms, int rate_ms, int min_rate_ms); // delay_ms <= 0 disables auto-repeat
+bool input_adc_read(int channel, int *raw); // ODROID-GO: ADC1 conversion serialized with the joystick, false on error
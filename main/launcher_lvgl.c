@@ -0,0 +1,320 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_log.h>
+#include <esp_lcd_panel_io.h>
+#include <esp_lvgl_port.h>
+#include <bsp/esp-bsp.h>
+
+#include "battery.h"
+#include "display.h"
+#include "firmware.h"
+#include "perf.h"
+#include "launcher_lvgl.h"
+
+#define ITEM_COUNT          ((SCREEN_HEIGHT-32)/52) // Same layout as the uGUI page in main.c
+#define ITEM_HEIGHT         52
+#define DRAW_BUF_LINES      20 // Two of them, a row is redrawn in three flushes
+
+#define COLOR_BAR           lv_color_hex(0x191970)
+#define COLOR_ROW           lv_color_hex(0xFFFFFF)
+#define COLOR_SELECTED      lv_color_hex(0xFFFF00)
+#define COLOR_INDICATOR     lv_color_hex(0x8C8A8C)
+#define COLOR_FOOTER        lv_color_hex(0xD3D3D3)
+#define COLOR_OFFSETS       lv_color_hex(0x808080)
+
+// A row is bound to whatever app is on its line of the current page, these tell when it has to be rebound
+typedef struct
+{
+    lv_obj_t *obj;
+    lv_obj_t *tile;
+    lv_obj_t *line1;
+    lv_obj_t *line2;
+    lv_image_dsc_t tile_dsc;
+    const odroid_app_t *app;
+    uint32_t startOffset;
+    uint16_t installSeq;
+} launcher_row_t;
+
+extern esp_lcd_panel_handle_t panel_handle; // display.c
+extern esp_lcd_panel_io_handle_t panel_io_handle;
+
+static const char *TAG = "launcher";
+
+static lv_display_t *disp;
+static launcher_row_t rows[ITEM_COUNT];
+static lv_obj_t *page_label, *battery_label, *empty_label;
+static lv_style_t row_style, row_selected_style;
+static int shown_page = -1, shown_pages = -1, shown_battery = -1;
+static bool hidden = true;
+
+// Redraw cost, fed to the same perf stages as the uGUI page
+static perf_timer_t refr_timer, flush_timer;
+static size_t flushed_bytes;
+static atomic_int transfers_pending;
+
+
+static bool launcher_flush_ready(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    atomic_fetch_sub(&transfers_pending, 1);
+    // Through the port, so its frame stats and flush pacing see the launcher flushes too
+    lvgl_port_flush_ready((lv_display_t *)user_ctx);
+    return false;
+}
+
+static void launcher_display_event(lv_event_t *e)
+{
+    switch (lv_event_get_code(e))
+    {
+        case LV_EVENT_REFR_START:
+            refr_timer = perf_start();
+            flushed_bytes = 0;
+            break;
+        case LV_EVENT_FLUSH_START:
+            if (flushed_bytes == 0)
+                flush_timer = perf_start();
+            flushed_bytes += lv_area_get_size(lv_event_get_param(e)) * sizeof(uint16_t);
+            atomic_fetch_add(&transfers_pending, 1);
+            break;
+        case LV_EVENT_REFR_READY:
+            // The timer runs every LV_DEF_REFR_PERIOD, most of them find nothing invalidated
+            if (flushed_bytes > 0) {
+                perf_stop(PERF_UI_RENDER, refr_timer, 0);
+                perf_stop(PERF_LCD_FLUSH, flush_timer, flushed_bytes);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void launcher_battery_timer(lv_timer_t *timer)
+{
+    int percent = battery_get_state().percent;
+
+    if (percent != shown_battery) {
+        lv_label_set_text_fmt(battery_label, "%d%%", percent);
+        shown_battery = percent;
+    }
+}
+
+static lv_obj_t *launcher_bar(lv_obj_t *parent, int top, const char *text, lv_color_t color)
+{
+    lv_obj_t *bar = lv_obj_create(parent);
+    lv_obj_remove_style_all(bar);
+    lv_obj_set_pos(bar, 0, top);
+    lv_obj_set_size(bar, SCREEN_WIDTH, 16);
+    lv_obj_set_style_bg_color(bar, COLOR_BAR, 0);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, 0);
+
+    lv_obj_t *label = lv_label_create(bar);
+    lv_label_set_text(label, text);
+    lv_obj_set_style_text_color(label, color, 0);
+    lv_obj_center(label);
+    return bar;
+}
+
+static void launcher_create_row(lv_obj_t *parent, int line)
+{
+    const int margin = SCREEN_WIDTH > 240 ? 6 : 2;
+    launcher_row_t *row = &rows[line];
+
+    row->obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(row->obj);
+    lv_obj_add_style(row->obj, &row_style, 0);
+    lv_obj_add_style(row->obj, &row_selected_style, LV_STATE_CHECKED);
+    lv_obj_set_pos(row->obj, 0, 16 + line * ITEM_HEIGHT + 1);
+    lv_obj_set_size(row->obj, SCREEN_WIDTH, ITEM_HEIGHT - 2);
+    lv_obj_remove_flag(row->obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+
+    row->tile_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    row->tile_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    row->tile_dsc.header.w = FIRMWARE_TILE_WIDTH;
+    row->tile_dsc.header.h = FIRMWARE_TILE_HEIGHT;
+    row->tile_dsc.header.stride = FIRMWARE_TILE_WIDTH * sizeof(uint16_t);
+    row->tile_dsc.data_size = FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT * sizeof(uint16_t);
+
+    row->tile = lv_image_create(row->obj);
+    lv_obj_set_pos(row->tile, margin, 0);
+
+    row->line1 = lv_label_create(row->obj);
+    lv_obj_set_pos(row->line1, margin + FIRMWARE_TILE_WIDTH + margin, 6);
+    lv_obj_set_width(row->line1, SCREEN_WIDTH - FIRMWARE_TILE_WIDTH - 3 * margin);
+    lv_label_set_long_mode(row->line1, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_text_color(row->line1, lv_color_black(), 0);
+
+    row->line2 = lv_label_create(row->obj);
+    lv_obj_set_pos(row->line2, margin + FIRMWARE_TILE_WIDTH + margin, 24);
+    lv_obj_set_style_text_color(row->line2, COLOR_OFFSETS, 0);
+
+    lv_obj_add_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Only touches the widgets of a row when what it shows changes, that is what keeps the invalidated area small
+static void launcher_bind_row(launcher_row_t *row, const odroid_app_t *app, bool selected)
+{
+    if (app == NULL) {
+        if (row->app != NULL)
+            lv_obj_add_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+        row->app = NULL;
+        return;
+    }
+
+    if (row->app != app || row->startOffset != app->startOffset || row->installSeq != app->installSeq) {
+        // The table is sorted and compacted in place, same descriptor does not mean same pixels
+        lv_image_cache_drop(&row->tile_dsc);
+        row->tile_dsc.data = (const uint8_t *)app->tile;
+        lv_image_set_src(row->tile, &row->tile_dsc);
+        lv_label_set_text(row->line1, app->description);
+        lv_label_set_text_fmt(row->line2, "0x%lx - 0x%lx", app->startOffset, app->endOffset);
+        lv_obj_remove_flag(row->obj, LV_OBJ_FLAG_HIDDEN);
+        row->app = app;
+        row->startOffset = app->startOffset;
+        row->installSeq = app->installSeq;
+    }
+
+    lv_obj_set_state(row->obj, LV_STATE_CHECKED, selected);
+}
+
+void launcher_init(void)
+{
+    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    ESP_ERROR_CHECK(lvgl_port_init(&lvgl_cfg));
+
+    // display.c owns the panel, the rotation must match what bsp_display_new() set on it
+    const lvgl_port_display_cfg_t disp_cfg = {
+        .io_handle = panel_io_handle,
+        .panel_handle = panel_handle,
+        .buffer_size = SCREEN_WIDTH * DRAW_BUF_LINES,
+        .double_buffer = true,
+        .hres = SCREEN_WIDTH,
+        .vres = SCREEN_OFFSET_TOP + SCREEN_HEIGHT,
+        .monochrome = false,
+        .rotation = {
+#if CONFIG_BSP_DISPLAY_ROTATION_SWAP_XY
+            .swap_xy = true,
+#endif
+#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_X
+            .mirror_x = true,
+#endif
+#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_Y
+            .mirror_y = true,
+#endif
+        },
+        .color_format = LV_COLOR_FORMAT_RGB565,
+        .flags = {
+            .buff_dma = true,
+            .swap_bytes = false, // The panel takes the same pixels as ili9341_writeLE(), tiles included
+        }
+    };
+
+    disp = lvgl_port_add_disp(&disp_cfg);
+    if (!disp) {
+        ESP_LOGE(TAG, "Failed to add the LVGL display");
+        return;
+    }
+
+    lvgl_port_lock(0);
+
+    // lvgl_port_add_disp() registered the port's own transfer done callback, ours also counts them
+    esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &(esp_lcd_panel_io_callbacks_t){ .on_color_trans_done = launcher_flush_ready }, disp);
+    lv_display_add_event_cb(disp, launcher_display_event, LV_EVENT_ALL, NULL);
+
+    lv_style_init(&row_style);
+    lv_style_set_bg_color(&row_style, COLOR_ROW);
+    lv_style_set_bg_opa(&row_style, LV_OPA_COVER);
+    lv_style_init(&row_selected_style);
+    lv_style_set_bg_color(&row_selected_style, COLOR_SELECTED);
+
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(screen, COLOR_ROW, 0);
+    lv_obj_remove_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *root = lv_obj_create(screen);
+    lv_obj_remove_style_all(root);
+    lv_obj_set_pos(root, 0, SCREEN_OFFSET_TOP);
+    lv_obj_set_size(root, SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_obj_remove_flag(root, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *header = launcher_bar(root, 0, "MULTI-FIRMWARE", lv_color_white());
+    launcher_bar(root, SCREEN_HEIGHT - 16, "[MENU] Menu  |  [A] Boot App", COLOR_FOOTER);
+
+    page_label = lv_label_create(header);
+    lv_obj_set_style_text_color(page_label, COLOR_INDICATOR, 0);
+    lv_obj_align(page_label, LV_ALIGN_LEFT_MID, 4, 0);
+
+    battery_label = lv_label_create(header);
+    lv_obj_set_style_text_color(battery_label, COLOR_INDICATOR, 0);
+    lv_obj_align(battery_label, LV_ALIGN_RIGHT_MID, -4, 0);
+    lv_timer_create(launcher_battery_timer, 1000, NULL);
+    launcher_battery_timer(NULL);
+
+    empty_label = lv_label_create(root);
+    lv_label_set_text(empty_label, "No apps have been flashed yet!");
+    lv_obj_set_style_text_color(empty_label, lv_color_black(), 0);
+    lv_obj_center(empty_label);
+
+    for (int line = 0; line < ITEM_COUNT; line++)
+        launcher_create_row(root, line);
+
+    lvgl_port_unlock();
+
+    // Nothing is drawn until the first launcher_show()
+    lvgl_port_stop();
+}
+
+void launcher_show(int currentItem)
+{
+    int page = (currentItem / ITEM_COUNT) * ITEM_COUNT;
+    int pages = (apps_count + ITEM_COUNT - 1) / ITEM_COUNT;
+
+    if (!disp)
+        return;
+
+    lvgl_port_lock(0);
+
+    if (hidden) {
+        // uGUI drew over the panel in between
+        esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &(esp_lcd_panel_io_callbacks_t){ .on_color_trans_done = launcher_flush_ready }, disp);
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        lvgl_port_resume();
+        hidden = false;
+    }
+
+    if (page != shown_page || pages != shown_pages) {
+        lv_label_set_text_fmt(page_label, "%d/%d", page / ITEM_COUNT + 1, pages);
+        shown_page = page;
+        shown_pages = pages;
+    }
+
+    for (int line = 0; line < ITEM_COUNT; line++)
+    {
+        int index = page + line;
+        launcher_bind_row(&rows[line], index < apps_count ? &apps[index] : NULL, index == currentItem);
+    }
+
+    // Unhiding a visible object invalidates it all the same
+    if (lv_obj_has_flag(empty_label, LV_OBJ_FLAG_HIDDEN) == (apps_count == 0))
+        lv_obj_update_flag(empty_label, LV_OBJ_FLAG_HIDDEN, apps_count > 0);
+
+    lvgl_port_unlock();
+}
+
+void launcher_hide(void)
+{
+    if (!disp || hidden)
+        return;
+
+    lvgl_port_lock(0);
+    lvgl_port_stop();
+    hidden = true;
+    lvgl_port_unlock();
+
+    while (atomic_load(&transfers_pending) > 0)
+        vTaskDelay(1);
+
+    ili9341_attach();
+}
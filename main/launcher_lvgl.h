@@ -0,0 +1,9 @@
+#pragma once
+
+// Alternative boot menu list drawn by LVGL through esp_lvgl_port, on the panel display.c already set up.
+// Only the rows whose content or selection changed are redrawn, into two small DMA buffers.
+// Dialogs and messages are still uGUI: launcher_hide() hands the panel back to ili9341_writeLE().
+
+void launcher_init(void); // After ili9341_init()
+void launcher_show(int currentItem); // Shows the page holding currentItem, resumes LVGL if it was hidden
+void launcher_hide(void); // Returns once the last LVGL transfer is done
@@ -11,6 +11,8 @@
 #include <unistd.h>
 
 #include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 #include <esp_flash.h>
 #include <esp_system.h>
 #include <esp_event.h>
@@ -20,132 +22,58 @@
 #include <esp_heap_caps.h>
 #include <esp_flash_partitions.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <nvs_flash.h>
 #include <nvs.h>
 #include <driver/gpio.h>
-//#include <driver/adc.h>
-#include "esp_adc/adc_oneshot.h"
-#include "esp_adc/adc_cali.h"
-#include "esp_adc/adc_cali_scheme.h"
-
-#if CONFIG_HW_ODROID_GO
-adc_oneshot_unit_handle_t adc1_handle;
-adc_oneshot_unit_init_cfg_t init_config1 = {
-    .unit_id = ADC_UNIT_1,
-};
-adc_oneshot_chan_cfg_t config = {
-    .atten = ADC_ATTEN_DB_12,
-    .bitwidth = ADC_BITWIDTH_12,
-};
-#endif
-
-#if (defined(ESP_IDF_VERSION_MAJOR) && (ESP_IDF_VERSION_MAJOR >= 4 && (ESP_IDF_VERSION_MAJOR < 5)))
-#include <esp32/rom/crc.h>
-#else
-#include <rom/crc.h>
-#endif
-
+#include "battery.h"
+#include "firmware.h"
 #include "sdcard.h"
 #include "display.h"
 #include "input.h"
+#include "perf.h"
 
 #include "ugui/ugui.h"
 
+// 1: the app list is drawn by LVGL (launcher_lvgl.c) with partial refreshes, menus and messages stay uGUI.
+// Set by main/CMakeLists.txt with idf.py -DMFW_LVGL_LAUNCHER=1, which also builds launcher_lvgl.c.
+#ifndef MFW_LVGL_LAUNCHER
+#define MFW_LVGL_LAUNCHER 0
+#endif
+
+#if MFW_LVGL_LAUNCHER
+#ifdef CONFIG_IDF_TARGET_ESP32P4
+#error "The LVGL launcher only drives SPI panels"
+#endif
+#include "launcher_lvgl.h"
+#endif
+
 
 #define MFW_NVS_PARTITION  "mfw_nvs"
-#define MFW_DATA_PARTITION "mfw_data"
 
 #ifndef PROJECT_VER
     #define PROJECT_VER "n/a"
 #endif
 
-#define APP_TABLE_MAGIC             0x1207
-#define APP_NVS_SIZE                0x3000
-
-#define FLASH_BLOCK_SIZE            (64 * 1024)
-#define ERASE_BLOCK_SIZE            (4 * 1024)
-
-#define LIST_SORT_OFFSET            0b0000
-#define LIST_SORT_SEQUENCE          0b0010
-#define LIST_SORT_DESCRIPTION       0b0100
-#define LIST_SORT_MAX               0b0101
-#define LIST_SORT_DIR_ASC           0b0000
-#define LIST_SORT_DIR_DESC          0b0001
-
-#define FIRMWARE_PARTS_MAX          (20)
-#define FIRMWARE_TILE_WIDTH         (86)
-#define FIRMWARE_TILE_HEIGHT        (48)
-
-#define BATTERY_VMAX                (4.20f)
-#define BATTERY_VMIN                (3.30f)
-
 #define ITEM_COUNT                  ((SCREEN_HEIGHT-32)/52)
 
-#define ALIGN_ADDRESS(val, alignment) (((val & (alignment-1)) != 0) ? (val & ~(alignment-1)) + alignment : val)
 #define SET_STATUS_LED(on) gpio_set_level(GPIO_NUM_2, on);
 #define RG_MIN(a, b) ({__typeof__(a) _a = (a); __typeof__(b) _b = (b);_a < _b ? _a : _b; })
 #define RG_MAX(a, b) ({__typeof__(a) _a = (a); __typeof__(b) _b = (b);_a > _b ? _a : _b; })
 
+// The SD and LCD SPI hosts are routed to the same pins, the SD driver has to claim them first
+#if defined(CONFIG_HW_SD_PIN_NUM_CLK) && defined(CONFIG_BSP_DISPLAY_SCLK_GPIO) && CONFIG_HW_SD_PIN_NUM_CLK == CONFIG_BSP_DISPLAY_SCLK_GPIO
+#define SDCARD_BEFORE_LCD 1
+#else
+#define SDCARD_BEFORE_LCD 0
+#endif
+
 #ifdef TARGET_MRGC_G32
-#define HEADER_LENGTH 22
-#define HEADER_V00_01 "ESPLAY_FIRMWARE_V00_01"
 #define FIRMWARE_PATH SDCARD_BASE_PATH "/espgbc/firmware"
 #else
-#define HEADER_LENGTH 24
-#define HEADER_V00_01 "ODROIDGO_FIRMWARE_V00_01"
 #define FIRMWARE_PATH SDCARD_BASE_PATH "/odroid/firmware"
 #endif
-
-typedef struct odroid_partition
-{
-    uint8_t type;
-    uint8_t subtype;
-    uint8_t _reserved0;
-    uint8_t _reserved1;
-    char     label[16];
-    uint32_t flags;
-    uint32_t length;
-    uint32_t dataLength;
-} odroid_partition_t; // __attribute__((packed))
-
-typedef struct odroid_app
-{
-    uint16_t magic;
-    uint16_t flags;
-    uint32_t startOffset;
-    uint32_t endOffset;
-    char     description[40];
-    char     filename[40];
-    uint16_t tile[FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT];
-    odroid_partition_t parts[FIRMWARE_PARTS_MAX];
-    uint8_t parts_count;
-    uint8_t _reserved0;
-    uint16_t installSeq;
-} odroid_app_t;
-
-typedef struct  __attribute__((packed)) odroid_header
-{
-    char version[HEADER_LENGTH];
-    char description[40];
-    uint16_t tile[FIRMWARE_TILE_WIDTH * FIRMWARE_TILE_HEIGHT];
-} odroid_header_t;
-
-typedef struct odroid_fw
-{
-    odroid_header_t header;
-    odroid_partition_t parts[FIRMWARE_PARTS_MAX];
-    uint8_t parts_count;
-    size_t flashSize;
-    size_t fileSize;
-    size_t dataOffset;
-    uint32_t checksum;
-} odroid_fw_t;
-
-typedef struct
-{
-    size_t offset;
-    size_t size;
-} odroid_flash_block_t;
+#define BACKUP_PATH FIRMWARE_PATH "/backup"
 
 typedef struct
 {
@@ -154,17 +82,12 @@ typedef struct
     bool enabled;
 } dialog_option_t;
 
-static odroid_app_t *apps;
-static int apps_count = -1;
-static int apps_max = 4;
-static int apps_seq = 0;
-static int firstAppOffset = 0x100000; // We scan the table to find the real value but this is a reasonable default
 static uint16_t fb[SCREEN_WIDTH * SCREEN_HEIGHT];
 static UG_GUI gui;
-static esp_err_t sdcardret;
 static nvs_handle nvs_h;
+static bool nvs_ready;
+static bool ui_ready; // LCD and uGUI are up, the quick relaunch path never sets it
 
-static float read_battery(void);
 
 static void pset(UG_S16 x, UG_S16 y, UG_COLOR color)
 {
@@ -173,7 +96,9 @@ static void pset(UG_S16 x, UG_S16 y, UG_COLOR color)
 
 static void UpdateDisplay(void)
 {
+    perf_timer_t timer = perf_start();
     ili9341_writeLE(fb);
+    perf_stop(PERF_LCD_FLUSH, timer, sizeof(fb));
 }
 
 static void DisplayCenter(int top, const char *str)
@@ -184,7 +109,7 @@ static void DisplayCenter(int top, const char *str)
     char tempstring[128] = {0};
 
     UG_FillFrame(0, top, SCREEN_WIDTH-1, top + height - 1, UG_GetBackcolor());
-    UG_PutString(left, top + 4 , strncpy(tempstring, str, maxlen));
+    UG_PutString(left, top + 4 , strncpy(tempstring, str, RG_MIN(maxlen, sizeof(tempstring) - 1)));
 }
 
 static void DisplayPage(const char *title, const char *footer)
@@ -210,8 +135,7 @@ static void DisplayIndicators(int page, int totalPages)
     UG_PutString(4, 4, tempstring);
 
     // Battery indicator
-    int percent = (read_battery() - BATTERY_VMIN) / (BATTERY_VMAX - BATTERY_VMIN) * 100.f;
-    snprintf(tempstring, sizeof(tempstring), "%d%%", RG_MIN(100, RG_MAX(0, percent)));
+    snprintf(tempstring, sizeof(tempstring), "%d%%", battery_get_state().percent);
     UG_PutString(SCREEN_WIDTH - (9 * strlen(tempstring)) - 4, 4, tempstring);
 }
 
@@ -300,78 +224,16 @@ static void DisplayRow(int line, const char *line1, const char *line2, uint16_t
     }
 }
 
-#if CONFIG_HW_ODROID_GO
-bool test_adc_calibration_init(adc_unit_t unit, adc_channel_t channel, adc_atten_t atten, adc_bitwidth_t bitwidth, adc_cali_handle_t *out_handle)
-{
-    esp_err_t ret = ESP_FAIL;
-    adc_cali_handle_t handle = NULL;
-    bool calibrated = false;
-
-#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
-    ESP_LOGI(__func__, "calibration scheme version is %s", "Curve Fitting");
-    adc_cali_curve_fitting_config_t cali_config = {
-        .unit_id = unit,
-        .chan = channel,
-        .atten = atten,
-        .bitwidth = bitwidth,
-    };
-    ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
-
-#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
-    ESP_LOGI(__func__, "calibration scheme version is %s", "Line Fitting");
-    adc_cali_line_fitting_config_t cali_config = {
-        .unit_id = unit,
-        .atten = atten,
-        .bitwidth = bitwidth,
-    };
-    ret = adc_cali_create_scheme_line_fitting(&cali_config, &handle);
-#endif
-
-    if (ret == ESP_OK) {
-        calibrated = true;
-    } else if (ret == ESP_ERR_NOT_SUPPORTED) {
-        ESP_LOGW(__func__, "calibration fail due to lack of eFuse bits");
-    }
-
-    *out_handle = handle;
-
-    return calibrated;
-}
-#endif
-
-//---------------
-static float read_battery(void)
+static void boot_milestone(const char *name)
 {
-#if CONFIG_HW_ODROID_GO
-    adc_cali_handle_t cali_handle;
-    int raw = 0;
-    int voltage_mv = 0;
-    static float batteryVoltage = -1;
-
-    if (batteryVoltage < 0)
-    {
-        test_adc_calibration_init(init_config1.unit_id, ADC_CHANNEL_0, config.atten, config.bitwidth, &cali_handle);
-        adc_oneshot_config_channel(adc1_handle, ADC_CHANNEL_0, &config);
-        adc_oneshot_read(adc1_handle, ADC_CHANNEL_0, &raw);
-        adc_cali_raw_to_voltage(cali_handle, raw, &voltage_mv);
-        batteryVoltage = ((float)voltage_mv) * 2.f / 1000.f;
-    }
-
-    adc_oneshot_read(adc1_handle, ADC_CHANNEL_0, &raw);
-    adc_cali_raw_to_voltage(cali_handle, raw, &voltage_mv);
-    batteryVoltage = ((float)voltage_mv) * 2.f / 1000.f;
-    batteryVoltage /= 2;
-
-    return batteryVoltage;
-#else
-    return BATTERY_VMAX;
-#endif
+    ESP_LOGI("boot", "%-10s at %dms", name, (int)(esp_timer_get_time() / 1000));
 }
 
 static void panic_abort(const char *reason)
 {
     ESP_LOGE(__func__, "Panic: %s", reason);
-    DisplayError(reason);
+    if (ui_ready)
+        DisplayError(reason);
     int level = 0;
     while (true) {
         SET_STATUS_LED(level);
@@ -380,14 +242,6 @@ static void panic_abort(const char *reason)
     }
 }
 
-static void *safe_alloc(size_t size)
-{
-    void *ptr = malloc(size);
-    if (!ptr)
-        panic_abort("MEMORY ALLOCATION ERROR");
-    return ptr;
-}
-
 static void cleanup_and_restart(void)
 {
 #if CONFIG_HW_ODROID_GO
@@ -397,464 +251,119 @@ static void cleanup_and_restart(void)
     odroid_sdcard_close();
     nvs_close(nvs_h);
     nvs_flash_deinit_partition(MFW_NVS_PARTITION);
-    ili9341_writeLE(memset(fb, 0, sizeof(fb)));
-    ili9341_deinit();
+    if (ui_ready)
+    {
+        ili9341_writeLE(memset(fb, 0, sizeof(fb)));
+        ili9341_deinit();
+    }
     esp_restart();
 }
 
 
-static int sort_app_table_by_offset(const void * a, const void * b)
+void firmware_ui_panic(const char *reason)
 {
-    if ( (*(odroid_app_t*)a).startOffset < (*(odroid_app_t*)b).startOffset ) return -1;
-    if ( (*(odroid_app_t*)a).startOffset > (*(odroid_app_t*)b).startOffset ) return 1;
-    return 0;
+    panic_abort(reason);
 }
 
-static int sort_app_table_by_sequence(const void * a, const void * b)
+void firmware_ui_page(const char *title, const char *header, const char *footer)
 {
-    return (*(odroid_app_t*)a).installSeq - (*(odroid_app_t*)b).installSeq;
+    if (!ui_ready)
+        return;
+    DisplayPage(title, footer);
+    DisplayHeader(header);
+    UpdateDisplay();
 }
 
-static int sort_app_table_by_alphabet(const void * a, const void * b)
+void firmware_ui_progress(const char *message, int percent)
 {
-    return strcasecmp((*(odroid_app_t*)a).description, (*(odroid_app_t*)b).description);
+    if (!ui_ready)
+        return;
+    if (percent >= 0)
+        DisplayProgress(percent);
+    if (message)
+        DisplayMessage(message);
 }
 
-static void sort_app_table(int newMode)
+void firmware_ui_led(bool on)
 {
-    switch(newMode & ~1) {
-        case LIST_SORT_SEQUENCE:
-            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_sequence);
-            break;
-        case LIST_SORT_DESCRIPTION:
-            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_alphabet);
-            break;
-        case LIST_SORT_OFFSET:
-        default:
-            qsort(apps, apps_count, sizeof(odroid_app_t), &sort_app_table_by_offset);
-            break;
-    }
-
-    if (newMode & 1) { // Reverse array. Very inefficient.
-        odroid_app_t *tmp = safe_alloc(sizeof(odroid_app_t));
-        int i = apps_count - 1, j = 0;
-        while (i > j)
-        {
-            memcpy(tmp, &apps[i], sizeof(odroid_app_t));
-            memcpy(&apps[i], &apps[j], sizeof(odroid_app_t));
-            memcpy(&apps[j], tmp, sizeof(odroid_app_t));
-            i--;
-            j++;
-        }
-        free(tmp);
-    }
+    SET_STATUS_LED(on);
 }
 
 
-static void read_app_table(void)
-{
-    const esp_partition_t *app_table_part = esp_partition_find_first(
-        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, MFW_DATA_PARTITION);
-
-    if (!app_table_part)
-    {
-        panic_abort("NO APP TABLE ERROR");
-    }
-    else if (!apps)
-    {
-        apps = safe_alloc(app_table_part->size);
-    }
-
-    apps_max = (app_table_part->size / sizeof(odroid_app_t));
-    apps_count = 0;
-    apps_seq = 0;
-
-    if (esp_partition_read(app_table_part, 0, apps, app_table_part->size) != ESP_OK)
-    {
-        panic_abort("APP TABLE READ ERROR");
-    }
-
-    for (int i = 0; i < apps_max; i++)
-    {
-        if (apps[i].magic != APP_TABLE_MAGIC)
-            break;
-        if (apps[i].installSeq >= apps_seq)
-            apps_seq = apps[i].installSeq + 1;
-        apps_count++;
-    }
-
-    //64K align the address (https://docs.espressif.com/projects/esp-idf/en/latest/api-guides/partition-tables.html#offset-size)
-    firstAppOffset = app_table_part->address + app_table_part->size;
-    firstAppOffset = ALIGN_ADDRESS(firstAppOffset, FLASH_BLOCK_SIZE);
-
-    ESP_LOGI(__func__, "Read app table (%d apps)", apps_count);
-}
-
-
-static void write_app_table()
+// The quick relaunch finds the last app by where it lives and what it was installed from,
+// installSeq is reused once the newest app is removed
+typedef struct
 {
-    const esp_partition_t *app_table_part = esp_partition_find_first(
-        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, MFW_DATA_PARTITION);
-
-    if (!apps || !app_table_part)
-    {
-        panic_abort("NO APP TABLE ERROR");
-    }
-
-    for (int i = apps_count; i < apps_max; ++i)
-    {
-        memset(&apps[i], 0xff, sizeof(odroid_app_t));
-    }
-
-    if (esp_partition_erase_range(app_table_part, 0, app_table_part->size) != ESP_OK)
-    {
-        panic_abort("APP TABLE ERASE ERROR");
-    }
-
-    if (esp_partition_write(app_table_part, 0, apps, app_table_part->size) != ESP_OK)
-    {
-        panic_abort("APP TABLE WRITE ERROR");
-    }
-
-    ESP_LOGI(__func__, "Written app table (%d apps)", apps_count);
-}
-
+    uint32_t startOffset;
+    char filename[40];
+} last_app_t;
 
-static void write_partition_table(const odroid_app_t *app)
+static void open_settings(void)
 {
-    esp_partition_info_t partitionTable[ESP_PARTITION_TABLE_MAX_ENTRIES];
-    size_t nextPart = 0;
-
-    if (esp_flash_read(NULL, &partitionTable, ESP_PARTITION_TABLE_OFFSET, sizeof(partitionTable)) != ESP_OK)
-    {
-        panic_abort("PART TABLE READ ERROR");
-    }
-
-    // Keep only the valid system partitions
-    for (int i = 0; i < ESP_PARTITION_TABLE_MAX_ENTRIES; ++i)
-    {
-        esp_partition_info_t *part = &partitionTable[i];
-        if (part->magic == 0xFFFF)
-            break;
-        if (part->magic != ESP_PARTITION_MAGIC)
-            continue;
-        if (part->pos.offset >= firstAppOffset)
-            continue;
-        partitionTable[nextPart++] = *part;
-        ESP_LOGI(__func__, "Keeping partition #%d '%s'", nextPart - 1, part->label);
-    }
-
-    // Append app's partitions, if any
-    if (app)
-    {
-        size_t flashOffset = app->startOffset;
-
-        for (int i = 0; i < app->parts_count && i < ESP_PARTITION_TABLE_MAX_ENTRIES; ++i)
-        {
-            esp_partition_info_t* part = &partitionTable[nextPart++];
-            part->magic = ESP_PARTITION_MAGIC;
-            part->type = app->parts[i].type;
-            part->subtype = app->parts[i].subtype;
-            part->pos.offset = flashOffset;
-            part->pos.size = app->parts[i].length;
-            memcpy(&part->label, app->parts[i].label, 16);
-            part->flags = app->parts[i].flags;
-
-            flashOffset += app->parts[i].length;
-
-            ESP_LOGI(__func__, "Added partition #%d '%s'", nextPart - 1, part->label);
-        }
-    }
-
-    // We must fill the rest with 0xFF, the boot loader checks magic = 0xFFFF, type = 0xFF, subtype = 0xFF
-    while (nextPart < ESP_PARTITION_TABLE_MAX_ENTRIES)
-    {
-        memset(&partitionTable[nextPart++], 0xFF, sizeof(esp_partition_info_t));
-    }
-
-    if (esp_flash_erase_region(NULL, ESP_PARTITION_TABLE_OFFSET, ERASE_BLOCK_SIZE) != ESP_OK)
-    {
-        panic_abort("PART TABLE ERASE ERROR");
-    }
+    if (nvs_ready)
+        return;
 
-    if (esp_flash_write(NULL, partitionTable, ESP_PARTITION_TABLE_OFFSET, sizeof(partitionTable)) != ESP_OK)
-    {
-        panic_abort("PART TABLE WRITE ERROR");
+    nvs_flash_init_partition(MFW_NVS_PARTITION);
+    if (nvs_open("settings", NVS_READWRITE, &nvs_h) != ESP_OK) {
+        nvs_flash_erase();
+        nvs_open("settings", NVS_READWRITE, &nvs_h);
     }
-
-    // esp_partition_reload_table();
+    nvs_ready = true;
 }
 
-
 static void boot_application(odroid_app_t *app)
 {
     ESP_LOGI(__func__, "Booting application.");
 
     if (app)
     {
-        DisplayMessage("Updating partitions ...");
-        write_partition_table(app);
+        last_app_t last = {.startOffset = app->startOffset};
+        strncpy(last.filename, app->filename, sizeof(last.filename) - 1);
+        nvs_set_blob(nvs_h, "last_app_id", &last, sizeof(last));
+        nvs_commit(nvs_h);
     }
 
-    DisplayMessage("Setting boot partition ...");
-
-// This is the correct way of doing things, but we must patch esp-idf to allow us to reload the partition table
-// So, now, instead we just write the OTA partition ourselves. It is always the same (boot app OTA+0).
-#if 0
-    const esp_partition_t *partition = esp_partition_find_first(
-        ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, NULL);
-
-    if (!partition)
-    {
-        DisplayError("NO BOOT PART ERROR");
-        panic_abort();
-    }
-
-    if (esp_ota_set_boot_partition(partition) != ESP_OK)
-    {
-        DisplayError("BOOT SET ERROR");
-        panic_abort();
-    }
-#else
-    uint32_t ota_data[8] = {1, 0, 0, 0, 0, 0, 0xFFFFFFFFU, 0x4743989A};
-
-    if (esp_flash_erase_region(NULL, 0xD000, 0x1000) != ESP_OK
-        || esp_flash_write(NULL, &ota_data, 0xD000, sizeof(ota_data)) != ESP_OK)
-    {
-        panic_abort("BOOT SET ERROR");
-    }
-#endif
+    write_boot_partition(app);
 
     cleanup_and_restart();
 }
 
 
-static void defrag_flash(void)
-{
-    size_t nextStartOffset = firstAppOffset;
-    size_t totalBytesToMove = 0;
-    size_t totalBytesMoved = 0;
-    char tempstring[128];
-
-    sort_app_table(LIST_SORT_OFFSET);
-
-    // First loop to get total for the progress bar
-    for (int i = 0; i < apps_count; i++)
-    {
-        if (apps[i].startOffset > nextStartOffset)
-        {
-            totalBytesToMove += (apps[i].endOffset - apps[i].startOffset);
-        } else {
-            nextStartOffset = apps[i].endOffset + 1;
-        }
-    }
-
-    snprintf(tempstring, sizeof(tempstring), "Moving: %.2f MB", (float)totalBytesToMove / 1024 / 1024);
-    DisplayPage("Defragmenting flash", tempstring);
-    DisplayHeader("Making some space...");
-    UpdateDisplay();
-
-    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
-
-    for (int i = 0; i < apps_count; i++)
-    {
-        if (apps[i].startOffset > nextStartOffset)
-        {
-            SET_STATUS_LED(1);
-
-            size_t app_size = apps[i].endOffset - apps[i].startOffset;
-            size_t newOffset = nextStartOffset, oldOffset = apps[i].startOffset;
-            // move
-            for (size_t i = 0; i < app_size; i += FLASH_BLOCK_SIZE)
-            {
-                ESP_LOGI(__func__, "Moving 0x%x to 0x%x", oldOffset + i, newOffset + i);
-
-                DisplayMessage("Defragmenting ... (E)");
-                esp_flash_erase_region(NULL, newOffset + i, FLASH_BLOCK_SIZE);
-
-                DisplayMessage("Defragmenting ... (R)");
-                esp_flash_read(NULL, dataBuffer, oldOffset + i, FLASH_BLOCK_SIZE);
-
-                DisplayMessage("Defragmenting ... (W)");
-                esp_flash_write(NULL, dataBuffer, newOffset + i, FLASH_BLOCK_SIZE);
-
-                totalBytesMoved += FLASH_BLOCK_SIZE;
-
-                DisplayProgress((float) totalBytesMoved / totalBytesToMove  * 100.0);
-            }
-
-            apps[i].startOffset = newOffset;
-            apps[i].endOffset = newOffset + app_size;
-
-            SET_STATUS_LED(0);
-        }
-
-        nextStartOffset = apps[i].endOffset + 1;
-    }
-
-    free(dataBuffer);
-
-    write_app_table();
-}
-
-
-static void find_free_blocks(odroid_flash_block_t **blocks, size_t *count, size_t *totalFreeSpace)
+// Saved settings live on the SD card under the app's .fw name, they survive deleting the app
+static void app_data_path(const odroid_app_t *app, char *path, size_t size)
 {
-    size_t flashSize = 0;
-    size_t previousBlockEnd = firstAppOffset;
-
-    esp_flash_get_size(NULL, (uint32_t *)&flashSize);
-
-    *blocks = safe_alloc(sizeof(odroid_flash_block_t) * 32);
-    *totalFreeSpace = 0;
-    *count = 0;
-
-    sort_app_table(LIST_SORT_OFFSET);
-
-    for (int i = 0; i < apps_count; i++)
-    {
-        size_t free_space = apps[i].startOffset - previousBlockEnd;
-
-        if (free_space > 0) {
-            odroid_flash_block_t *block = &(*blocks)[(*count)++];
-            block->offset = previousBlockEnd;
-            block->size = free_space;
-            *totalFreeSpace += block->size;
-            ESP_LOGI(__func__, "Found free block: %d 0x%x %d", i, block->offset, free_space / 1024);
-        }
-
-        previousBlockEnd = apps[i].endOffset + 1;
-    }
-
-    if (((int)flashSize - previousBlockEnd) > 0) {
-        odroid_flash_block_t *block = &(*blocks)[(*count)++];
-        block->offset = previousBlockEnd;
-        block->size = (flashSize - previousBlockEnd);
-        *totalFreeSpace += block->size;
-        ESP_LOGI(__func__, "Found free block: end 0x%x %d", block->offset, block->size / 1024);
-    }
+    snprintf(path, size, "%s%s.data", BACKUP_PATH, app->filename);
 }
 
-static int find_free_block(size_t size, bool defragIfNeeded)
+static bool backup_app_data(const odroid_app_t *app)
 {
-    odroid_flash_block_t *blocks;
-    size_t count, totalFreeSpace;
-
-    find_free_blocks(&blocks, &count, &totalFreeSpace);
+    char path[128];
 
-    int result = -1;
+    if (odroid_sdcard_wait() != ESP_OK)
+        return false;
 
-    for (int i = 0; i < count; i++)
-    {
-        if (blocks[i].size >= size) {
-            result = blocks[i].offset;
-            break;
-        }
-    }
-
-    if (result < 0 && totalFreeSpace >= size) {
-        defrag_flash();
-        result = find_free_block(size, false);
-    }
-
-    free(blocks);
-    return result;
+    mkdir(BACKUP_PATH, 0777);
+    app_data_path(app, path, sizeof(path));
+    return firmware_backup_data(app, path, true);
 }
 
-
-static odroid_fw_t *firmware_get_info(const char *filename)
+// A freshly installed app gets the NVS it had before it was deleted (updates are delete + install)
+static void restore_app_nvs(const odroid_app_t *app)
 {
-    odroid_fw_t *outData = safe_alloc(sizeof(odroid_fw_t));
-
-    FILE* file = fopen(filename, "rb");
-    if (!file)
-        goto firmware_get_info_err;
-
-    size_t file_size;
-
-    fseek(file, 0, SEEK_END);
-    file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    if (!fread(&outData->header, sizeof(outData->header), 1, file))
-    {
-        goto firmware_get_info_err;
-    }
-
-    if (memcmp(HEADER_V00_01, outData->header.version, HEADER_LENGTH) != 0)
-    {
-        goto firmware_get_info_err;
-    }
-
-    outData->header.description[sizeof(outData->header.description) - 1] = 0;
-    outData->parts_count = 0;
-    outData->flashSize = 0;
-    outData->dataOffset = ftell(file);
-    outData->fileSize = file_size;
-
-    while (ftell(file) < (file_size - 4))
-    {
-        // Partition information
-        odroid_partition_t *part = &outData->parts[outData->parts_count];
-
-        if (fread(part, sizeof(odroid_partition_t), 1, file) != 1)
-            goto firmware_get_info_err;
-
-        // Check if dataLength is valid
-        if (ftell(file) + part->dataLength > file_size || part->dataLength > part->length)
-            goto firmware_get_info_err;
-
-        // Check partition subtype
-        if (part->type == 0xff)
-            goto firmware_get_info_err;
+    char path[128];
+    struct stat st;
 
-        // 4KB align the partition length, this is needed for erasing
-        part->length = ALIGN_ADDRESS(part->length, ERASE_BLOCK_SIZE);
-
-        outData->flashSize += part->length;
-        outData->parts_count++;
-
-        fseek(file, part->dataLength, SEEK_CUR);
-    }
-
-    if (outData->parts_count >= FIRMWARE_PARTS_MAX)
-        goto firmware_get_info_err;
-
-    fseek(file, file_size - sizeof(outData->checksum), SEEK_SET);
-    fread(&outData->checksum, sizeof(outData->checksum), 1, file);
+    app_data_path(app, path, sizeof(path));
+    if (stat(path, &st) != 0)
+        return;
 
-    // We try to steal some unused space if possible, otherwise we might waste up to 48K
-    odroid_partition_t *part = &outData->parts[outData->parts_count - 1];
-    if (part->type == ESP_PARTITION_TYPE_APP && (part->length - part->dataLength) >= APP_NVS_SIZE) {
-        ESP_LOGI(__func__, "Found room for NVS partition, reducing last partition size by %d", APP_NVS_SIZE);
-        part->length -= APP_NVS_SIZE;
-        outData->flashSize -= APP_NVS_SIZE;
-    }
-    // Add an application-specific NVS partition.
-    odroid_partition_t *nvs_part = &outData->parts[outData->parts_count];
-    strcpy(nvs_part->label, "nvs");
-    nvs_part->dataLength = 0;
-    nvs_part->length = APP_NVS_SIZE;
-    nvs_part->type = ESP_PARTITION_TYPE_DATA;
-    nvs_part->subtype = ESP_PARTITION_SUBTYPE_DATA_NVS;
-    outData->flashSize += nvs_part->length;
-    outData->parts_count++;
-
-    fclose(file);
-    return outData;
-
-firmware_get_info_err:
-    free(outData);
-    fclose(file);
-    return NULL;
+    DisplayMessage("Restoring saved settings ...");
+    firmware_restore_data(app, path, false);
 }
 
-
 static void flash_firmware(const char *fullPath)
 {
-    odroid_app_t *app = memset(&apps[apps_count], 0x00, sizeof(*app));
     odroid_fw_t *fw = firmware_get_info(fullPath);
-    void *dataBuffer = safe_alloc(FLASH_BLOCK_SIZE);
     char tempstring[128];
 
     ESP_LOGI(__func__, "Flashing file: %s", fullPath);
@@ -869,7 +378,14 @@ static void flash_firmware(const char *fullPath)
     {
         DisplayError("INVALID FIRMWARE FILE"); // To do: Make it show what is invalid
         while (input_wait_for_button_press(-1) != ODROID_INPUT_B);
-        free(dataBuffer), free(fw);
+        return;
+    }
+
+    if (apps_count >= apps_max)
+    {
+        DisplayError("APP TABLE FULL");
+        while (input_wait_for_button_press(-1) != ODROID_INPUT_B);
+        free(fw);
         return;
     }
 
@@ -878,22 +394,16 @@ static void flash_firmware(const char *fullPath)
     {
         DisplayError("NOT ENOUGH FREE SPACE");
         while (input_wait_for_button_press(-1) != ODROID_INPUT_B);
-        free(dataBuffer), free(fw);
+        free(fw);
         return;
     }
 
-    strncpy(app->description, fw->header.description, sizeof(app->description)-1);
-    strncpy(app->filename, strrchr(fullPath, '/'), sizeof(app->filename)-1);
-    memcpy(app->tile, fw->header.tile, sizeof(app->tile));
-    memcpy(app->parts, fw->parts, sizeof(app->parts));
-    app->parts_count = fw->parts_count;
-
     ESP_LOGI(__func__, "Destination: 0x%x", currentFlashAddress);
-    ESP_LOGI(__func__, "Description: '%s'", app->description);
+    ESP_LOGI(__func__, "Description: '%s'", fw->header.description);
 
     snprintf(tempstring, sizeof(tempstring), "Destination: 0x%x", currentFlashAddress);
     DisplayPage("Install Application", tempstring);
-    DisplayHeader(app->description);
+    DisplayHeader(fw->header.description);
     DisplayMessage("[START]");
     DisplayFooter("[B] Cancel");
 
@@ -902,16 +412,19 @@ static void flash_firmware(const char *fullPath)
 
     for (int i = 0 ; i < FIRMWARE_TILE_HEIGHT; ++i)
         for (int j = 0; j < FIRMWARE_TILE_WIDTH; ++j)
-            UG_DrawPixel(tileLeft + j, tileTop + i, app->tile[i * FIRMWARE_TILE_WIDTH + j]);
+            UG_DrawPixel(tileLeft + j, tileTop + i, fw->header.tile[i * FIRMWARE_TILE_WIDTH + j]);
 
     UG_DrawFrame(tileLeft - 1, tileTop - 1, tileLeft + FIRMWARE_TILE_WIDTH, tileTop + FIRMWARE_TILE_HEIGHT, C_BLACK);
     UpdateDisplay();
 
+    // START must be pressed on this page, not earlier
+    input_flush();
+
     while (1)
     {
         int btn = input_wait_for_button_press(-1);
         if (btn == ODROID_INPUT_START) break;
-        if (btn == ODROID_INPUT_B) return;
+        if (btn == ODROID_INPUT_B) { free(fw); return; }
     }
 
     DisplayMessage("Verifying ...");
@@ -920,171 +433,185 @@ static void flash_firmware(const char *fullPath)
 
     SET_STATUS_LED(1);
 
-    FILE *file = fopen(fullPath, "rb");
-    if (file == NULL)
+    if (!firmware_verify(fullPath, fw))
     {
-        panic_abort("FILE OPEN ERROR");
+        panic_abort("CHECKSUM MISMATCH ERROR");
     }
 
-    uint32_t checksum = 0;
-    while (true)
-    {
-        size_t count = fread(dataBuffer, 1, FLASH_BLOCK_SIZE, file);
-        if (ftell(file) == fw->fileSize)
-        {
-            count -= 4;
-        }
+    odroid_app_t *app = firmware_install(fullPath, fw, currentFlashAddress);
+    free(fw);
 
-        checksum = crc32_le(checksum, dataBuffer, count);
+    restore_app_nvs(app);
+    input_flush();
 
-        if (count < FLASH_BLOCK_SIZE) break;
-    }
+    DisplayMessage("Ready !");
+    DisplayFooter("[B] Go Back  |  [A] Boot");
+    UpdateDisplay();
 
-    if (checksum != fw->checksum)
+    while (1)
     {
-        ESP_LOGE(__func__, "Checksum mismatch: expected: %#010x, computed:%#010x", fw->checksum, checksum);
-        panic_abort("CHECKSUM MISMATCH ERROR");
+        int btn = input_wait_for_button_press(-1);
+        if (btn == ODROID_INPUT_START) break;
+        if (btn == ODROID_INPUT_A) break;
+        if (btn == ODROID_INPUT_B) return;
     }
-    ESP_LOGI(__func__, "Checksum OK: %#010x", checksum);
 
-    // restore location to end of description
-    fseek(file, fw->dataOffset, SEEK_SET);
+    boot_application(app);
+}
 
-    app->magic = APP_TABLE_MAGIC;
-    app->startOffset = currentFlashAddress;
+static void flash_firmware_batch(const char **fullPaths, int count)
+{
+    odroid_fw_t *fws[FIRMWARE_BATCH_MAX] = {0};
+    int addresses[FIRMWARE_BATCH_MAX];
+    size_t totalSize = 0;
+    char tempstring[128];
+    const char *error = NULL;
 
-    // Copy the firmware
-    for (int i = 0; i < app->parts_count; i++)
-    {
-        odroid_partition_t *slot = &app->parts[i];
+    ESP_LOGI(__func__, "Flashing %d files", count);
 
-        // Skip header, firmware_get_info prepared everything for us
-        fseek(file, sizeof(odroid_partition_t), SEEK_CUR);
+    sort_app_table(LIST_SORT_OFFSET);
+    DisplayPage("Install Applications", "Destination: Pending");
+    DisplayFooter("[B] Go Back");
+    UpdateDisplay();
+    SET_STATUS_LED(0);
 
-        SET_STATUS_LED(0);
+    for (int i = 0; i < count; i++)
+    {
+        if (!(fws[i] = firmware_get_info(fullPaths[i])))
+        {
+            ESP_LOGE(__func__, "Invalid firmware: %s", fullPaths[i]);
+            error = "INVALID FIRMWARE FILE";
+            break;
+        }
+        totalSize += fws[i]->flashSize;
+    }
 
-        // Erase target partition space
-        snprintf(tempstring, sizeof(tempstring), "Erasing ... (%d/%d)", i+1, app->parts_count);
-        ESP_LOGI(__func__, "%s", tempstring);
+    if (!error && apps_count + count > apps_max)
+    {
+        error = "APP TABLE FULL";
+    }
 
-        DisplayProgress(0);
-        DisplayMessage(tempstring);
+    if (!error)
+    {
+        snprintf(tempstring, sizeof(tempstring), "%d apps, %.2f MB", count, (double)totalSize / 1024 / 1024);
+        DisplayHeader(tempstring);
+        DisplayMessage("[START]");
+        DisplayFooter("[B] Cancel");
+        UpdateDisplay();
 
-        int eraseBlocks = slot->length / ERASE_BLOCK_SIZE;
-        if (eraseBlocks * ERASE_BLOCK_SIZE < slot->length) ++eraseBlocks;
+        input_flush();
 
-        if (esp_flash_erase_region(NULL, currentFlashAddress, eraseBlocks * ERASE_BLOCK_SIZE) != ESP_OK)
+        while (1)
         {
-            ESP_LOGE(__func__, "esp_flash_erase_region failed. eraseBlocks=%d", eraseBlocks);
-            panic_abort("ERASE ERROR");
+            int btn = input_wait_for_button_press(-1);
+            if (btn == ODROID_INPUT_START) break;
+            if (btn == ODROID_INPUT_B) goto flash_firmware_batch_done;
         }
 
-        if (slot->dataLength > 0)
+        if (!firmware_plan_batch(fws, count, addresses))
         {
-            size_t nextEntry = ftell(file) + slot->dataLength;
-
-            SET_STATUS_LED(1);
-
-            // Write data
-            int totalCount = 0;
-            for (int offset = 0; offset < slot->dataLength; offset += FLASH_BLOCK_SIZE)
-            {
-                snprintf(tempstring, sizeof(tempstring), "Writing (%d/%d)", i+1, app->parts_count);
-                ESP_LOGI(__func__, "%s", tempstring);
-                DisplayProgress((float)offset / (float)(slot->dataLength - FLASH_BLOCK_SIZE) * 100.0f);
-                DisplayMessage(tempstring);
-
-                // read
-                size_t count = fread(dataBuffer, 1, FLASH_BLOCK_SIZE, file);
-                if (count <= 0)
-                {
-                    panic_abort("DATA READ ERROR");
-                }
-
-                if (offset + count >= slot->dataLength)
-                {
-                    count = slot->dataLength - offset;
-                }
-
-                // flash
-                if (esp_flash_write(NULL, dataBuffer, currentFlashAddress + offset, count) != ESP_OK)
-        		{
-        			ESP_LOGE(__func__, "esp_flash_write failed. address=%#08x", currentFlashAddress + offset);
-                    panic_abort("WRITE ERROR");
-        		}
+            error = "NOT ENOUGH FREE SPACE";
+        }
+    }
 
-                totalCount += count;
-            }
+    if (error)
+    {
+        DisplayError(error);
+        while (input_wait_for_button_press(-1) != ODROID_INPUT_B);
+        goto flash_firmware_batch_done;
+    }
 
-            SET_STATUS_LED(0);
+    SET_STATUS_LED(1);
 
-            if (totalCount != slot->dataLength)
-            {
-                ESP_LOGE(__func__, "Size mismatch: length=%#08x, totalCount=%#08x", slot->dataLength, totalCount);
-                panic_abort("DATA SIZE ERROR");
-            }
+    // Check every file before the first write, a bad one shouldn't leave half a batch behind.
+    // Files with digests are read here too, firmware_verify() would only check them while writing.
+    for (int i = 0; i < count; i++)
+    {
+        snprintf(tempstring, sizeof(tempstring), "Verifying %d/%d ...", i + 1, count);
+        DisplayMessage(tempstring);
 
-            fseek(file, nextEntry, SEEK_SET);
-            // TODO: verify
+        if (!firmware_verify_crc(fullPaths[i], fws[i]))
+        {
+            panic_abort("CHECKSUM MISMATCH ERROR");
         }
-
-        // Notify OK
-        ESP_LOGI(__func__, "Partition(%d): OK. Length=%#08x", i, slot->length);
-        currentFlashAddress += slot->length;
     }
 
-    fclose(file);
-    free(fw);
-    free(dataBuffer);
-
-    // 64K align our endOffset
-    app->endOffset = ALIGN_ADDRESS(currentFlashAddress, FLASH_BLOCK_SIZE) - 1;
+    firmware_install_batch(fullPaths, fws, addresses, count);
 
-    // Remember the install order, for display sorting
-    app->installSeq = apps_seq++;
-
-    // Write app table
-    apps_count++; // Everything went well, acknowledge the new app
-    write_app_table();
+    // The new apps are at the end of the table
+    for (int i = apps_count - count; i < apps_count; i++)
+        restore_app_nvs(&apps[i]);
+    input_flush();
 
     DisplayMessage("Ready !");
-    DisplayFooter("[B] Go Back  |  [A] Boot");
+    DisplayFooter("[B] Go Back");
     UpdateDisplay();
 
-    while (1)
+    while (input_wait_for_button_press(-1) != ODROID_INPUT_B);
+
+flash_firmware_batch_done:
+    for (int i = 0; i < count; i++)
+        free(fws[i]);
+}
+
+
+// Moves the cursor of a paged list. Single presses wrap around at the ends, held directions stop
+// there and apply all the repeats merged into the event at once.
+static int ui_list_navigate(int btn, const input_event_t *event, int currentItem, int itemCount)
+{
+    int page = (currentItem / ITEM_COUNT) * ITEM_COUNT;
+    int lastPage = (itemCount - 1) / ITEM_COUNT * ITEM_COUNT;
+    int steps = RG_MAX((int)event->count, 1);
+
+    if (btn == ODROID_INPUT_DOWN || btn == ODROID_INPUT_UP)
     {
-        int btn = input_wait_for_button_press(-1);
-        if (btn == ODROID_INPUT_START) break;
-        if (btn == ODROID_INPUT_A) break;
-        if (btn == ODROID_INPUT_B) return;
+        int next = currentItem + (btn == ODROID_INPUT_DOWN ? steps : -steps);
+        if (event->repeat) return RG_MAX(0, RG_MIN(itemCount - 1, next));
+        return ((next % itemCount) + itemCount) % itemCount;
+    }
+    else if (btn == ODROID_INPUT_RIGHT)
+    {
+        if (page + steps * ITEM_COUNT < itemCount) return page + steps * ITEM_COUNT;
+        return event->repeat ? lastPage : 0;
+    }
+    else if (btn == ODROID_INPUT_LEFT)
+    {
+        if (page - steps * ITEM_COUNT >= 0) return page - steps * ITEM_COUNT;
+        return event->repeat ? 0 : lastPage;
     }
 
-    boot_application(app);
+    return currentItem;
 }
 
-
-static char *ui_choose_file(const char *path)
+// SELECT marks files for a batch install, A returns the marked ones or the one under the cursor.
+// Returns the number of paths in *selected, 0 when cancelled.
+static int ui_choose_files(const char *path, char ***selected)
 {
     char tempstring[128];
 
-    // Check SD card
-    if (sdcardret != ESP_OK)
+    // Check SD card, it is mounted the first time we get here
+    if (odroid_sdcard_wait() != ESP_OK)
     {
         DisplayPage("Error", "Error");
         DisplayError("SD CARD ERROR");
         vTaskDelay(200);
-        return NULL;
+        return 0;
     }
 
     char **files = NULL;
-    char *result = NULL;
     int fileCount = odroid_sdcard_files_get(path, ".fw", &files);
+    bool *marked = calloc(fileCount + 1, sizeof(bool));
+    int markedCount = 0;
+    int resultCount = 0;
     int currentItem = 0;
 
+    *selected = NULL;
+
     ESP_LOGI(__func__, "fileCount=%d", fileCount);
 
     while (true)
     {
+        perf_timer_t timer = perf_start();
         int page = (currentItem / ITEM_COUNT) * ITEM_COUNT;
         size_t count, totalFreeSpace;
         odroid_flash_block_t *blocks;
@@ -1092,7 +619,10 @@ static char *ui_choose_file(const char *path)
         find_free_blocks(&blocks, &count, &totalFreeSpace);
         free(blocks);
 
-        snprintf(tempstring, sizeof(tempstring), "Free space: %.2fMB (%d block)", (double)totalFreeSpace / 1024 / 1024, count);
+        if (markedCount > 0)
+            snprintf(tempstring, sizeof(tempstring), "Free space: %.2fMB | %d selected", (double)totalFreeSpace / 1024 / 1024, markedCount);
+        else
+            snprintf(tempstring, sizeof(tempstring), "Free space: %.2fMB (%d block)", (double)totalFreeSpace / 1024 / 1024, count);
 
         DisplayPage("Select a file", tempstring);
         DisplayIndicators(page / ITEM_COUNT + 1, (int)ceil((double)fileCount / ITEM_COUNT));
@@ -1106,7 +636,8 @@ static char *ui_choose_file(const char *path)
 
             odroid_fw_t *fw = firmware_get_info(tempstring);
             if (fw) {
-                snprintf(tempstring, sizeof(tempstring), "%.2f MB", (float)fw->flashSize / 1024 / 1024);
+                snprintf(tempstring, sizeof(tempstring), "%.2f MB%s", (float)fw->flashSize / 1024 / 1024,
+                         marked[page + line] ? "  [selected]" : "");
                 DisplayRow(line, fileName, tempstring, C_GRAY, fw->header.tile, selected);
             } else {
                 DisplayRow(line, fileName, "Invalid firmware", C_RED, NULL, selected);
@@ -1117,41 +648,51 @@ static char *ui_choose_file(const char *path)
         if (fileCount == 0)
             DisplayMessage("SD Card Empty");
 
+        perf_stop(PERF_UI_RENDER, timer, 0);
         UpdateDisplay();
 
         // Wait for input but refresh display after 1000 ticks if no input
-        int btn = input_wait_for_button_press(1000);
+        input_event_t event = {.count = 1};
+        int btn = input_wait_for_button_repeat(1000, &event);
 
         if (fileCount > 0)
         {
-            if (btn == ODROID_INPUT_DOWN)
+            if (btn >= ODROID_INPUT_UP && btn <= ODROID_INPUT_LEFT)
             {
-                if (++currentItem >= fileCount) currentItem = 0;
+                currentItem = ui_list_navigate(btn, &event, currentItem, fileCount);
             }
-            else if (btn == ODROID_INPUT_UP)
-            {
-                if (--currentItem < 0) currentItem = fileCount - 1;
-            }
-            else if (btn == ODROID_INPUT_RIGHT)
-            {
-                if (page + ITEM_COUNT < fileCount) currentItem = page + ITEM_COUNT;
-                else currentItem = 0;
-            }
-            else if (btn == ODROID_INPUT_LEFT)
+            else if (btn == ODROID_INPUT_SELECT)
             {
-                if (page - ITEM_COUNT >= 0) currentItem = page - ITEM_COUNT;
-                else currentItem = (fileCount - 1) / ITEM_COUNT * ITEM_COUNT;
+                if (marked[currentItem] || markedCount < FIRMWARE_BATCH_MAX)
+                {
+                    marked[currentItem] = !marked[currentItem];
+                    markedCount += marked[currentItem] ? 1 : -1;
+                }
             }
             else if (btn == ODROID_INPUT_A)
             {
-                size_t fullPathLength = strlen(path) + 1 + strlen(files[currentItem]) + 1;
-                char *fullPath = safe_alloc(fullPathLength);
+                if (markedCount == 0)
+                {
+                    marked[currentItem] = true;
+                    markedCount = 1;
+                }
+
+                *selected = safe_alloc(markedCount * sizeof(char *));
+
+                for (int i = 0; i < fileCount; i++)
+                {
+                    if (!marked[i])
+                        continue;
+
+                    size_t fullPathLength = strlen(path) + 1 + strlen(files[i]) + 1;
+                    char *fullPath = safe_alloc(fullPathLength);
 
-                strncpy(fullPath, path, fullPathLength);
-                strncat(fullPath, "/", fullPathLength);
-                strncat(fullPath, files[currentItem], fullPathLength);
+                    strncpy(fullPath, path, fullPathLength);
+                    strncat(fullPath, "/", fullPathLength);
+                    strncat(fullPath, files[i], fullPathLength);
 
-                result = fullPath;
+                    (*selected)[resultCount++] = fullPath;
+                }
                 break;
             }
         }
@@ -1163,8 +704,9 @@ static char *ui_choose_file(const char *path)
     }
 
     odroid_sdcard_files_free(files, fileCount);
+    free(marked);
 
-    return result;
+    return resultCount;
 }
 
 static int ui_choose_dialog(dialog_option_t *options, int optionCount, bool cancellable)
@@ -1231,13 +773,19 @@ static int ui_choose_dialog(dialog_option_t *options, int optionCount, bool canc
         {
             if (cancellable) break;
         }
+        else if (btn == ODROID_INPUT_SELECT)
+        {
+            if (cancellable) return -2; // Hidden entry, see ui_show_performance()
+        }
     }
 
     return -1;
 }
 
-static void ui_draw_app_page(int currentItem)
+// Draws the app page in fb only, see ui_draw_app_page()
+static void ui_compose_app_page(int currentItem)
 {
+    perf_timer_t timer = perf_start();
     int page = (currentItem / ITEM_COUNT) * ITEM_COUNT;
     char tempstring[128];
 
@@ -1254,9 +802,58 @@ static void ui_draw_app_page(int currentItem)
 	if (apps_count == 0)
         DisplayMessage("No apps have been flashed yet!");
 
+    perf_stop(PERF_UI_RENDER, timer, 0);
+}
+
+static void ui_draw_app_page(int currentItem)
+{
+    ui_compose_app_page(currentItem);
     UpdateDisplay();
 }
 
+// Reached by pressing SELECT in the menu dialog. Times are in ms, totals since boot (or the last reset).
+static void ui_show_performance(void)
+{
+    char tempstring[64];
+
+    while (true)
+    {
+        DisplayPage("Performance", "[A] Reset  |  [B] Back");
+        UG_FontSelect(&FONT_8X8);
+        UG_SetBackcolor(C_WHITE);
+        UG_SetForecolor(C_GRAY);
+        UG_PutString(4, 18, "stage        n    MB/s");
+        UG_PutString(4, 28, "   avg    p95    max");
+
+        for (int i = 0; i < PERF_STAGE_MAX; i++)
+        {
+            const perf_stats_t *stats = perf_get_stats(i);
+            int top = 40 + i * 20;
+
+            snprintf(tempstring, sizeof(tempstring), "%-8s %6u %7.2f", perf_stage_name(i),
+                     stats->count, perf_mb_per_s(stats));
+            UG_SetForecolor(C_BLACK);
+            UG_PutString(4, top, tempstring);
+
+            snprintf(tempstring, sizeof(tempstring), "%6.1f %6.1f %6.1f",
+                     stats->count ? stats->total_us / 1000.0 / stats->count : 0.0,
+                     perf_percentile_us(stats, 95) / 1000.0, stats->max_us / 1000.0);
+            UG_SetForecolor(C_GRAY);
+            UG_PutString(4, top + 10, tempstring);
+        }
+
+        UpdateDisplay();
+
+        // Refresh every second, the page's own flushes show up in the lcd row
+        int btn = input_wait_for_button_press(100);
+
+        if (btn == ODROID_INPUT_A)
+            perf_reset();
+        else if (btn == ODROID_INPUT_B)
+            break;
+    }
+}
+
 
 static void start_normal(void)
 {
@@ -1265,45 +862,48 @@ static void start_normal(void)
     int currentItem = 0;
     int queuedBtn = -1;
 
-    nvs_flash_init_partition(MFW_NVS_PARTITION);
-    if (nvs_open("settings", NVS_READWRITE, &nvs_h) != ESP_OK) {
-        nvs_flash_erase();
-        nvs_open("settings", NVS_READWRITE, &nvs_h);
-    }
+    open_settings();
     nvs_get_i32(nvs_h, "display_order", (int32_t *)&displayOrder);
 
-    read_app_table();
+    // app_main() already read the app table
     sort_app_table(displayOrder);
 
-    while (true)
+#if MFW_LVGL_LAUNCHER
+    launcher_init();
+#endif
+
+    for (bool firstFrame = true; true; firstFrame = false)
     {
+#if MFW_LVGL_LAUNCHER
+        launcher_show(currentItem);
+#else
         ui_draw_app_page(currentItem);
+#endif
 
-        int page = (currentItem / ITEM_COUNT) * ITEM_COUNT;
+        if (firstFrame)
+            boot_milestone("menu");
 
         // Wait for input but refresh display after 1000 ticks if no input
-        int btn = (queuedBtn != -1) ? queuedBtn : input_wait_for_button_press(1000);
+        input_event_t event = {.count = 1};
+        int btn = (queuedBtn != -1) ? queuedBtn : input_wait_for_button_repeat(1000, &event);
         queuedBtn = -1;
 
+#if MFW_LVGL_LAUNCHER
+        // These keys end up in uGUI, which flushes full frames of its own. The panel already shows this
+        // page, so uGUI only needs it in fb as the background of its dialogs. Other keys keep LVGL on screen.
+        if (btn == ODROID_INPUT_MENU || btn == ODROID_INPUT_START
+            || (apps_count > 0 && (btn == ODROID_INPUT_A || btn == ODROID_INPUT_SELECT)))
+        {
+            launcher_hide();
+            ui_compose_app_page(currentItem);
+        }
+#endif
+
 		if (apps_count > 0)
 		{
-            if (btn == ODROID_INPUT_DOWN)
-	        {
-                if (++currentItem >= apps_count) currentItem = 0;
-	        }
-	        else if (btn == ODROID_INPUT_UP)
-	        {
-                if (--currentItem < 0) currentItem = apps_count - 1;
-	        }
-	        else if (btn == ODROID_INPUT_RIGHT)
-	        {
-                if (page + ITEM_COUNT < apps_count) currentItem = page + ITEM_COUNT;
-                else currentItem = 0;
-	        }
-	        else if (btn == ODROID_INPUT_LEFT)
+            if (btn >= ODROID_INPUT_UP && btn <= ODROID_INPUT_LEFT)
 	        {
-                if (page - ITEM_COUNT >= 0) currentItem = page - ITEM_COUNT;
-                else currentItem = (apps_count - 1) / ITEM_COUNT * ITEM_COUNT;
+                currentItem = ui_list_navigate(btn, &event, currentItem, apps_count);
 	        }
 	        else if (btn == ODROID_INPUT_A)
 	        {
@@ -1339,27 +939,35 @@ static void start_normal(void)
                 {0, "Install from SD Card", true},
                 {1, "Erase selected app", apps_count > 0},
                 {2, "Erase selected NVS", apps_count > 0},
+                {6, "Backup selected data", apps_count > 0},
+                {7, "Restore selected data", apps_count > 0},
+                {8, "Backup all apps data", apps_count > 0},
                 {3, "Erase all apps", apps_count > 0},
                 {4, "Format SD Card", true},
                 {5, "Restart System", true}
             };
 
             odroid_app_t *app = &apps[currentItem];
-            char *fileName;
+            char **fileNames;
+            int fileCount, saved;
             size_t offset;
 
-            switch (ui_choose_dialog(options, 6, true))
+            switch (ui_choose_dialog(options, sizeof(options) / sizeof(options[0]), true))
             {
                 case 0: // Install from SD Card
-                    if ((fileName = ui_choose_file(FIRMWARE_PATH))) {
-                        flash_firmware(fileName);
-                        free(fileName);
+                    if ((fileCount = ui_choose_files(FIRMWARE_PATH, &fileNames)) == 1) {
+                        flash_firmware(fileNames[0]);
+                    } else if (fileCount > 1) {
+                        flash_firmware_batch((const char **)fileNames, fileCount);
+                    }
+                    if (fileCount > 0) {
+                        odroid_sdcard_files_free(fileNames, fileCount);
                     }
                     break;
                 case 1: // Remove selected app
-                    memmove(app, app + 1, (apps_max - currentItem) * sizeof(odroid_app_t));
-                    apps_count--;
-                    write_app_table();
+                    DisplayNotification("Saving app data ...");
+                    backup_app_data(app);
+                    remove_app(currentItem);
                     break;
                 case 2: // Erase selected app's NVS
                     offset = app->startOffset;
@@ -1377,22 +985,59 @@ static void start_normal(void)
                     }
                     queuedBtn = input_wait_for_button_press(200);
                     break;
+                case 6: // Backup selected app's data
+                    DisplayNotification("Saving app data ...");
+                    DisplayNotification(backup_app_data(app) ? "Operation successful!" : "An error has occurred!");
+                    queuedBtn = input_wait_for_button_press(200);
+                    break;
+                case 7: // Restore selected app's data
+                    DisplayNotification("Restoring app data ...");
+                    app_data_path(app, tempstring, sizeof(tempstring));
+                    if (odroid_sdcard_wait() == ESP_OK && firmware_restore_data(app, tempstring, true))
+                        DisplayNotification("Operation successful!");
+                    else
+                        DisplayNotification("No saved data found!");
+                    input_flush();
+                    queuedBtn = input_wait_for_button_press(200);
+                    break;
+                case 8: // Backup every app's data
+                    saved = 0;
+                    for (int i = 0; i < apps_count; i++)
+                    {
+                        snprintf(tempstring, sizeof(tempstring), "Saving app data (%d/%d) ...", i + 1, apps_count);
+                        DisplayNotification(tempstring);
+                        saved += backup_app_data(&apps[i]);
+                    }
+                    snprintf(tempstring, sizeof(tempstring), "%d of %d apps saved", saved, apps_count);
+                    DisplayNotification(tempstring);
+                    input_flush();
+                    queuedBtn = input_wait_for_button_press(200);
+                    break;
                 case 3: // Erase all apps
+                    for (int i = 0; i < apps_count; i++)
+                    {
+                        snprintf(tempstring, sizeof(tempstring), "Saving app data (%d/%d) ...", i + 1, apps_count);
+                        DisplayNotification(tempstring);
+                        backup_app_data(&apps[i]);
+                    }
                     memset(apps, 0xFF, apps_max * sizeof(odroid_app_t));
                     apps_count = 0;
                     currentItem = 0;
                     app = &apps[0];
                     write_app_table();
                     write_partition_table(NULL);
+                    input_flush();
                     break;
                 case 4: // Format SD Card
                     DisplayPage("Format SD Card", PROJECT_VER);
                     DisplayMessage("Press start to begin");
+                    input_flush();
                     if (input_wait_for_button_press(50000) != ODROID_INPUT_START) {
                         break;
                     }
                     DisplayMessage("Formatting... (be patient)");
-                    sdcardret = odroid_sdcard_format(0);
+                    odroid_sdcard_wait();
+                    esp_err_t sdcardret = odroid_sdcard_format(0);
                     if (sdcardret == ESP_OK) {
                         sdcardret = odroid_sdcard_open();
                     }
@@ -1406,11 +1051,15 @@ static void start_normal(void)
                     } else {
                         DisplayError("Format failed!");
                     }
+                    input_flush();
                     input_wait_for_button_press(50000);
                     break;
                 case 5: // Restart
                     cleanup_and_restart();
                     break;
+                case -2: // Hidden performance page
+                    ui_show_performance();
+                    break;
             }
 
             sort_app_table(displayOrder);
@@ -1451,35 +1100,60 @@ static void start_install(void)
         panic_abort("CORRUPT INSTALLER ERROR");
     }
 
-    SET_STATUS_LED(1);
+    // Streams the payload block by block. When the payload lies past the end of the image, rerunning after
+    // an interruption resumes where it stopped. When it overlaps, the image is copied in order and an
+    // interruption leaves a partly overwritten payload: the installer can't be run again.
+    firmware_install_image(payload->address, payload->size);
 
-    size_t size = ALIGN_ADDRESS(payload->size, FLASH_BLOCK_SIZE);
-    void *data = safe_alloc(size);
+    // The above code will clear the ota partition, no need to set boot app
+    cleanup_and_restart();
+}
 
-    // We must copy the data to RAM first because our data address space is full, can't mmap
-    if (esp_flash_read(NULL, data, payload->address, payload->size) != ESP_OK)
-    {
-        panic_abort("PART TABLE WRITE ERROR");
-    }
 
-    // It would be nicer to do the erase/write in blocks to be able to show progress
-    // but, because of the shared SPI bus, I think it is safer to do it in one go.
+static void lcd_init_task(void *arg)
+{
+#if SDCARD_BEFORE_LCD
+    odroid_sdcard_wait();
+#endif
+    ili9341_init();
+    boot_milestone("lcd");
 
-    if (esp_flash_erase_region(NULL, 0x0, size) != ESP_OK)
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    vTaskDelete(NULL);
+}
+
+// Holding START at power on boots the last launched app again before the LCD, SD card or uGUI are
+// touched. write_boot_partition() skips identical writes so this usually only reads the flash.
+static void start_quick_relaunch(void)
+{
+    int64_t start = esp_timer_get_time();
+    last_app_t last;
+    size_t size = sizeof(last);
+
+    // Left open for start_normal() when the relaunch doesn't happen
+    open_settings();
+    if (nvs_get_blob(nvs_h, "last_app_id", &last, &size) != ESP_OK || size != sizeof(last))
     {
-        panic_abort("PART TABLE ERASE ERROR");
+        ESP_LOGW(__func__, "No app launched yet.");
+        return;
     }
+    last.filename[sizeof(last.filename) - 1] = 0;
 
-    if (esp_flash_write(NULL, data, 0x0, size) != ESP_OK)
+    read_app_table();
+
+    for (int i = 0; i < apps_count; i++)
     {
-        panic_abort("PART TABLE WRITE ERROR");
+        if (apps[i].startOffset == last.startOffset && strncmp(apps[i].filename, last.filename, sizeof(last.filename)) == 0)
+        {
+            ESP_LOGI(__func__, "Relaunching '%s' (%dms).", apps[i].description, (int)((esp_timer_get_time() - start) / 1000));
+            write_boot_partition(&apps[i]);
+            cleanup_and_restart();
+        }
     }
 
-    // The above code will clear the ota partition, no need to set boot app
-    cleanup_and_restart();
+    ESP_LOGW(__func__, "Last app '%s' at 0x%x is no longer installed.", last.filename, (unsigned)last.startOffset);
 }
 
-
 void app_main(void)
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -1491,19 +1165,48 @@ void app_main(void)
     SET_STATUS_LED(1);
 #endif
 
-    // Has to be before LCD
-    sdcardret = odroid_sdcard_open();
-    ili9341_init();
+    boot_milestone("app_main");
+
     input_init();
+    boot_milestone("input");
+
+    bool factory = esp_ota_get_running_partition()->subtype == ESP_PARTITION_SUBTYPE_APP_FACTORY;
+
+    if (factory && (input_read_raw() & (1 << ODROID_INPUT_START)))
+    {
+        start_quick_relaunch();
+    }
+
+    // Otherwise the card is only mounted when something needs it
+#if SDCARD_BEFORE_LCD
+    odroid_sdcard_mount_async();
+#endif
+
+    // The LCD comes up on the other core while we read the app table
+    SemaphoreHandle_t lcdReady = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(&lcd_init_task, "lcd_init", 1024 * 4, lcdReady, 5, NULL, 1);
+
+    battery_init();
+
+    if (factory)
+    {
+        read_app_table();
+        boot_milestone("app_table");
+    }
+
+    xSemaphoreTake(lcdReady, portMAX_DELAY);
+    vSemaphoreDelete(lcdReady);
 
     UG_Init(&gui, pset, SCREEN_WIDTH, SCREEN_HEIGHT);
+    ui_ready = true;
+    boot_milestone("ui");
 
 #if CONFIG_HW_ODROID_GO
     SET_STATUS_LED(0);
 #endif
 
     // Start the installation process if we didn't boot from the factory app partition
-    if (esp_ota_get_running_partition()->subtype != ESP_PARTITION_SUBTYPE_APP_FACTORY)
+    if (!factory)
     {
         ESP_LOGI(__func__, "Non-factory startup, launching installer...");
         start_install();
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <esp_cpu.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include "perf.h"
+
+static const char *stage_names[PERF_STAGE_MAX] = {
+    "sd_read", "crc", "sha256", "fl_read", "fl_erase", "fl_write", "lcd", "render",
+};
+
+static perf_stats_t totals[PERF_STAGE_MAX];
+static perf_stats_t operation[PERF_STAGE_MAX];
+static const char *operation_name;
+static int64_t operation_start;
+
+static int bucket_index(uint32_t us)
+{
+    if (us < (1 << PERF_HISTOGRAM_SUBBITS))
+        return us;
+
+    int msb = 31 - __builtin_clz(us);
+    int sub = (us >> (msb - PERF_HISTOGRAM_SUBBITS)) & ((1 << PERF_HISTOGRAM_SUBBITS) - 1);
+    int index = ((msb - PERF_HISTOGRAM_SUBBITS + 1) << PERF_HISTOGRAM_SUBBITS) + sub;
+
+    return index < PERF_HISTOGRAM_BUCKETS ? index : PERF_HISTOGRAM_BUCKETS - 1;
+}
+
+// Largest value that still falls in the bucket
+static uint32_t bucket_limit(int index)
+{
+    if (index < (1 << PERF_HISTOGRAM_SUBBITS))
+        return index;
+
+    int msb = (index >> PERF_HISTOGRAM_SUBBITS) + PERF_HISTOGRAM_SUBBITS - 1;
+    int sub = index & ((1 << PERF_HISTOGRAM_SUBBITS) - 1);
+    uint64_t base = (1ULL << msb) + ((uint64_t)sub << (msb - PERF_HISTOGRAM_SUBBITS));
+
+    return base + (1ULL << (msb - PERF_HISTOGRAM_SUBBITS)) - 1;
+}
+
+static void stats_add(perf_stats_t *stats, uint32_t us, size_t bytes, uint32_t cycles)
+{
+    if (stats->count == 0 || us < stats->min_us)
+        stats->min_us = us;
+    if (us > stats->max_us)
+        stats->max_us = us;
+
+    stats->count++;
+    stats->total_us += us;
+    stats->total_bytes += bytes;
+    stats->total_cycles += cycles;
+    stats->histogram[bucket_index(us)]++;
+}
+
+perf_timer_t perf_start(void)
+{
+    return (perf_timer_t){
+        .start_us = esp_timer_get_time(),
+        .start_cycles = esp_cpu_get_cycle_count(),
+    };
+}
+
+void perf_stop(perf_stage_t stage, perf_timer_t timer, size_t bytes)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count() - timer.start_cycles;
+    uint32_t us = esp_timer_get_time() - timer.start_us;
+
+    stats_add(&totals[stage], us, bytes, cycles);
+    if (operation_name)
+        stats_add(&operation[stage], us, bytes, cycles);
+}
+
+void perf_operation_begin(const char *name)
+{
+    memset(operation, 0, sizeof(operation));
+    operation_name = name;
+    operation_start = esp_timer_get_time();
+}
+
+void perf_operation_end(void)
+{
+    char line[512];
+    int len;
+
+    if (!operation_name)
+        return;
+
+    len = snprintf(line, sizeof(line), "op=%s ms=%d", operation_name,
+                   (int)((esp_timer_get_time() - operation_start) / 1000));
+
+    for (int i = 0; i < PERF_STAGE_MAX && len < sizeof(line); i++)
+    {
+        const perf_stats_t *stats = &operation[i];
+
+        if (stats->count == 0)
+            continue;
+
+        len += snprintf(line + len, sizeof(line) - len, " %s=n:%u,min:%u,avg:%u,p95:%u,max:%u,MBps:%.2f,cpB:%.1f",
+                        stage_names[i], stats->count, stats->min_us, (uint32_t)(stats->total_us / stats->count),
+                        perf_percentile_us(stats, 95), stats->max_us, perf_mb_per_s(stats),
+                        stats->total_bytes ? (double)stats->total_cycles / stats->total_bytes : 0.0);
+    }
+
+    ESP_LOGI("perf", "%s", line);
+    operation_name = NULL;
+}
+
+const char *perf_stage_name(perf_stage_t stage)
+{
+    return stage_names[stage];
+}
+
+const perf_stats_t *perf_get_stats(perf_stage_t stage)
+{
+    return &totals[stage];
+}
+
+uint32_t perf_percentile_us(const perf_stats_t *stats, int percentile)
+{
+    uint64_t target = ((uint64_t)stats->count * percentile + 99) / 100;
+    uint64_t seen = 0;
+
+    for (int i = 0; i < PERF_HISTOGRAM_BUCKETS && target > 0; i++)
+    {
+        seen += stats->histogram[i];
+        if (seen >= target)
+            return bucket_limit(i) < stats->max_us ? bucket_limit(i) : stats->max_us;
+    }
+
+    return stats->max_us;
+}
+
+double perf_mb_per_s(const perf_stats_t *stats)
+{
+    return stats->total_us ? (double)stats->total_bytes / stats->total_us : 0.0; // bytes/us == MB/s
+}
+
+void perf_reset(void)
+{
+    memset(totals, 0, sizeof(totals));
+}
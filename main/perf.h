@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+    PERF_SD_READ = 0,
+    PERF_CRC,
+    PERF_SHA256,
+    PERF_FLASH_READ,
+    PERF_FLASH_ERASE,
+    PERF_FLASH_WRITE,
+    PERF_LCD_FLUSH,
+    PERF_UI_RENDER,
+
+    PERF_STAGE_MAX
+} perf_stage_t;
+
+// Log-linear histogram: 4 buckets per power of two of microseconds, up to about 9 minutes
+#define PERF_HISTOGRAM_SUBBITS      2
+#define PERF_HISTOGRAM_BUCKETS      (28 << PERF_HISTOGRAM_SUBBITS)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t total_bytes;
+    uint64_t total_cycles;
+    uint32_t histogram[PERF_HISTOGRAM_BUCKETS];
+} perf_stats_t;
+
+typedef struct
+{
+    int64_t start_us;
+    uint32_t start_cycles;
+} perf_timer_t;
+
+perf_timer_t perf_start(void);
+void perf_stop(perf_stage_t stage, perf_timer_t timer, size_t bytes);
+
+// Groups the samples of one user operation (install, defrag...), the end prints them as one console line
+void perf_operation_begin(const char *name);
+void perf_operation_end(void);
+
+const char *perf_stage_name(perf_stage_t stage);
+const perf_stats_t *perf_get_stats(perf_stage_t stage); // Accumulated since boot
+uint32_t perf_percentile_us(const perf_stats_t *stats, int percentile);
+double perf_mb_per_s(const perf_stats_t *stats);
+void perf_reset(void);
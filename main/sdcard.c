@@ -6,7 +6,11 @@
 #include <diskio.h>
 #include <esp_heap_caps.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <bsp/esp-bsp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/task.h>
 
 #include <dirent.h>
 #include <strings.h>
@@ -22,6 +26,11 @@
 #define SD_SLOT SPI3_HOST
 #endif
 
+#define SDCARD_MOUNT_DONE (1 << 0)
+
+static EventGroupHandle_t sdcard_events;
+static volatile esp_err_t sdcard_ret = ESP_ERR_INVALID_STATE;
+
 extern esp_err_t ff_diskio_get_drive(BYTE* out_pdrv);
 extern void ff_diskio_register_sdmmc(unsigned char pdrv, sdmmc_card_t* card);
 
@@ -145,11 +154,47 @@ esp_err_t odroid_sdcard_open(void)
         ESP_LOGE(__func__, "bsp_sdcard_mount failed (%d)", ret);
     }
 
+    sdcard_ret = ret;
     return ret;
 }
 
+static void sdcard_mount_task(void *arg)
+{
+    int64_t start = esp_timer_get_time();
+
+    odroid_sdcard_open();
+    ESP_LOGI(__func__, "SD card %s in %dms.", sdcard_ret == ESP_OK ? "mounted" : "failed",
+             (int)((esp_timer_get_time() - start) / 1000));
+
+    xEventGroupSetBits(sdcard_events, SDCARD_MOUNT_DONE);
+    vTaskDelete(NULL);
+}
+
+void odroid_sdcard_mount_async(void)
+{
+    if (sdcard_events)
+        return;
+
+    sdcard_events = xEventGroupCreate();
+    xTaskCreatePinnedToCore(&sdcard_mount_task, "sdcard_mount", 1024 * 4, NULL, 4, NULL, 0);
+}
+
+esp_err_t odroid_sdcard_wait(void)
+{
+    odroid_sdcard_mount_async();
+    xEventGroupWaitBits(sdcard_events, SDCARD_MOUNT_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+    return sdcard_ret;
+}
+
 esp_err_t odroid_sdcard_close(void)
 {
+    if (sdcard_ret != ESP_OK)
+    {
+        return ESP_ERR_INVALID_STATE; // Never mounted, or the background mount failed
+    }
+
+    sdcard_ret = ESP_ERR_INVALID_STATE;
+
     esp_err_t ret = bsp_sdcard_unmount();
 
     if (ret != ESP_OK)
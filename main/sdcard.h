@@ -5,6 +5,8 @@
 #define SDCARD_BASE_PATH CONFIG_BSP_SD_MOUNT_POINT
 
 esp_err_t odroid_sdcard_open(void);
+void odroid_sdcard_mount_async(void); // Starts mounting on a background task, the first call must come from app_main
+esp_err_t odroid_sdcard_wait(void); // Mounts on first use, returns the result of the last mount
 esp_err_t odroid_sdcard_close(void);
 esp_err_t odroid_sdcard_format(int fs_type);
 
@@ -1,5 +1,5 @@
 #!/usr/bin/env python
-import sys, math, zlib, struct
+import sys, math, zlib, struct, hashlib
 
 def readfile(filepath):
     try:
@@ -8,8 +8,13 @@ def readfile(filepath):
     except FileNotFoundError as err:
         exit("\nERROR: Unable to open partition file '%s' !\n" % err.filename)
 
+# Append a SHA-256 to every partition, checked while installing. Firmwares without support can't read it.
+fw_sha256 = "--sha256" in sys.argv
+if fw_sha256:
+    sys.argv.remove("--sha256")
+
 if len(sys.argv) < 4:
-    exit("usage: mkfw.py output_file.fw 'description' tile.raw type subtype size label file.bin "
+    exit("usage: mkfw.py [--sha256] output_file.fw 'description' tile.raw type subtype size label file.bin "
          "[type subtype size label file.bin, ...]")
 
 fw_name = sys.argv[1]
@@ -47,8 +52,10 @@ while pos < len(sys.argv):
         print(" > WARNING: Partition smaller than file (+%d bytes), increasing size to %d"
             % (len(data) - size, real_size))
 
-    fw_data += struct.pack("<BBxx16sIII", partype, subtype, label.encode(), 0, real_size, len(data))
+    fw_data += struct.pack("<BBBx16sIII", partype, subtype, 1 if fw_sha256 else 0, label.encode(), 0, real_size, len(data))
     fw_data += data
+    if fw_sha256:
+        fw_data += hashlib.sha256(data).digest()
     fw_size += real_size
     fw_part += 1
 